@@ -25,7 +25,8 @@
 ///
 ///	core-rc is a simple module for processing structured and readables
 ///	configuration files.
-///	Complete module < 20k (+5k core-array) with ~ 2000 source code lines.
+///	The module without options is < 40k (+5k core-array), with all
+///	options it has ~ 12000 source code lines.
 ///
 ///	@par Example
 ///	Example how a configuration file can look like:
@@ -44,12 +45,79 @@
 ///	- #USE_CORE_RC_GET_STRINGS
 ///	Include support for the get functions with strings.
 ///
+///	- #USE_CORE_RC_PATH
+///	Include compiled config paths and their get functions.
+///
+///	- #USE_CORE_RC_CACHE
+///	Include lookup caches of call sites, needs #USE_CORE_RC_PATH.
+///
+///	- #USE_CORE_RC_INDEX
+///	Include perfect hash index of the full paths of a config, needs
+///	#USE_CORE_RC_PATH.
+///
+///	- #USE_CORE_RC_BIND
+///	Include binding of config values to C structs, needs
+///	#USE_CORE_RC_PATH.
+///
 ///	- #USE_CORE_RC_PRINT
 ///	Include support to print config objects.
 ///
 ///	- #USE_CORE_RC_WRITE
 ///	Include support to write config objects.
 ///
+///	- #USE_CORE_RC_STATISTICS
+///	Include memory usage counters.
+///
+///	- #USE_CORE_RC_HANDLE
+///	Include config handles for lock-free reader access and hot reload.
+///
+///	- #USE_CORE_RC_WATCH
+///	Include inotify watch of the config files (linux only).
+///
+///	- #USE_CORE_RC_RELOAD
+///	Include incremental reload of changed include files.
+///
+///	- #USE_CORE_RC_BINARY
+///	Include binary snapshots of configs, which are mapped into memory.
+///
+///	- #USE_CORE_RC_DESCENT
+///	Use the hand-written recursive descent parser instead of the peg
+///	generated parser.
+///
+///	- #USE_CORE_RC_SIMD
+///	Use SSE2/AVX2 kernels to skip spaces, comments and strings in the
+///	descent parser.
+///
+///	- #USE_CORE_RC_PARALLEL
+///	Include parsing the include files of the main file with threads,
+///	needs #USE_CORE_RC_DESCENT.
+///
+///	- #USE_CORE_RC_NAN_BOX
+///	Use NaN-boxed values with exact doubles and 49 bit integers instead
+///	of tagged pointers, needs 64 bit pointers.  It must be defined for
+///	all users of core-rc.h.
+///
+///	- #USE_CORE_RC_SHORT_STRING
+///	Store strings up to 7 bytes (6 bytes NaN-boxed) in the value itself,
+///	without string object.  The floating points of the tagged values
+///	lose one more bit.  The functions returning a const char pointer
+///	spell them once in the pool, ConfigStringBuffer() gets them
+///	without the pool.
+///
+///	- #USE_CORE_RC_PERSISTENT
+///	Include persistent configs, ConfigUpdate() returns a new version
+///	sharing all unchanged arrays with the old one, needs
+///	#USE_CORE_RC_PATH.
+///
+///	@par Threads
+///	Each thread can read configs with its own #ConfigParser
+///	(ConfigParserNew(), ConfigParserReadFile()).  The strings are merged
+///	into the shared string pool under a lock, after the parse.
+///	ConfigRead2(), ConfigReadMemory() and ConfigReadFile2() use such a
+///	parser too, ConfigNewString() interns under the lock.  The
+///	ConfigStringsGet*() functions only search the pool and can be used
+///	by concurrent readers.
+///
 ///	@ref CoreRc	The core runtime configuration module.
 ///
 
@@ -97,15 +165,37 @@
 ///	@n[xxxxxxxxxxxxxxxxxxxxxxxxxxxxx000]	x = 32 bit object pointer
 ///	</tt>
 ///
+///	With #USE_CORE_RC_SHORT_STRING the floating points are only tagged
+///	010, 110 are short strings with the length l and the bytes b, the
+///	first byte is the most significant.
+///	<tt>
+///	@n[xxxxxxxxxxxxxxxxxxxxxxxxxxxxx010]	x = 29 bit floating point
+///	@n[bbbbbbbbbbbbbbbbbbbbbbbb00lll110]	b = 3/7 bytes of string
+///	</tt>
+///
+///	With #USE_CORE_RC_NAN_BOX the values are NaN-boxed.  The doubles
+///	are stored with all bits, offset by #CONFIG_NAN_BOX_DOUBLE.  The
+///	pointers keep their tags below it, the integers are above
+///	#CONFIG_NAN_BOX_INTEGER.
+///	<tt>
+///	@n[0000000000000000 0xxx...xxx100]	x = 48 bit string pointer
+///	@n[0000000000000000 0xxx...xxx000]	x = 48 bit object pointer
+///	@n[0002..FFF2      xxxxx...xxxxx]	x = 64 bit double + 2^49
+///	@n[FFF4..FFFA      bbbbb...bbbbb]	b = 6 bytes of short string
+///	@n[111111111111111x xxxxx...xxxxx]	x = 49 bit signed integer
+///	</tt>
+///
 /// @{
 
 #define _GNU_SOURCE	1		///< fix stpcpy strchrnul
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdarg.h>
 #include <string.h>
+#include <pthread.h>
 
 #ifndef NO_DEBUG_CORE_RC
 #define NO_DEBUG_CORE_RC		///< debug enabled/disabled
@@ -114,6 +204,57 @@
 #define USE_CORE_RC_PRINT		///< include core-rc print support
 #define USE_CORE_RC_WRITE		///< include core-rc write support
 #define USE_CORE_RC_GET_STRINGS		///< include get functions with strings
+#define USE_CORE_RC_PATH		///< include compiled config paths
+#define USE_CORE_RC_CACHE		///< include call site lookup caches
+#define USE_CORE_RC_INDEX		///< include perfect hash path index
+#define USE_CORE_RC_BIND		///< include binding to C structs
+#define USE_CORE_RC_STATISTICS		///< include memory usage counters
+#define USE_CORE_RC_HANDLE		///< include config handle support
+#define USE_CORE_RC_WATCH		///< include config file watch support
+#define USE_CORE_RC_RELOAD		///< include incremental reload support
+#define USE_CORE_RC_BINARY		///< include binary snapshot support
+#define USE_CORE_RC_DESCENT		///< use recursive descent parser
+#define USE_CORE_RC_SIMD		///< use SIMD scanner kernels
+#define USE_CORE_RC_PARALLEL		///< include parallel include parsing
+#define USE_CORE_RC_SHORT_STRING	///< store short strings in values
+#define USE_CORE_RC_PERSISTENT		///< include persistent configs
+#endif
+
+#if defined(USE_CORE_RC_PARALLEL) && !defined(USE_CORE_RC_DESCENT)
+#error "USE_CORE_RC_PARALLEL needs USE_CORE_RC_DESCENT"
+#endif
+#if defined(USE_CORE_RC_CACHE) && !defined(USE_CORE_RC_PATH)
+#error "USE_CORE_RC_CACHE needs USE_CORE_RC_PATH"
+#endif
+#if defined(USE_CORE_RC_INDEX) && !defined(USE_CORE_RC_PATH)
+#error "USE_CORE_RC_INDEX needs USE_CORE_RC_PATH"
+#endif
+#if defined(USE_CORE_RC_BIND) && !defined(USE_CORE_RC_PATH)
+#error "USE_CORE_RC_BIND needs USE_CORE_RC_PATH"
+#endif
+#if defined(USE_CORE_RC_PERSISTENT) && !defined(USE_CORE_RC_PATH)
+#error "USE_CORE_RC_PERSISTENT needs USE_CORE_RC_PATH"
+#endif
+#if defined(USE_CORE_RC_NAN_BOX) && __SIZEOF_POINTER__ != 8
+#error "USE_CORE_RC_NAN_BOX needs 64 bit pointers"
+#endif
+
+#ifdef USE_CORE_RC_WATCH
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/inotify.h>
+#include <sys/timerfd.h>
+#endif
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef USE_CORE_RC_BINARY
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#if defined(USE_CORE_RC_SIMD) && defined(__SSE2__)
+#include <immintrin.h>
 #endif
 
 #include "core-array/core-array.h"
@@ -123,2247 +264,11563 @@
 // Object pool
 // ------------------------------------------------------------------------ //
 
-/**
-**	Allocate new object node.
-**
-**	@returns random object 8 bytes aligned
-**
-**	@todo FIXME: need to write an object pool.
-*/
-static inline ConfigObject *ConfigObjectNew(void)
-{
-    ConfigObject *object;
+    /// size of first object pool chunk, the following chunks double
+static const size_t OBJECT_POOL_MIN_SIZE = 1024;
 
-    // object is 4 bytes on 32bit 8 bytes on 64bit.
-    object = malloc(sizeof(*object));
-#ifdef DEBUG_CORE_RC
-    if ((size_t)object & 7) {
-	fprintf(stderr, "Object: unaligned %p\n", object);
-	abort();
-    }
-#endif
+    /// maximal size of one object pool chunk
+static const size_t OBJECT_POOL_SIZE = 65536;
 
-    return object;
-}
+/**
+**	Object pool slot typedef.
+*/
+typedef union _object_slot_ ObjectSlot;
 
 /**
-**	Deallocate object node.
-**
-**	@param object	config pointer object
+**	Object pool slot.
 **
-**	@todo FIXME: need to write an object pool.
+**	Slots are 8 bytes aligned also on 32bit, the low 3 bits of object
+**	pointers are used as tag.
 */
-static inline void ConfigObjectDel(ConfigObject * object)
+union _object_slot_
 {
-    free(object);
-}
-
-// ------------------------------------------------------------------------ //
-// String pool
-// ------------------------------------------------------------------------ //
-
-///
-///	@defgroup stringpool The string-pool module.
-///
-///	This module handles string-pools.  String pools handles string
-///	memory managment.  Only one copy of equal strings is stored.
-///
-/// @{
-
-    /// end of various program segments
-    ///@{
-#ifdef TCC
-extern char etext, edata, end;
-
-#define ETEXT etext
-#define EDATA edata
-#define END end
-#else
-extern char _etext, _edata, _end;
-
-#define ETEXT _etext
-#define EDATA _edata
-#define END _end
-#endif
-
-    ///@}
-
-    /// bigger strings are malloced
-static const size_t STRING_POOL_MAX_SIZE = 4096;
-
-    /// pool size
-static const size_t STRING_POOL_SIZE = 8192;
+    ConfigObject Object;		///< object stored in slot
+    ObjectSlot *Next;			///< next free slot
+    uint64_t Align __attribute__ ((aligned(8)));	///< alignment
+};
 
 /**
-**	String-pool typedef.
+**	Object pool chunk typedef.
 */
-typedef struct _string_pool_ StringPool;
+typedef struct _object_chunk_ ObjectChunk;
 
 /**
-**	String-pool node typedef
+**	A chunk of object pool structure.
 */
-typedef struct _string_node_ StringNode;
+struct _object_chunk_
+{
+    ObjectChunk *Next;			///< next chunk
+    size_t Size;			///< size of chunk in bytes
+    size_t Used;			///< slots used from chunk
+    ObjectSlot Slots[1];		///< object memory
+};
 
 /**
-**	A node of string pool structure.
+**	Object pool typedef.
 */
-struct _string_node_
-{
-    StringNode *Next;			///< next node
-    uint32_t Size;			///< allocated size of node
-    uint32_t Free;			///< free bytes in node
-    char Data[1];			///< string memory
-};
+typedef struct _object_pool_ ObjectPool;
 
 /**
-**	String-pool variables structure.
+**	Object pool variables structure.
 */
-struct _string_pool_
+struct _object_pool_
 {
-    StringNode *Pools;			///< list of pools
-    Array *Strings;			///< lookup of strings
+    ObjectChunk *Chunks;		///< list of chunks, first is current
+    ObjectSlot *Free;			///< list of free slots
+    size_t Live;			///< objects in use
 };
 
+#ifdef USE_CORE_RC_STATISTICS
+
 /**
-**	Generate key for string.
-**
-**	@param len	length of key string
-**	@param str	string for key
+**	Object pool counters of all pools.
 **
-**	@returns a 32bit/64bit key for first part of string.
+**	The counters aren't locked, with several threads they are only
+**	estimates.
 */
-static inline size_t StringPoolKeygen(int len, const uint8_t * str)
+static struct _object_pool_stat_
 {
-    size_t key;
+    size_t Allocs;			///< objects allocated
+    size_t Reuses;			///< objects reused from free list
+    size_t Frees;			///< objects freed
+    size_t ChunkAllocs;			///< chunks allocated
+    size_t ChunkBytes;			///< bytes of chunks allocated
+    size_t ChunkFrees;			///< chunks freed
+    size_t Arenas;			///< arenas released
+    size_t Arrays;			///< arrays freed by arenas
+    size_t Reloads;			///< incremental reloads
+    size_t FullReloads;			///< reloads parsing the full config
+    size_t Fragments;			///< fragments reparsed by reloads
+    size_t Nodes;			///< persistent array nodes allocated
+    size_t NodeFrees;			///< persistent array nodes freed
+} ObjectPoolStat;
 
-    key = 0;
-    // 8/4 bytes -> index-key
-    switch (len) {
-	default:
-#if SIZE_MAX == (18446744073709551615UL)
-	    // 64 bit version
-	case 8:
-	    key |= str[7] << 0;
-	    // fallthrough
-	case 7:
-	    key |= str[6] << 8;
-	    // fallthrough
-	case 6:
-	    key |= str[5] << 16;
-	    // fallthrough
-	case 5:
-	    key |= str[4] << 24;
-	    // fallthrough
-	case 4:
-	    key |= (size_t)str[3] << 32;
-	    // fallthrough
-	case 3:
-	    key |= (size_t)str[2] << 40;
-	    // fallthrough
-	case 2:
-	    key |= (size_t)str[1] << 48;
-	    // fallthrough
-	case 1:
-	    key |= (size_t)str[0] << 56;
-	    break;
-#else
-	    // 32 bit version
-	case 4:
-	    key |= str[3] << 0;
-	    // fallthrough
-	case 3:
-	    key |= str[2] << 8;
-	    // fallthrough
-	case 2:
-	    key |= str[1] << 16;
-	    // fallthrough
-	case 1:
-	    key |= str[0] << 24;
-	    break;
 #endif
-	case 0:
-	    break;
-    }
 
-    return key;
-}
+    /// number of slots in a chunk
+#define OBJECT_POOL_SLOTS(chunk) \
+    (((chunk)->Size - offsetof(ObjectChunk, Slots)) / sizeof(ObjectSlot))
+
+static ObjectPool ConfigObjectPool;	///< pool of objects outside arenas
+
+    /// lock of the pool of objects outside arenas, used by all threads
+static pthread_mutex_t ConfigObjectLock = PTHREAD_MUTEX_INITIALIZER;
 
 /**
-**	Allocate string from pool.
+**	Allocate object from pool.
 **
-**	@param pool	string-pool to use
-**	@param string	string to be copied into pool
+**	@param pool	object pool to use
 **
-**	@returns pointer to unique string
+**	@returns object 8 bytes aligned
 */
-static const char *StringPoolAlloc(StringPool * pool, const char *string)
+static inline ConfigObject *ObjectPoolAlloc(ObjectPool * pool)
 {
-    unsigned len;
-    char *dst;
-    StringNode *node;
+    ObjectSlot *slot;
+    ObjectChunk *chunk;
 
-    if (string < &EDATA) {		// string from C constant area
-#ifdef DEBUG_CORE_RC
-	fprintf(stderr, "EDATA %s\n", string);
+#ifdef USE_CORE_RC_STATISTICS
+    ++ObjectPoolStat.Allocs;
 #endif
-	return string;
-    }
-    len = strlen(string) + 1;
-    if (len >= STRING_POOL_MAX_SIZE) {	// too big, just allocate
-	return strdup(string);
+    ++pool->Live;
+    if ((slot = pool->Free)) {		// reuse freed slot
+	pool->Free = slot->Next;
+#ifdef USE_CORE_RC_STATISTICS
+	++ObjectPoolStat.Reuses;
+#endif
+	return &slot->Object;
     }
-    // find pool with empty slot
-    for (node = pool->Pools; node; node = node->Next) {
-	if (node->Free >= len) {
-	    goto out;
+    chunk = pool->Chunks;
+    if (!chunk || chunk->Used == OBJECT_POOL_SLOTS(chunk)) {
+	size_t size;
+
+	// small configs and fragments need only small chunks
+	size = chunk ? chunk->Size * 2 : OBJECT_POOL_MIN_SIZE;
+	if (size > OBJECT_POOL_SIZE) {
+	    size = OBJECT_POOL_SIZE;
 	}
+	chunk = malloc(size);
+	chunk->Next = pool->Chunks;
+	chunk->Size = size;
+	chunk->Used = 0;
+	pool->Chunks = chunk;
+#ifdef USE_CORE_RC_STATISTICS
+	++ObjectPoolStat.ChunkAllocs;
+	ObjectPoolStat.ChunkBytes += size;
+#endif
     }
-
-    node = malloc(STRING_POOL_SIZE);	// page aligned nodes
-    node->Next = pool->Pools;
-    pool->Pools = node;
-    node->Free = node->Size = STRING_POOL_SIZE - sizeof(*node) + sizeof(char);
-
-  out:
-    dst = node->Data + node->Size - node->Free;
-    memcpy(dst, string, len);
-    node->Free -= len;
-
-    return dst;
+    return &chunk->Slots[chunk->Used++].Object;
 }
 
-#ifdef never_DEBUG_CORE_RC
-
 /**
-**	Helper for string pool dump.
+**	Return object to pool.
 **
-**	@param array	array of strings in pool
-**	@param level	indent level
+**	@param pool	object pool to use
+**	@param object	object allocated from pool
 */
-static void StringPoolDump0(const Array * array, int level)
+static inline void ObjectPoolFree(ObjectPool * pool, ConfigObject * object)
 {
-    size_t index;
-    size_t *value;
-
-    index = 0;
-    value = ArrayFirst(array, &index);
-    while (value) {
-	printf("%*s%0*zx ", level, "", (int)sizeof(size_t) * 2, index);
-
-	if (*value & 4) {		// strings are tagged
-	    const char *string;
-	    ConfigObject *object;
-
-	    object = (ConfigObject *) * value;
-	    string = ((ConfigObject *) ((size_t)object & ~7))->Pointer;
-	    printf("= '%s'\n", string);
-	} else {
-	    printf("->\n");
-	    StringPoolDump0((Array *) * value, level + 8);
-	}
-
-	value = ArrayNext(array, &index);
-    }
+    ObjectSlot *slot;
+
+    slot = (ObjectSlot *) object;
+    slot->Next = pool->Free;
+    pool->Free = slot;
+    --pool->Live;
+#ifdef USE_CORE_RC_STATISTICS
+    ++ObjectPoolStat.Frees;
+#endif
 }
 
 /**
-**	Dump string pool.
+**	Check if object is allocated from pool.
 **
-**	@param pool	string pool variables
-**	@param level	indent level
+**	@param pool	object pool to check
+**	@param object	object to check
 */
-static void StringPoolDump(const StringPool * pool, int level)
+static int ObjectPoolOwns(const ObjectPool * pool, const ConfigObject * object)
 {
-    StringNode *node;
+    const ObjectChunk *chunk;
 
-    StringPoolDump0(pool->Strings, level);
-    for (node = pool->Pools; node; node = node->Next) {
-	printf("%p[%d/%d]", node, node->Free, node->Size);
-    }
-    if (pool->Pools) {
-	printf("\n");
+    for (chunk = pool->Chunks; chunk; chunk = chunk->Next) {
+	if ((const ObjectSlot *)object >= chunk->Slots
+	    && (const ObjectSlot *)object < chunk->Slots + chunk->Used) {
+	    return 1;
+	}
     }
+    return 0;
 }
 
-#endif
-
 /**
-**	Create a new empty string-pool.
+**	Move all objects of a pool into another pool.
 **
-**	@returns new empty string pool.
+**	@param dst	object pool receiving the objects
+**	@param src	object pool to empty
 */
-static inline StringPool *StringPoolNew(void)
+static void ObjectPoolMerge(ObjectPool * dst, ObjectPool * src)
 {
-    return calloc(1, sizeof(StringPool));
+    ObjectChunk *chunk;
+    ObjectSlot *slot;
+
+    if ((chunk = src->Chunks)) {
+	while (chunk->Next) {
+	    chunk = chunk->Next;
+	}
+	chunk->Next = dst->Chunks;
+	dst->Chunks = src->Chunks;
+    }
+    if ((slot = src->Free)) {
+	while (slot->Next) {
+	    slot = slot->Next;
+	}
+	slot->Next = dst->Free;
+	dst->Free = src->Free;
+    }
+    dst->Live += src->Live;
+
+    src->Chunks = NULL;
+    src->Free = NULL;
+    src->Live = 0;
 }
 
 /**
-**	Free memory used by lookup array.
+**	Release all chunks of object pool.
+**
+**	All objects of the pool are freed, without touching the objects.
 **
-**	@param array	string pool lookup array
+**	@param pool	object pool to clear
 */
-static void StringPoolDelStrings(Array * array)
+static void ObjectPoolClear(ObjectPool * pool)
 {
-    size_t index;
-    size_t *value;
-
-    index = 0;
-    value = ArrayFirst(array, &index);
-    while (value) {
-	size_t temp;
+    ObjectChunk *chunk;
 
-	temp = *value;
-	if (temp & 4) {			// strings are tagged
-	    char *s;
-	    size_t n;
-
-	    s = ((ConfigObject *) (temp & ~7))->Pointer;
-	    n = strlen(s) + 1;
-	    if (n >= STRING_POOL_MAX_SIZE) {	// too big, must free
-		free(s);
-	    }
-	    ConfigObjectDel((ConfigObject *) (temp & ~7));
-	} else {
-	    StringPoolDelStrings((Array *) temp);
-	}
-
-	value = ArrayNext(array, &index);
+    while ((chunk = pool->Chunks)) {
+	pool->Chunks = chunk->Next;
+	free(chunk);
+#ifdef USE_CORE_RC_STATISTICS
+	++ObjectPoolStat.ChunkFrees;
+#endif
     }
-    ArrayFree(array);
+    pool->Free = NULL;
+    pool->Live = 0;
 }
 
 /**
-**	Delete a string-pool.
+**	Release all chunks of object pool.
 **
-**	All memory used by string-pool is freed.
+**	Chunks are only released, if no object of the pool is in use.
 **
-**	@param pool	string-pool to be freed.
+**	@param pool	object pool to release
 */
-static void StringPoolDel(StringPool * pool)
+static void ObjectPoolRelease(ObjectPool * pool)
 {
-    StringNode *node;
-
-    StringPoolDelStrings(pool->Strings);
-
-    while ((node = pool->Pools)) {	// free all nodes
-	pool->Pools = node->Next;
-	free(node);
+    if (pool->Live) {
+#ifdef DEBUG_CORE_RC
+	fprintf(stderr, "Object: %zu objects still in use\n", pool->Live);
+#endif
+	return;
     }
-
-    free(pool);
+    ObjectPoolClear(pool);
 }
 
 /**
-**	Intern string.
+**	Allocate new object node.
 **
-**	@param pool	pool to add string
-**	@param string	string to add
+**	@returns random object 8 bytes aligned
 */
-static ConfigObject *StringPoolIntern(StringPool * pool, const char *string)
+static inline ConfigObject *ConfigObjectNew(void)
 {
-    int len;
-    size_t key;
-    Array **parent;
-    size_t *val;
-    const char *str;
     ConfigObject *object;
 
-#if defined(DEBUG_CORE_RC) || defined(DEBUG)
-    object = NULL;
+    // object is 4 bytes on 32bit 8 bytes on 64bit.
+    pthread_mutex_lock(&ConfigObjectLock);
+    object = ObjectPoolAlloc(&ConfigObjectPool);
+    pthread_mutex_unlock(&ConfigObjectLock);
+#ifdef DEBUG_CORE_RC
+    if ((size_t)object & 7) {
+	fprintf(stderr, "Object: unaligned %p\n", object);
+	abort();
+    }
 #endif
-    str = string;
-    len = strlen(str);
-    parent = &pool->Strings;
-    do {
-	key = StringPoolKeygen(len, (uint8_t *) str);
-	val = ArrayIns(parent, key, 0);
-	if (!*val) {			// new key insert string and ready
-	    string = StringPoolAlloc(pool, string);
-	    object = ConfigObjectNew();
-	    object->Pointer = (char *)string;
-	    *val = (size_t)object | 4;
-	    object = (ConfigObject *) * val;
-	    break;
-	}
-
-	str += sizeof(size_t);
-	len -= sizeof(size_t);
-
-	// *val is string or array
-	if (*val & 4) {			// |4 are string objects
-	    const char *old;
-	    int i;
-
-	    object = (ConfigObject *) * val;
-	    old = ((ConfigObject *) ((size_t)object & ~7))->Pointer;
-
-	    i = strlen(old) - (str - string);
-	    // compare string, if not same
-	    if (i == len && (len < 0 || !strcmp(str, old + (str - string)))) {
-		break;
-	    }
-	    // take next 4/8 bytes as next key
-	    key = StringPoolKeygen(i, (uint8_t *) old + (str - string));
-	    *val = (size_t)ArrayNew();
-	    ArrayIns((Array **) val, key, (size_t)object);
-	}
-	parent = (Array **) val;
-
-    } while (len >= 0);
 
     return object;
 }
 
-/// @}
-
-// ----------------------------------------------------------------------------
-
-static StringPool *ConfigStrings;	///< storage of parser strings
-
 /**
-**	Check if object is fixed integer.
-**
-**	@param object	tagged object pointer
+**	Deallocate object node.
 **
-**	@returns true if object is fixed integer object, false otherwise.
+**	@param object	config pointer object
 */
-static inline int ConfigIsFixed(const ConfigObject * object)
+static inline void ConfigObjectDel(ConfigObject * object)
 {
-    return (size_t)object & 1;
+    pthread_mutex_lock(&ConfigObjectLock);
+    ObjectPoolFree(&ConfigObjectPool, object);
+    pthread_mutex_unlock(&ConfigObjectLock);
 }
 
+// ------------------------------------------------------------------------ //
+// Arena
+// ------------------------------------------------------------------------ //
+
+///
+///	@defgroup arena The config arena module.
+///
+///	Each config owns an arena.  All array objects created while
+///	parsing the config are allocated from the arena and the arena
+///	remembers all arrays of the config.  Freeing the config releases
+///	the chunks of the arena and frees the arrays from this list, the
+///	tree of the config isn't walked.
+///
+///	The nodes of the arrays self are allocated by core-array, which has
+///	no allocator hooks.  They are freed one array at a time.
+///
+/// @{
+
 /**
-**	Check if object is floating-point number.
-**
-**	@param object	tagged object pointer
+**	Config arena typedef.
 */
-static inline int ConfigIsFloat(const ConfigObject * object)
-{
-    return !ConfigIsFixed(object) && (size_t)object & 2;
-}
+typedef struct _config_arena_ ConfigArena;
 
-#if 0
+#ifdef USE_CORE_RC_RELOAD
 
 /**
-**	Check if object is a pointer object.
-**
-**	@param object	tagged object pointer
+**	Config fragment typedef.
 */
-static inline int ConfigIsPointer(const ConfigObject * object)
-{
-    return object && !((size_t)object & 7);
-}
+typedef struct _config_fragment_ ConfigFragment;
+
+    /// release reference of config fragment
+static void FragmentUnref(ConfigFragment *);
 
 #endif
+#ifdef USE_CORE_RC_INDEX
 
 /**
-**	Check if object is a word object.
-**
-**	@param object	tagged object pointer
+**	Path index typedef.
 */
-static inline int ConfigIsWord(const ConfigObject * object)
-{
-    return (((size_t)object & 7) == 4);
-}
+typedef struct _path_index_ PathIndex;
+
+    /// free path index
+static void PathIndexDel(PathIndex *);
+
+#endif
+
+    /// free array of array object
+static void ObjectArrayFree(ConfigObject *);
+
+    /// check if object is an array object
+static inline int ConfigIsArray(const ConfigObject *);
 
 /**
-**	Check if object is an array object.
-**
-**	@param object	tagged object pointer
+**	Config arena structure.
 */
-static inline int ConfigIsArray(const ConfigObject * object)
+struct _config_arena_
 {
-    return object && !((size_t)object & 7);
-}
-
-#if 0
+    ObjectPool Objects;			///< objects of config
+    ConfigObject **Arrays;		///< array objects of config
+    size_t ArrayN;			///< number of arrays
+    size_t ArrayMax;			///< allocated array slots
+    char **Files;			///< files read into config
+    int FileN;				///< number of files
+#ifdef USE_CORE_RC_RELOAD
+    ConfigFragment **Fragments;		///< fragments of config
+    int FragmentN;			///< number of fragments
+    int Modified;			///< config modified after parse
+#endif
+#ifdef USE_CORE_RC_BINARY
+    void *Map;				///< mapped binary snapshot
+    size_t MapSize;			///< size of mapped snapshot
+#endif
+#ifdef USE_CORE_RC_INDEX
+    PathIndex *Index;			///< index of full paths
+#endif
+};
 
 /**
-**	Create a new fixed integer object.
-**
-**	@param integer	31/63 bit used unsigned integer
+**	Create a new empty arena.
 **
-**	@returns tagged fixed integer object pointer.
+**	@returns new empty arena.
 */
-static inline ConfigObject *ConfigNewInteger(size_t integer)
+static inline ConfigArena *ArenaNew(void)
 {
-    return (ConfigObject *) ((integer << 1) + 1);
+    return calloc(1, sizeof(ConfigArena));
 }
-#endif
 
 /**
-**	Create a new floating-point number object.
-**
-**	@param number	30/62 bit used floating-point number
+**	Remember array object in arena.
 **
-**	@returns tagged floating point object pointer.
+**	@param arena	arena owning the array
+**	@param object	array object, |1 if object is from the global pool
 */
-inline ConfigObject *ConfigNewDouble(double number)
+static void ArenaAddArray(ConfigArena * arena, ConfigObject * object)
 {
-    union
-    {
-#if SIZE_MAX == (18446744073709551615UL)
-	double f;
-#else
-	float f;
-#endif
-	size_t i;
-    } c;
-
-    c.f = number;
-    return (ConfigObject *) ((c.i & ~3) | 2);
+    if (arena->ArrayN == arena->ArrayMax) {
+	arena->ArrayMax = arena->ArrayMax ? arena->ArrayMax * 2 : 64;
+	arena->Arrays =
+	    realloc(arena->Arrays, arena->ArrayMax * sizeof(*arena->Arrays));
+    }
+    arena->Arrays[arena->ArrayN++] = object;
 }
 
 /**
-**	Create a new array object.
+**	Create a new array object in arena.
 **
+**	@param arena	arena to use
 **	@param array	core array converted into array object
 **
 **	@returns tagged array object pointer.
-**
-**	@todo should use an object pool
 */
-inline ConfigObject *ConfigNewArray(const Array * array)
+static ConfigObject *ArenaNewArray(ConfigArena * arena, const Array * array)
 {
     ConfigObject *object;
 
-    object = ConfigObjectNew();
+    object = ObjectPoolAlloc(&arena->Objects);
     object->Pointer = (void *)array;
+    ArenaAddArray(arena, object);
 
     return object;
 }
 
 /**
-**	Create a new config object.
+**	Adopt array objects created outside of arena.
 **
-**	@param array	core array converted into config object
+**	Arrays created with ConfigNewArray() belong to nobody, until they
+**	are stored into a config.
 **
-**	@returns tagged array object pointer.
+**	@param arena	arena which takes ownership
+**	@param object	tagged object pointer
 */
-inline Config *ConfigNewConfig(const Array * array)
+static void ArenaAdopt(ConfigArena * arena, const ConfigObject * object)
 {
-    ConfigObject *object;
+    size_t index;
+    size_t *value;
 
-    if (!ConfigStrings) {
-	ConfigStrings = StringPoolNew();
-#ifdef DEBUG_CORE_RC
-	fprintf(stderr, "new string pool\n");
-#endif
+    if (!ConfigIsArray(object) || ((size_t)object->Pointer & 7)
+	|| ObjectPoolOwns(&arena->Objects, object)) {
+	return;
     }
+    ArenaAddArray(arena, (ConfigObject *) ((size_t)object | 1));
 
-    object = ConfigObjectNew();
-    object->Pointer = (void *)array;
-
-    return (Config *) object;
+    index = 0;
+    value = ArrayFirst(object->Pointer, &index);
+    while (value) {
+	ArenaAdopt(arena, (const ConfigObject *)index);
+	ArenaAdopt(arena, (const ConfigObject *)*value);
+	value = ArrayNext(object->Pointer, &index);
+    }
 }
 
 /**
-**	Create a new string object.
-**
-**	@param string	string converted into fixed string object
+**	Remember file read into arena.
 **
-**	@returns tagged fixed string object pointer.
-**
-**	@todo should use an object pool
-**	@todo second array string -> object unnecessary
+**	@param arena	arena of config
+**	@param name	file name
 */
-inline ConfigObject *ConfigNewString(const char *string)
+static void ArenaAddFile(ConfigArena * arena, const char *name)
 {
-    if (!string) {
-	fprintf(stderr, "core-rc: null string\n");
-	string = "";
-    }
-    return StringPoolIntern(ConfigStrings, string);
+    arena->Files =
+	realloc(arena->Files, (arena->FileN + 1) * sizeof(*arena->Files));
+    arena->Files[arena->FileN++] = strdup(name);
 }
 
 /**
-**	Convert (unchecked) fixed object to C integer.
+**	Delete an arena.
 **
-**	@param object	tagged object pointer
+**	All arrays and objects of the arena are freed.
 **
-**	@returns fixed integer part of object pointer.
+**	@param arena	arena to be freed
 */
-static inline ssize_t ConfigInteger(const ConfigObject * object)
+static void ArenaDel(ConfigArena * arena)
 {
-    return (ssize_t) object >> 1;
+    size_t i;
+
+    for (i = 0; i < arena->ArrayN; ++i) {
+	ConfigObject *object;
+
+	object = (ConfigObject *) ((size_t)arena->Arrays[i] & ~1);
+	ObjectArrayFree(object);
+	if ((size_t)arena->Arrays[i] & 1) {	// adopted object
+	    ConfigObjectDel(object);
+	}
+    }
+#ifdef USE_CORE_RC_STATISTICS
+    ++ObjectPoolStat.Arenas;
+    ObjectPoolStat.Arrays += arena->ArrayN;
+#endif
+    free(arena->Arrays);
+    for (i = 0; i < (size_t)arena->FileN; ++i) {
+	free(arena->Files[i]);
+    }
+    free(arena->Files);
+#ifdef USE_CORE_RC_RELOAD
+    for (i = 0; i < (size_t)arena->FragmentN; ++i) {
+	FragmentUnref(arena->Fragments[i]);
+    }
+    free(arena->Fragments);
+#endif
+#ifdef USE_CORE_RC_BINARY
+    if (arena->Map) {
+	munmap(arena->Map, arena->MapSize);
+    }
+#endif
+#ifdef USE_CORE_RC_INDEX
+    PathIndexDel(arena->Index);
+#endif
+    ObjectPoolClear(&arena->Objects);
+    free(arena);
 }
 
+#ifdef USE_CORE_RC_RELOAD
+
 /**
-**	Convert (unchecked) fixed object to C unsigned integer.
-**
-**	@param object	tagged object pointer
-**
-**	@returns fixed unsigned integer part of object pointer.
+**	Stat of file read into a fragment.
 */
-static inline size_t ConfigUnsigned(const ConfigObject * object)
+typedef struct _config_file_stat_
 {
-    return (size_t)object >> 1;
-}
+    char *Name;				///< file name
+    off_t Size;				///< file size, -1 missing file
+    struct timespec MTime;		///< file modification time
+    uint64_t Hash;			///< hash of file content
+} ConfigFileStat;
 
 /**
-**	Convert (unchecked) float object to C double.
-*
-**	@param object	tagged object pointer
+**	Config fragment.
 **
-**	@returns floating point part of object pointer.
+**	The top-level statements of the main file and every file included
+**	by the main file are a fragment.  A fragment remembers the
+**	top-level keys it has written and read.	 Unchanged fragments are
+**	shared by reloaded configs, they are reference counted.
 */
-static inline double ConfigDouble(const ConfigObject * object)
+struct _config_fragment_
 {
-    union
-    {
-#if SIZE_MAX == (18446744073709551615UL)
-	double f;
-#else
-	float f;
-#endif
-	size_t i;
-    } c;
+    int Refs;				///< reference counter
+    ConfigArena *Arena;			///< arena of fragment
+    Array *Keys;			///< top-level keys written
+    Array *Reads;			///< top-level keys read as variable
+    ConfigFileStat *Files;		///< fragment file and its includes
+    int FileN;				///< number of files
+};
 
-    c.i = (size_t)object & ~2;
-    return c.f;
-}
+    /// offset basis of file hash
+#define FILE_HASH_BASIS 0xCBF29CE484222325ULL
 
 /**
-**	Convert (unchecked) word object to C string.
+**	Update file hash (FNV-1a).
 **
-**	@param object	tagged object pointer
+**	@param hash	hash of previous bytes
+**	@param buf	bytes to add
+**	@param n	number of bytes
 **
-**	@returns pointer to fixed word string, stored in object.
+**	@returns updated hash.
 */
-static inline const char *ConfigString(const ConfigObject * object)
+static uint64_t FileHashUpdate(uint64_t hash, const char *buf, size_t n)
 {
-    object = (const ConfigObject *)((size_t)object & ~7);
-    return object->Pointer;
+    size_t i;
+
+    for (i = 0; i < n; ++i) {
+	hash ^= (unsigned char)buf[i];
+	hash *= 0x100000001B3ULL;
+    }
+    return hash;
 }
 
 /**
-**	Convert (unchecked) array object to C array.
+**	Create a new fragment.
 **
-**	@param object	tagged object pointer
-*
-**	@returns pointer to array, stored in object.
+**	@returns new fragment with one reference.
 */
-static inline Array *ConfigArray(const ConfigObject * object)
+static ConfigFragment *FragmentNew(void)
 {
-    return object->Pointer;
+    ConfigFragment *fragment;
+
+    fragment = calloc(1, sizeof(*fragment));
+    fragment->Refs = 1;
+    fragment->Arena = ArenaNew();
+    fragment->Keys = ArrayNew();
+    fragment->Reads = ArrayNew();
+
+    return fragment;
 }
 
 /**
-**	Check if value is a fixed integer object.
+**	Add reference to fragment.
 **
-**	@param object		tagged object pointer
-**	@param[out] result	fixed integer object is stored in result
+**	@param fragment	config fragment
+*/
+static inline void FragmentRef(ConfigFragment * fragment)
+{
+    __atomic_add_fetch(&fragment->Refs, 1, __ATOMIC_RELAXED);
+}
+
+/**
+**	Release reference of fragment, the last reference frees it.
 **
-**	@returns true if object is fixed integer object, false otherwise.
+**	@param fragment	config fragment
 */
-int ConfigCheckInteger(const ConfigObject * object, ssize_t * result)
+static void FragmentUnref(ConfigFragment * fragment)
 {
-    if (ConfigIsFixed(object)) {
-	*result = ConfigInteger(object);
-	return 1;
+    int i;
+
+    if (__atomic_sub_fetch(&fragment->Refs, 1, __ATOMIC_ACQ_REL)) {
+	return;
     }
-    return 0;
+    ArenaDel(fragment->Arena);
+    ArrayFree(fragment->Keys);
+    ArrayFree(fragment->Reads);
+    for (i = 0; i < fragment->FileN; ++i) {
+	free(fragment->Files[i].Name);
+    }
+    free(fragment->Files);
+    free(fragment);
 }
 
 /**
-**	Check if value is an unsigned integer object.
+**	Remember file read into fragment.
 **
-**	@param object		tagged object pointer
-**	@param[out] result	unsigned integer object is stored in result
+**	@param fragment	config fragment
+**	@param name	file name
+**	@param file	opened file stream, NULL for missing file
 **
-**	@returns true if object is unsigned integer object, false otherwise.
+**	@returns index of file in fragment.
 */
-int ConfigCheckUnsigned(const ConfigObject * object, size_t *result)
+static int FragmentAddFile(ConfigFragment * fragment, const char *name,
+    FILE * file)
 {
-    if (ConfigIsFixed(object)) {
-	*result = ConfigUnsigned(object);
-	return 1;
+    ConfigFileStat *info;
+    struct stat st;
+
+    fragment->Files = realloc(fragment->Files,
+	(fragment->FileN + 1) * sizeof(*fragment->Files));
+    info = fragment->Files + fragment->FileN;
+    memset(info, 0, sizeof(*info));
+    info->Name = strdup(name);
+    info->Size = -1;
+    info->Hash = FILE_HASH_BASIS;
+    if (file && !fstat(fileno(file), &st)) {
+	info->Size = st.st_size;
+	info->MTime = st.st_mtim;
     }
-    return 0;
+
+    return fragment->FileN++;
 }
 
 /**
-**	Check if value is a floating point object.
+**	Check if the files of a fragment have changed.
 **
-**	@param object		tagged object pointer
-**	@param[out] result	floating point object is stored in result
+**	Files with unchanged size and modification time are unchanged,
+**	otherwise the content hash is compared.
 **
-**	@returns true if object is floating point object, false otherwise.
+**	@param fragment	config fragment
+**
+**	@returns true if any file of fragment has changed.
 */
-int ConfigCheckDouble(const ConfigObject * object, double *result)
+static int FragmentChanged(const ConfigFragment * fragment)
 {
-    if (ConfigIsFloat(object)) {
-	*result = ConfigDouble(object);
-	return 1;
+    int i;
+
+    for (i = 0; i < fragment->FileN; ++i) {
+	const ConfigFileStat *info;
+	struct stat st;
+	FILE *file;
+	uint64_t hash;
+	size_t n;
+	char buf[4096];
+
+	info = fragment->Files + i;
+	if (stat(info->Name, &st)) {
+	    if (info->Size != -1) {
+		return 1;
+	    }
+	    continue;
+	}
+	if (info->Size == -1) {
+	    return 1;
+	}
+	if (info->Size == st.st_size
+	    && info->MTime.tv_sec == st.st_mtim.tv_sec
+	    && info->MTime.tv_nsec == st.st_mtim.tv_nsec) {
+	    continue;
+	}
+	if (!(file = fopen(info->Name, "rb"))) {
+	    return 1;
+	}
+	hash = FILE_HASH_BASIS;
+	while ((n = fread(buf, 1, sizeof(buf), file)) > 0) {
+	    hash = FileHashUpdate(hash, buf, n);
+	}
+	fclose(file);
+	if (hash != info->Hash) {
+	    return 1;
+	}
     }
     return 0;
 }
 
 /**
-**	Check if value is a fixed string object.
-**
-**	@param object		tagged object pointer
-**	@param[out] result	fixed string is stored in result
+**	Check if two key sets intersect.
 **
-**	@returns true if object is fixed string object, false otherwise.
+**	@param a	first key set
+**	@param b	second key set
 */
-int ConfigCheckString(const ConfigObject * object, const char **result)
+static int FragmentKeysIntersect(const Array * a, const Array * b)
 {
-    if (ConfigIsWord(object)) {
-	*result = ConfigString(object);
-	return 1;
+    size_t index;
+    const size_t *value;
+
+    index = 0;
+    value = ArrayFirst(a, &index);
+    while (value) {
+	if (ArrayGet(b, index)) {
+	    return 1;
+	}
+	value = ArrayNext(a, &index);
     }
     return 0;
 }
 
 /**
-**	Check if value is an array object.
-**
-**	@param object		tagged object pointer
-**	@param[out] result	array object is stored in result
+**	Remember fragment in arena of config.
 **
-**	@returns true if object is an array object, false otherwise.
+**	@param arena	arena of config
+**	@param fragment	fragment, the reference moves to the arena
 */
-int ConfigCheckArray(const ConfigObject * object, const ConfigObject ** result)
+static void ArenaAddFragment(ConfigArena * arena, ConfigFragment * fragment)
 {
-    if (ConfigIsArray(object)) {
-	*result = object;
-	return 1;
-    }
-    return 0;
+    arena->Fragments = realloc(arena->Fragments,
+	(arena->FragmentN + 1) * sizeof(*arena->Fragments));
+    arena->Fragments[arena->FragmentN++] = fragment;
 }
 
-#ifdef USE_CORE_RC_GET_STRINGS
+#endif
+
+#ifdef USE_CORE_RC_PARALLEL
 
 /**
-**	Lookup config object.
+**	Move arrays, objects, files and fragments of an arena into another
+**	arena.
 **
-**	@param config	config dictionary or sub array
-**	@param ap	array of strings NULL terminated, to select value
-**
-**	@returns object stored in dictionary at index ap
+**	@param dst	arena receiving the arrays
+**	@param src	arena to merge (freed)
 */
-static const ConfigObject *ConfigStringsLookup(const ConfigObject * config,
-    va_list ap)
+static void ArenaMerge(ConfigArena * dst, ConfigArena * src)
 {
-    const char *name;
+    size_t i;
+    int j;
 
-    // loop over all index keys
-    while ((name = va_arg(ap, const char *)))
-    {
-	if (!ConfigIsArray(config)) {
-	    fprintf(stderr, "array required for index '%s'\n", name);
-	    return NULL;
-	}
-	config = (const ConfigObject *)
-	    ArrayGet(ConfigArray(config), (size_t)ConfigNewString(name));
+    for (i = 0; i < src->ArrayN; ++i) {
+	ArenaAddArray(dst, src->Arrays[i]);
     }
-    return config;
+    ObjectPoolMerge(&dst->Objects, &src->Objects);
+    dst->Files = realloc(dst->Files,
+	(dst->FileN + src->FileN) * sizeof(*dst->Files));
+    for (j = 0; j < src->FileN; ++j) {
+	dst->Files[dst->FileN++] = src->Files[j];
+    }
+#ifdef USE_CORE_RC_RELOAD
+    for (j = 0; j < src->FragmentN; ++j) {
+	ArenaAddFragment(dst, src->Fragments[j]);
+    }
+    free(src->Fragments);
+#endif
+    free(src->Arrays);
+    free(src->Files);
+    free(src);
 }
 
+#endif
+
+/// @}
+
+
+// ------------------------------------------------------------------------ //
+// String pool
+// ------------------------------------------------------------------------ //
+
+///
+///	@defgroup stringpool The string-pool module.
+///
+///	This module handles string-pools.  String pools handles string
+///	memory managment.  Only one copy of equal strings is stored.
+///	Strings are found with an open addressing hash table, which stores
+///	the hash of each string.  Each string is stored after a header with
+///	its length and hash.
+///
+///	With #USE_CORE_RC_SHORT_STRING strings up to #STRING_SHORT_MAX bytes
+///	aren't stored in a pool, their bytes are stored in the tagged value
+///	itself.  Equal short strings are equal values.  Only the functions
+///	returning a const char pointer spell them in the pool, once.
+///
+/// @{
+
+    /// bigger strings get their own node
+static const size_t STRING_POOL_MAX_SIZE = 4096;
+
+    /// pool size
+static const size_t STRING_POOL_SIZE = 8192;
+
+    /// number of size classes of free tails (log2 of pool size + 1)
+#define STRING_TAIL_CLASSES 14
+
 /**
-**	Get config any value object.
-**
-**	@param config		config dictionary
-**	@param[out] result	object result
-**	@param ...		list of objects NULL terminated, to select value
+**	String-pool typedef.
+*/
+typedef struct _string_pool_ StringPool;
+
+/**
+**	Header stored before each string of a pool.
+*/
+typedef struct _string_header_
+{
+    uint32_t Length;			///< length of string without '\0'
+    uint32_t Hash;			///< low 32 bit of string hash
+} StringHeader;
+
+/**
+**	String-pool node typedef
+*/
+typedef struct _string_node_ StringNode;
+
+/**
+**	A node of string pool structure.
+*/
+struct _string_node_
+{
+    StringNode *Next;			///< next node
+    uint32_t Size;			///< allocated size of node
+    uint32_t Free;			///< free bytes in node
+    char Data[1];			///< string memory
+};
+
+/**
+**	Free tail of a string-pool node.
 **
-**	@returns true if value found at index in dictionary.
+**	Tails are stored in the free memory itself, unaligned with memcpy.
 */
-int ConfigStringsGetObject(const ConfigObject * config,
-    const ConfigObject ** result, ...)
+typedef struct _string_tail_
 {
-    va_list ap;
-    const ConfigObject *value;
+    char *Next;				///< next tail of same size class
+    StringNode *Node;			///< node of tail
+    size_t Size;			///< size of tail
+} StringTail;
 
-    va_start(ap, result);
-    value = ConfigStringsLookup(config, ap);
-    va_end(ap);
+/**
+**	String-pool hash table slot.
+*/
+typedef struct _string_slot_
+{
+    size_t Hash;			///< hash of string
+    ConfigObject *Object;		///< tagged string object, NULL empty
+} StringSlot;
 
-    if (value) {
-	*result = value;
-	return 1;
-    }
-    return 0;
-}
+/**
+**	String-pool hash table typedef.
+*/
+typedef struct _string_table_ StringTable;
 
 /**
-**	Get config integer object.
+**	String-pool hash table.
 **
-**	@param config		config dictionary
-**	@param[out] result	signed integer result
-**	@param ...		list of objects NULL terminated, to select value
+**	Readers search the table without lock, see StringPoolLookupHash().
+**	A grown table replaces the table as a whole, the replaced tables
+**	are kept until the pool is deleted, because readers can still
+**	search them.  They are smaller than the current table together.
+*/
+struct _string_table_
+{
+    size_t Mask;			///< number of slots - 1
+    StringTable *Old;			///< replaced table
+    StringSlot Slots[];			///< lookup of strings
+};
+
+/**
+**	String-pool variables structure.
+*/
+struct _string_pool_
+{
+    StringNode *Pools;			///< list of pools, first is current
+    char *Tails[STRING_TAIL_CLASSES];	///< free tails by size class
+    StringTable *Table;			///< lookup of strings, atomic
+    size_t Used;			///< number of used slots
+    ObjectPool Objects;			///< string objects
+};
+
+    /// initial number of hash table slots (power of 2)
+static const size_t STRING_POOL_SLOTS = 256;
+
+    /// string hash constants
+    ///@{
+static const uint64_t STRING_HASH_K0 = 0xa0761d6478bd642fULL;
+static const uint64_t STRING_HASH_K1 = 0xe7037ed1a0b428dbULL;
+
+    ///@}
+
+/**
+**	Mix two words for string hash.
 **
-**	@returns true if value found at index in dictionary.
+**	The 128 bit product of the words is folded into 64 bit.
 */
-int ConfigStringsGetInteger(const ConfigObject * config, ssize_t * result, ...)
+static inline uint64_t StringHashMix(uint64_t a, uint64_t b)
 {
-    va_list ap;
-    const ConfigObject *value;
+#ifdef __SIZEOF_INT128__
+    __uint128_t r;
 
-    va_start(ap, result);
-    value = ConfigStringsLookup(config, ap);
-    va_end(ap);
+    r = (__uint128_t) a *b;
+    return (uint64_t) r ^ (uint64_t) (r >> 64);
+#else
+    uint64_t r;
 
-    if (ConfigIsFixed(value)) {
-	*result = ConfigInteger(value);
-	return 1;
-    }
-    if (value) {
-	fprintf(stderr, "value isn't a fixed integer\n");
-    }
-    return 0;
+    r = (a ^ (a >> 32)) * (b | 1);
+    return r ^ (r >> 29);
+#endif
 }
 
 /**
-**	Get config unsigned object.
-**
-**	@param config		config dictionary
-**	@param[out] result	unsigned integer result
-**	@param ...		list of objects NULL terminated, to select value
-**
-**	@returns true if value found at index in dictionary.
+**	Load 64 bit word of string.
 */
-int ConfigStringsGetUnsigned(const ConfigObject * config, size_t *result, ...)
+static inline uint64_t StringHashLoad64(const char *str)
 {
-    va_list ap;
-    const ConfigObject *value;
+    uint64_t word;
 
-    va_start(ap, result);
-    value = ConfigStringsLookup(config, ap);
-    va_end(ap);
+    memcpy(&word, str, sizeof(word));
+    return word;
+}
 
-    if (ConfigIsFixed(value)) {
-	*result = ConfigInteger(value);
-	return 1;
-    }
-    if (value) {
-	fprintf(stderr, "value isn't a fixed unsigned\n");
-    }
-    return 0;
+/**
+**	Load 32 bit word of string.
+*/
+static inline uint64_t StringHashLoad32(const char *str)
+{
+    uint32_t word;
+
+    memcpy(&word, str, sizeof(word));
+    return word;
 }
 
 /**
-**	Get config boolean object.
+**	Calculate hash of string.
 **
-**	@param config		config dictionary
-**	@param ...		list of objects NULL terminated, to select value
+**	The string is hashed a word at a time, 16 bytes per step.  The tail
+**	is read with overlapping loads, the length is part of the hash.
 **
-**	@retval -1	if index didn't exists in dictionary.
-**	@retval	true	if value is not false.
-**	@retval	false	if value is 'false' or 0.
+**	@param string	string to hash
+**	@param len	length of string
+**
+**	@returns hash of string.
 */
-int ConfigStringsGetBoolean(const ConfigObject * config, ...)
+static uint64_t StringHash(const char *string, size_t len)
 {
-    va_list ap;
-    const ConfigObject *value;
-
-    va_start(ap, config);
-    value = ConfigStringsLookup(config, ap);
-    va_end(ap);
-
-    if (ConfigIsFixed(value)) {
-	return ConfigInteger(value);
+    uint64_t hash;
+    uint64_t a;
+    uint64_t b;
+    size_t n;
+
+    hash = len ^ STRING_HASH_K0;
+    for (n = len; n > 16; n -= 16) {
+	hash = StringHashMix(StringHashLoad64(string) ^ STRING_HASH_K1,
+	    StringHashLoad64(string + 8) ^ hash);
+	string += 16;
     }
-    if (value) {
-	fprintf(stderr, "value isn't a fixed integer\n");
+    if (n > 8) {
+	a = StringHashLoad64(string);
+	b = StringHashLoad64(string + n - 8);
+    } else if (n >= 4) {
+	a = StringHashLoad32(string);
+	b = StringHashLoad32(string + n - 4);
+    } else if (n) {
+	a = ((uint64_t) (uint8_t) string[0] << 16)
+	    | ((uint64_t) (uint8_t) string[n >> 1] << 8)
+	    | (uint8_t) string[n - 1];
+	b = 0;
+    } else {
+	a = b = 0;
     }
-    return -1;
+    hash = StringHashMix(a ^ STRING_HASH_K1, b ^ hash);
+
+    return StringHashMix(hash ^ STRING_HASH_K0, len ^ STRING_HASH_K1);
 }
 
 /**
-**	Get config double object.
+**	Get size class of free tail.
 **
-**	@param config		config dictionary
-**	@param[out] result	double result
-**	@param ...		list of objects NULL terminated, to select value
+**	@param size	size of tail
 **
-**	@returns true if value found at index in dictionary.
+**	@returns log2 of size.
 */
-int ConfigStringsGetDouble(const ConfigObject * config, double *result, ...)
+static inline int StringTailClass(size_t size)
 {
-    va_list ap;
-    const ConfigObject *value;
+    return (sizeof(long) * 8 - 1) - __builtin_clzl(size);
+}
 
-    va_start(ap, result);
-    value = ConfigStringsLookup(config, ap);
-    va_end(ap);
+/**
+**	Put unused memory of node into free tail lists.
+**
+**	Tails too small for the list entry are wasted.
+**
+**	@param pool	string-pool of node
+**	@param node	node of tail
+**	@param tail	free memory
+**	@param size	size of free memory
+*/
+static void StringPoolAddTail(StringPool * pool, StringNode * node,
+    char *tail, size_t size)
+{
+    StringTail entry;
+    int class;
 
-    if (ConfigIsFloat(value)) {
-	*result = ConfigDouble(value);
-	return 1;
-    }
-    if (value) {
-	fprintf(stderr, "value isn't a double\n");
+    if (size < sizeof(entry)) {
+	return;
     }
-    return 0;
+    class = StringTailClass(size);
+    entry.Next = pool->Tails[class];
+    entry.Node = node;
+    entry.Size = size;
+    memcpy(tail, &entry, sizeof(entry));
+    pool->Tails[class] = tail;
 }
 
 /**
-**	Get config string object.
+**	Allocate memory from free tail lists.
 **
-**	@param config		config dictionary
-**	@param[out] result	string result
-**	@param ...		list of objects NULL terminated, to select value
+**	Only size classes, which are big enough for all their tails, are
+**	searched.
 **
-**	@returns true if value found at index in dictionary.
+**	@param pool	string-pool to use
+**	@param len	number of bytes needed
+**
+**	@returns memory for string or NULL if no tail is big enough.
 */
-int ConfigStringsGetString(const ConfigObject * config, const char **result,
-    ...)
+static char *StringPoolTailAlloc(StringPool * pool, size_t len)
 {
-    va_list ap;
-    const ConfigObject *value;
-
-    va_start(ap, result);
-    value = ConfigStringsLookup(config, ap);
-    va_end(ap);
-
-    if (ConfigIsWord(value)) {
-	*result = ConfigString(value);
-	return 1;
-    }
-    if (value) {
-	fprintf(stderr, "value isn't a string\n");
+    StringTail entry;
+    char *tail;
+    int class;
+
+    for (class = StringTailClass(len) + ((len & (len - 1)) != 0);
+	class < STRING_TAIL_CLASSES; ++class) {
+	if ((tail = pool->Tails[class])) {
+	    memcpy(&entry, tail, sizeof(entry));
+	    pool->Tails[class] = entry.Next;
+	    entry.Node->Free -= len;
+	    StringPoolAddTail(pool, entry.Node, tail + len, entry.Size - len);
+	    return tail;
+	}
     }
-    return 0;
+    return NULL;
 }
 
 /**
-**	Get config array object.
+**	Allocate string from pool.
 **
-**	@param config		config dictionary
-**	@param[out] result	array result
-**	@param ...		list of objects NULL terminated, to select value
+**	Strings are taken from the current node, when it is full its unused
+**	tail is kept in size class lists for smaller strings.  Each string
+**	is stored after its 4-byte aligned #StringHeader.
 **
-**	@returns true if value found at index in dictionary.
+**	@param pool	string-pool to use
+**	@param string	string to be copied into pool
+**	@param len	length of string
+**	@param hash	hash of string
+**
+**	@returns pointer to unique string
 */
-int ConfigStringsGetArray(const ConfigObject * config,
-    const ConfigObject ** result, ...)
+static const char *StringPoolAlloc(StringPool * pool, const char *string,
+    size_t len, size_t hash)
 {
-    va_list ap;
-    const ConfigObject *value;
-
-    va_start(ap, result);
-    value = ConfigStringsLookup(config, ap);
-    va_end(ap);
-
-    if (ConfigIsArray(value)) {
-	*result = value;
-	return 1;
+    size_t size;
+    char *dst;
+    StringNode *node;
+    StringHeader *header;
+
+    size = (sizeof(*header) + len + 1 + 3) & ~3;
+    node = pool->Pools;
+    if (size >= STRING_POOL_MAX_SIZE) {	// too big, own node
+	node = malloc(offsetof(StringNode, Data) + size);
+	if (pool->Pools) {		// keep current node first
+	    node->Next = pool->Pools->Next;
+	    pool->Pools->Next = node;
+	} else {
+	    node->Next = NULL;
+	    pool->Pools = node;
+	}
+	node->Size = size;
+	node->Free = 0;
+	dst = node->Data;
+	goto out;
     }
-    if (value) {
-	fprintf(stderr, "value isn't an array\n");
+
+    if (!node || node->Free < size) {
+	if ((dst = StringPoolTailAlloc(pool, size))) {
+	    goto out;
+	}
+	if (node && node->Free) {
+	    StringPoolAddTail(pool, node,
+		node->Data + node->Size - node->Free, node->Free);
+	}
+	node = malloc(STRING_POOL_SIZE);	// page aligned nodes
+	node->Next = pool->Pools;
+	pool->Pools = node;
+	node->Free = node->Size = STRING_POOL_SIZE - offsetof(StringNode, Data);
     }
-    return 0;
-}
+    dst = node->Data + node->Size - node->Free;
+    node->Free -= size;
 
-#endif // USE_CORE_RC_GET_STRINGS
+  out:
+    header = (StringHeader *) dst;
+    header->Length = len;
+    header->Hash = hash;
+    dst += sizeof(*header);
+    memcpy(dst, string, len);
+    dst[len] = '\0';
+
+    return dst;
+}
 
 /**
-**	Lookup config object.
+**	Get header of pool string.
 **
-**	@param config	config dictionary or sub array
-**	@param ap	array of objects NULL terminated, to select value
+**	@param string	string of string-pool
+*/
+static inline const StringHeader *StringPoolHeader(const char *string)
+{
+    return (const StringHeader *)string - 1;
+}
+
+#ifdef USE_CORE_RC_SHORT_STRING
+
+#ifdef USE_CORE_RC_NAN_BOX
+    /// NaN-boxed short strings are above, length in bits 48..50
+#define CONFIG_NAN_BOX_STRING	0xFFF4000000000000UL
+    /// longest short string, bytes in the NaN payload
+#define STRING_SHORT_MAX	6
+#else
+    /// longest short string, bytes above the tag and length
+#define STRING_SHORT_MAX	(sizeof(size_t) - 1)
+#endif
+
+/**
+**	Check if value is a short string.
 **
-**	@returns object stored in dictionary at index ap
+**	@param value	tagged value
 */
-static const ConfigObject *ConfigLookup(const ConfigObject * config,
-    va_list ap)
+static inline int StringIsShort(size_t value)
 {
-    const ConfigObject *index;
+#ifdef USE_CORE_RC_NAN_BOX
+    return value - CONFIG_NAN_BOX_STRING < (STRING_SHORT_MAX + 1UL) << 48;
+#else
+    return (value & 7) == 6;
+#endif
+}
 
-    // loop over all index keys
-    while ((index = va_arg(ap, const ConfigObject *)))
-    {
-	if (!ConfigIsArray(config)) {
-	    fprintf(stderr, "array required for index '%p'\n", index);
-	    return NULL;
-	}
-	config = (const ConfigObject *)
-	    ArrayGet(ConfigArray(config), (size_t)index);
-    }
-    return config;
+/**
+**	Get length of (unchecked) short string.
+**
+**	@param value	tagged short string
+*/
+static inline size_t StringShortLength(size_t value)
+{
+#ifdef USE_CORE_RC_NAN_BOX
+    return (value - CONFIG_NAN_BOX_STRING) >> 48;
+#else
+    return (value >> 3) & 7;
+#endif
 }
 
 /**
-**	Get config any value object.
+**	Get bytes of (unchecked) short string.
 **
-**	@param config		config dictionary
-**	@param[out] result	object result
-**	@param ...		list of objects NULL terminated, to select value
+**	The first byte is the most significant, the bytes compare like
+**	strcmp().
 **
-**	@returns true if value found at index in dictionary.
+**	@param value	tagged short string
 */
-int ConfigGetObject(const ConfigObject * config, const ConfigObject ** result,
-    ...)
+static inline size_t StringShortBytes(size_t value)
 {
-    va_list ap;
-    const ConfigObject *value;
-
-    va_start(ap, result);
-    value = ConfigLookup(config, ap);
-    va_end(ap);
-
-    if (value) {
-	*result = value;
-	return 1;
-    }
-    return 0;
+#ifdef USE_CORE_RC_NAN_BOX
+    return value & ((1UL << 48) - 1);
+#else
+    return value >> 8;
+#endif
 }
 
 /**
-**	Get config integer object.
+**	Create a short string.
 **
-**	@param config		config dictionary
-**	@param[out] result	signed integer result
-**	@param ...		list of objects NULL terminated, to select value
+**	@param string	string bytes
+**	@param len	length of string
 **
-**	@returns true if value found at index in dictionary.
+**	@returns tagged short string, 0 if string is too long or contains
+**	'\0'.
 */
-int ConfigGetInteger(const ConfigObject * config, ssize_t * result, ...)
+static inline size_t StringShortNew(const char *string, size_t len)
 {
-    va_list ap;
-    const ConfigObject *value;
-
-    va_start(ap, result);
-    value = ConfigLookup(config, ap);
-    va_end(ap);
+    size_t bytes;
+    size_t i;
 
-    if (ConfigIsFixed(value)) {
-	*result = ConfigInteger(value);
-	return 1;
+    if (len > STRING_SHORT_MAX) {
+	return 0;
     }
-    if (value) {
-	fprintf(stderr, "value isn't a fixed integer\n");
+    bytes = 0;
+    for (i = 0; i < STRING_SHORT_MAX; ++i) {
+	bytes <<= 8;
+	if (i < len) {
+	    if (!string[i]) {
+		return 0;
+	    }
+	    bytes |= (uint8_t) string[i];
+	}
     }
-    return 0;
+#ifdef USE_CORE_RC_NAN_BOX
+    return CONFIG_NAN_BOX_STRING + (len << 48) + bytes;
+#else
+    return bytes << 8 | len << 3 | 6;
+#endif
 }
 
 /**
-**	Get config unsigned object.
+**	Copy (unchecked) short string into buffer.
 **
-**	@param config		config dictionary
-**	@param[out] result	unsigned integer result
-**	@param ...		list of objects NULL terminated, to select value
+**	@param value	tagged short string
+**	@param buf	buffer of #CONFIG_STRING_BUFFER bytes
 **
-**	@returns true if value found at index in dictionary.
+**	@returns @a buf with the '\0' terminated string.
 */
-int ConfigGetUnsigned(const ConfigObject * config, size_t *result, ...)
+static inline const char *StringShortCopy(size_t value, char *buf)
 {
-    va_list ap;
-    const ConfigObject *value;
+    size_t bytes;
+    size_t len;
+    size_t i;
+
+    bytes = StringShortBytes(value);
+    len = StringShortLength(value);
+    for (i = 0; i < len; ++i) {
+	buf[i] = bytes >> (STRING_SHORT_MAX - 1 - i) * 8;
+    }
+    buf[len] = '\0';
 
-    va_start(ap, result);
-    value = ConfigLookup(config, ap);
-    va_end(ap);
+    return buf;
+}
 
-    if (ConfigIsFixed(value)) {
-	*result = ConfigUnsigned(value);
-	return 1;
+#endif
+
+#ifdef never_DEBUG_CORE_RC
+
+/**
+**	Dump string pool.
+**
+**	@param pool	string pool variables
+**	@param level	indent level
+*/
+static void StringPoolDump(const StringPool * pool, int level)
+{
+    const StringSlot *slots;
+    StringNode *node;
+    size_t i;
+
+    slots = pool->Table->Slots;
+    for (i = 0; i <= pool->Table->Mask; ++i) {
+	if (slots[i].Object) {
+	    printf("%*s%0*zx = '%s'\n", level, "", (int)sizeof(size_t) * 2,
+		slots[i].Hash,
+		((ConfigObject *) ((size_t)slots[i].Object & ~7))->Pointer);
+	}
     }
-    if (value) {
-	fprintf(stderr, "value isn't a fixed unsigned\n");
+    // free bytes of other nodes than the current are fragmentation
+    for (node = pool->Pools; node; node = node->Next) {
+	printf("%p[%d/%d]%s", node, node->Free, node->Size,
+	    node == pool->Pools ? " current\n" : "\n");
     }
-    return 0;
 }
 
+#endif
+
+#ifdef USE_CORE_RC_STATISTICS
+
 /**
-**	Get config boolean object.
+**	Print memory usage of string-pool.
 **
-**	@param config		config dictionary
-**	@param ...		list of objects NULL terminated, to select value
+**	Free bytes of full nodes are wasted, as far as they are not in the
+**	tail lists they can't be reused.
 **
-**	@retval -1	if index didn't exists in dictionary.
-**	@retval	true	if value is not false.
-**	@retval	false	if value is 'false' or 0.
+**	@param pool	string-pool
+**	@param out	output stream
 */
-int ConfigGetBoolean(const ConfigObject * config, ...)
+static void StringPoolPrintStatistics(const StringPool * pool, FILE * out)
 {
-    va_list ap;
-    const ConfigObject *value;
-
-    va_start(ap, config);
-    value = ConfigLookup(config, ap);
-    va_end(ap);
-
-    if (ConfigIsFixed(value)) {
-	return ConfigInteger(value);
+    const StringNode *node;
+    StringTail entry;
+    const char *tail;
+    size_t nodes;
+    size_t bytes;
+    size_t wasted;
+    size_t reusable;
+    int class;
+
+    nodes = bytes = wasted = reusable = 0;
+    for (node = pool->Pools; node; node = node->Next) {
+	++nodes;
+	bytes += node->Size;
+	if (node != pool->Pools) {
+	    wasted += node->Free;
+	}
     }
-    if (value) {
-	fprintf(stderr, "value isn't a fixed integer\n");
+    for (class = 0; class < STRING_TAIL_CLASSES; ++class) {
+	for (tail = pool->Tails[class]; tail; tail = entry.Next) {
+	    memcpy(&entry, tail, sizeof(entry));
+	    reusable += entry.Size;
+	}
     }
-    return -1;
+    fprintf(out, "strings: %zu in %zu nodes with %zu bytes\n", pool->Used,
+	nodes, bytes);
+    fprintf(out, "strings: %zu bytes wasted (%zu per node), %zu reusable\n",
+	wasted, nodes ? wasted / nodes : 0, reusable);
 }
 
+#endif
+
 /**
-**	Get config double object.
+**	Create a new empty string-pool hash table.
 **
-**	@param config		config dictionary
-**	@param[out] result	double result
-**	@param ...		list of objects NULL terminated, to select value
+**	@param slots	number of slots (power of 2)
 **
-**	@returns true if value found at index in dictionary.
+**	@returns new empty hash table.
 */
-int ConfigGetDouble(const ConfigObject * config, double *result, ...)
+static inline StringTable *StringTableNew(size_t slots)
 {
-    va_list ap;
-    const ConfigObject *value;
+    StringTable *table;
 
-    va_start(ap, result);
-    value = ConfigLookup(config, ap);
-    va_end(ap);
+    table = calloc(1, sizeof(*table) + slots * sizeof(*table->Slots));
+    table->Mask = slots - 1;
 
-    if (ConfigIsFloat(value)) {
-	*result = ConfigDouble(value);
-	return 1;
-    }
-    if (value) {
-	fprintf(stderr, "value isn't a double\n");
-    }
-    return 0;
+    return table;
 }
 
 /**
-**	Get config string object.
-**
-**	@param config		config dictionary
-**	@param[out] result	string result
-**	@param ...		list of objects NULL terminated, to select value
+**	Delete string-pool hash table and the tables it replaced.
 **
-**	@returns true if value found at index in dictionary.
+**	@param table	hash table to be freed
 */
-int ConfigGetString(const ConfigObject * config, const char **result, ...)
+static void StringTableDel(StringTable * table)
 {
-    va_list ap;
-    const ConfigObject *value;
-
-    va_start(ap, result);
-    value = ConfigLookup(config, ap);
-    va_end(ap);
+    StringTable *old;
 
-    if (ConfigIsWord(value)) {
-	*result = ConfigString(value);
-	return 1;
+    while (table) {
+	old = table->Old;
+	free(table);
+	table = old;
     }
-    if (value) {
-	fprintf(stderr, "value isn't a string\n");
-    }
-    return 0;
 }
 
 /**
-**	Get config array object.
-**
-**	@param config		config dictionary
-**	@param[out] result	array result
-**	@param ...		list of objects NULL terminated, to select value
+**	Create a new empty string-pool.
 **
-**	@returns true if value found at index in dictionary.
+**	@returns new empty string pool.
 */
-int ConfigGetArray(const ConfigObject * config, const ConfigObject ** result,
-    ...)
+static inline StringPool *StringPoolNew(void)
 {
-    va_list ap;
-    const ConfigObject *value;
+    StringPool *pool;
 
-    va_start(ap, result);
-    value = ConfigLookup(config, ap);
-    va_end(ap);
+    pool = calloc(1, sizeof(StringPool));
+    pool->Table = StringTableNew(STRING_POOL_SLOTS);
 
-    if (ConfigIsArray(value)) {
-	*result = value;
-	return 1;
-    }
-    if (value) {
-	fprintf(stderr, "value isn't an array\n");
-    }
-    return 0;
+    return pool;
 }
 
 /**
-**	Get first value from config array.
+**	Delete a string-pool.
 **
-**	Search (inclusive) for the first index that is equal to or greater
-**	than index.
+**	All memory used by string-pool is freed.
 **
-**	@param array		config array value
-**	@param[in,out] index	config index value
+**	@param pool	string-pool to be freed.
 */
-const ConfigObject *ConfigArrayFirst(const ConfigObject * array,
-    const ConfigObject ** index)
+static void StringPoolDel(StringPool * pool)
 {
-    const ConfigObject **value;
+    StringNode *node;
 
-    value =
-	(const ConfigObject **)ArrayFirst(ConfigArray(array), (size_t *)index);
-    return value ? *value : NULL;
-}
+    StringTableDel(pool->Table);
 
-/**
-**	Get next value from config array.
-**
-**	Search (exclusive) for the next index that is greater than index.
-**
-**	@param array		config array value
-**	@param[in,out] index	config index value
-*/
-const ConfigObject *ConfigArrayNext(const ConfigObject * array,
-    const ConfigObject ** index)
-{
-    const ConfigObject **value;
+    while ((node = pool->Pools)) {	// free all nodes
+	pool->Pools = node->Next;
+	free(node);
+    }
+    ObjectPoolClear(&pool->Objects);
 
-    value =
-	(const ConfigObject **)ArrayNext(ConfigArray(array), (size_t *)index);
-    return value ? *value : NULL;
+    free(pool);
 }
 
 /**
-**	Get first value with integer key from config array.
+**	Find slot of string.
 **
-**	Search (inclusive) for the first index that is equal to or greater
-**	than index.
+**	The table is probed linear, stored hashes are compared before the
+**	strings.  A slot is filled by storing its hash before its object,
+**	the object is loaded first: a concurrent reader sees a slot empty
+**	or complete.
 **
-**	@param array		config array value
-**	@param[in,out] index	config index value
+**	@param table	hash table to search
+**	@param string	string to find
+**	@param len	length of string
+**	@param hash	hash of string
+**	@param[out] found	tagged string object, NULL if not found
+**
+**	@returns slot of string or empty slot for insert.
 */
-const ConfigObject *ConfigArrayFirstFixedKey(const ConfigObject * array,
-    const ConfigObject ** index)
+static inline StringSlot *StringTableFind(StringTable * table,
+    const char *string, size_t len, size_t hash, ConfigObject ** found)
 {
-    const ConfigObject **value;
+    StringSlot *slot;
+    ConfigObject *object;
+    const char *str;
+    size_t i;
 
-    value = (const ConfigObject **)
-	ArrayFirst(ConfigArray(array), (size_t *)index);
-    while (value) {
-	if (ConfigIsFixed(*index)) {
-	    return *value;
+    for (i = hash & table->Mask;; i = (i + 1) & table->Mask) {
+	slot = table->Slots + i;
+	if (!(object = __atomic_load_n(&slot->Object, __ATOMIC_ACQUIRE))) {
+	    *found = NULL;
+	    return slot;
+	}
+	if (slot->Hash == hash) {
+	    str = ((ConfigObject *) ((size_t)object & ~7))->Pointer;
+	    if (StringPoolHeader(str)->Length == len
+		&& !memcmp(str, string, len)) {
+		*found = object;
+		return slot;
+	    }
 	}
-	value = (const ConfigObject **)
-	    ArrayNext(ConfigArray(array), (size_t *)index);
     }
-    return (const ConfigObject *)value;
 }
 
 /**
-**	Get next value with integer key from config array.
+**	Find slot of string.
 **
-**	Search (exclusive) for the next index that is greater than index.
+**	@param pool	string-pool to search
+**	@param string	string to find
+**	@param len	length of string
+**	@param hash	hash of string
 **
-**	@param array		config array value
-**	@param[in,out] index	config index value
+**	@returns slot of string or empty slot for insert.
+**
+**	@note only the writer of the pool may use the slot
 */
-const ConfigObject *ConfigArrayNextFixedKey(const ConfigObject * array,
-    const ConfigObject ** index)
+static inline StringSlot *StringPoolFind(const StringPool * pool,
+    const char *string, size_t len, size_t hash)
 {
-    const ConfigObject **value;
-
-    do {
-	value = (const ConfigObject **)
-	    ArrayNext(ConfigArray(array), (size_t *)index);
-	if (!value) {
-	    return (const ConfigObject *)value;
-	}
-    } while (!ConfigIsFixed(*index));
+    ConfigObject *found;
 
-    return *value;
+    return StringTableFind(pool->Table, string, len, hash, &found);
 }
 
-#if defined(USE_CORE_RC_PRINT) || defined(USE_CORE_RC_WRITE)
-
 /**
-**	Print config object.
+**	Double the hash table of string-pool.
 **
-**	@param object	tagged object pointer
-**	@param level	indent level
-**	@param out	output stream
+**	The new table is filled before it is published.
 **
-**	@todo this is nice print, but no beautifier yet.
+**	@param pool	string-pool to grow
 */
-void ConfigPrint(const ConfigObject * object, int level, FILE * out)
+static void StringPoolGrow(StringPool * pool)
 {
-    if (!object) {
-	printf("nil");
-	return;
-    }
-    if (ConfigIsFixed(object)) {
-	fprintf(out, "%zd", ConfigInteger(object));
-    } else if (ConfigIsFloat(object)) {
-	fprintf(out, "%.1g", ConfigDouble(object));
-    } else if (ConfigIsWord(object)) {
-	fprintf(out, "\"%s\"", ConfigString(object));
-    } else {
-	size_t index;
-	size_t *value;
-	Array *array;
-
-	array = ConfigArray(object);
-	index = 0;
-	value = ArrayFirst(array, &index);
-	if (value) {
-	    fprintf(out, "[;%p\n", object);
-	    while (value) {
-		const ConfigObject *lvalue;
-
-		//
-		//	string
-		//
-		lvalue = (const ConfigObject *)index;
-		// FIXME: must check if word contains only a-zA-Z0-9_-
-		if (ConfigIsWord(lvalue)) {
-		    fprintf(out, "%*s%s = ", level, "", ConfigString(lvalue));
-		} else {
-		    fprintf(out, "%*s[", level, "");
-		    ConfigPrint(lvalue, level + 2, out);
-		    fprintf(out, "] = ");
-		}
-
-		ConfigPrint((const ConfigObject *)*value, level + 4, out);
-		fprintf(out, "\n");
-
-		value = ArrayNext(array, &index);
+    StringTable *table;
+    const StringTable *old;
+    size_t i;
+    size_t j;
+
+    old = pool->Table;
+    table = StringTableNew((old->Mask + 1) * 2);
+    for (i = 0; i <= old->Mask; ++i) {
+	if (old->Slots[i].Object) {
+	    for (j = old->Slots[i].Hash & table->Mask; table->Slots[j].Object;
+		j = (j + 1) & table->Mask) {
 	    }
-	    fprintf(out, "%*s]", level < 2 ? 0 : level - 2, "");
-	} else {			// empty array
-	    fprintf(out, "[];%p", object);
+	    table->Slots[j] = old->Slots[i];
 	}
     }
+    table->Old = pool->Table;
+    __atomic_store_n(&pool->Table, table, __ATOMIC_RELEASE);
 }
-#endif
-
-// ------------------------------------------------------------------------ //
-// Config file parser
-// ------------------------------------------------------------------------ //
-
-///
-///	@defgroup parse The parse module.
-///
-///	This module handles parsing of config file.
-///
-/// @{
-
-/**
-**	Parse open file stack typedef.
-*/
-typedef struct _parse_file_stack_ ParseFileStack;
-
-/**
-**	Parse open file stack structure.
-*/
-struct _parse_file_stack_
-{
-    const char *Name;			///< previous file name
-    FILE *File;				///< previous file stream
-    int LineNr;				///< previous line number
-};
-
-static const char *ParseName;		///< current file name
-static FILE *ParseFile;			///< current file stream
-static int ParseLineNr;			///< current line number
-
-//static ParseFileStack *ParseFiles;	///< pushed files
-//static int ParseFileN;			///< number of pushed files
-
-static ConfigObject **ParseStack;	///< parser stack
-static int ParseSP;			///< parser stack pointer
-static int ParseStackSize;		///< parser stack size
-
-static Array *ParseGlobalArray;		///< global array
-static Array *ParseCurrentArray;	///< current array
-static int ParseCurrentIndex;		///< current array index
-static Array **ParseCurrentLvalue;	///< current lvalue
-
-static void ParseRecursive(const char *);	///< parse recursive file
-
-#ifdef never_DEBUG_CORE_RC
 
 /**
-**	Print debug about object.
+**	Add string with known hash to hash table.
 **
-**	@param object	config object
+**	Other than StringPoolInsertHash(), short strings are added too.
+**
+**	@param pool	pool to add string
+**	@param string	string to add
+**	@param len	length of string
+**	@param hash	hash of string
+**	@param adopt	string object of other pool to use for new strings,
+**			NULL to allocate a new object
+**
+**	@returns tagged string object of pool.
 */
-static void ParseDebug(const ConfigObject * object)
+static ConfigObject *StringPoolAdd(StringPool * pool, const char *string,
+    size_t len, size_t hash, ConfigObject * adopt)
 {
-    if (!object) {
-	printf("nil");
-	return;
+    StringSlot *slot;
+    ConfigObject *object;
+
+    slot = StringPoolFind(pool, string, len, hash);
+    if (slot->Object) {
+	return slot->Object;
     }
-    if (ConfigIsFixed(object)) {
-	printf("fixed(%zd)", ConfigInteger(object));
-    } else if (ConfigIsFloat(object)) {
-	printf("float(%.1g)", ConfigDouble(object));
-    } else if (ConfigIsWord(object)) {
-	printf("word(%s)", ConfigString(object));
+    // keep load factor below 1/2
+    if ((pool->Used + 1) * 2 > pool->Table->Mask + 1) {
+	StringPoolGrow(pool);
+	slot = StringPoolFind(pool, string, len, hash);
+    }
+    if (adopt) {
+	object = adopt;
     } else {
-	printf("array(%p)", object);
+	object = ObjectPoolAlloc(&pool->Objects);
+	object->Pointer = (char *)StringPoolAlloc(pool, string, len, hash);
     }
+    object = (ConfigObject *) ((size_t)object | 4);
+    slot->Hash = hash;
+    // publish the string to readers without lock
+    __atomic_store_n(&slot->Object, object, __ATOMIC_RELEASE);
+    ++pool->Used;
+
+    return object;
 }
 
 /**
-**	Print a parser object
+**	Insert string with known hash.
 **
-**	@param object	config object
+**	@param pool	pool to add string
+**	@param string	string to add
+**	@param len	length of string
+**	@param hash	hash of string
+**	@param adopt	string object of other pool to use for new strings,
+**			NULL to allocate a new object
+**
+**	@returns tagged string object of pool.
 */
-static void ParsePrint(const ConfigObject * object)
+static inline ConfigObject *StringPoolInsertHash(StringPool * pool,
+    const char *string, size_t len, size_t hash, ConfigObject * adopt)
 {
-    if (!object) {
-	printf("nil");
-	return;
-    }
-    if (ConfigIsFixed(object)) {
-	printf("%zd", ConfigInteger(object));
-    } else if (ConfigIsFloat(object)) {
-	printf("%.1g", ConfigDouble(object));
-    } else if (ConfigIsWord(object)) {
-	printf("\"%s\"", ConfigString(object));
-    } else {
-	printf("[=%p]", object);
+#ifdef USE_CORE_RC_SHORT_STRING
+    ConfigObject *object;
+
+    if ((object = (ConfigObject *) StringShortNew(string, len))) {
+	return object;
     }
+#endif
+    return StringPoolAdd(pool, string, len, hash, adopt);
 }
 
+#ifdef USE_CORE_RC_SHORT_STRING
+
 /**
-**	Dump parsed config
+**	Spell short string in pool.
 **
-**	@param array	config main array
-**	@param level	indent level
+**	Only for the functions returning a const char pointer, which must
+**	be valid as long as the pool.  Each short string is spelled once,
+**	when it is asked for the first time, later StringPoolSpelled()
+**	finds it without lock.
 **
-**	@todo nil? detect recursive structures and cycles
+**	@param pool	string-pool to store the string
+**	@param value	tagged short string
+**
+**	@returns string in pool, with header like all pool strings.
 */
-static void ParseDump(const Array * array, int level)
+static const char *StringPoolSpell(StringPool * pool, size_t value)
 {
-    size_t index;
-    size_t *value;
-
-    index = 0;
-    value = ArrayFirst(array, &index);
-    while (value) {
-	const ConfigObject *object;
-
-	printf("%*s[", level, "");
-	ParsePrint((const ConfigObject *)index);
-	printf("] = ");
-	object = (const ConfigObject *)*value;
-	if (ConfigIsArray(object)) {
-	    printf("[\n");
-	    ParseDump(ConfigArray(object), level + 4);
-	    printf("%*s]\n", level, "");
-	} else {
-	    ParsePrint(object);
-	    printf("\n");
-	}
+    char buf[CONFIG_STRING_BUFFER];
+    ConfigObject *object;
+    size_t len;
 
-	value = ArrayNext(array, &index);
-    }
+    len = StringShortLength(value);
+    StringShortCopy(value, buf);
+    object = StringPoolAdd(pool, buf, len, StringHash(buf, len), NULL);
+    return ((const ConfigObject *)((size_t)object & ~7))->Pointer;
 }
-#endif
 
 /**
-**	Pop object from parser stack.
+**	Find spelled short string in pool.
 **
-**	@returns	top config object on parser stack
+**	@param pool	string-pool to search
+**	@param value	tagged short string
+**
+**	@returns string in pool, NULL if it isn't spelled.
+**
+**	@note needs no lock, see StringPoolLookupHash()
 */
-static ConfigObject *ParsePop(void)
+static const char *StringPoolSpelled(const StringPool * pool, size_t value)
 {
-    if (!ParseSP) {
-	fprintf(stderr, "internal error no objects on stack\n");
+    char buf[CONFIG_STRING_BUFFER];
+    ConfigObject *object;
+    size_t len;
+
+    len = StringShortLength(value);
+    StringShortCopy(value, buf);
+    StringTableFind(__atomic_load_n(&pool->Table, __ATOMIC_ACQUIRE), buf,
+	len, StringHash(buf, len), &object);
+    if (!object) {
 	return NULL;
     }
-    return ParseStack[--ParseSP];
+    return ((const ConfigObject *)((size_t)object & ~7))->Pointer;
 }
 
-/**
-**	Push object on parser stack.
-**
-**	@param object	config object
-*/
-static void ParsePush(const ConfigObject * object)
-{
-    if (ParseSP + 1 == ParseStackSize) {	// reach stack end
-	ParseStackSize += 8;
-	ParseStack =
-	    realloc(ParseStack, ParseStackSize * sizeof(ConfigObject *));
-    }
-    ParseStack[ParseSP++] = (ConfigObject *) object;
-}
+#endif
 
 /**
-**	Push integer.
+**	Intern string.
 **
-**	@param val	push val as integer object on value stack
-*/
-static void ParsePushI(int val)
-{
-    ParsePush(ConfigNewInteger(val));
-}
-
-/**
-**	Push double float.
+**	@param pool	pool to add string
+**	@param string	string to add
 **
-**	@param val	push val as floating point object on value stack
+**	@returns tagged string object of pool.
 */
-static void ParsePushF(double val)
+static inline ConfigObject *StringPoolIntern(StringPool * pool,
+    const char *string)
 {
-    ParsePush(ConfigNewDouble(val));
+    size_t len;
+
+    len = strlen(string);
+    return StringPoolInsertHash(pool, string, len, StringHash(string, len),
+	NULL);
 }
 
 /**
-**	Push string.
+**	Lookup string with known hash without inserting it.
 **
-**	@param val	push val as string object on value stack
+**	@param pool	pool to search
+**	@param string	string to find
+**	@param len	length of string
+**	@param hash	hash of string
+**
+**	@returns tagged string object of pool, NULL if string isn't in pool.
+**
+**	@note needs no lock, the pool can be searched while it is written
 */
-static void ParsePushS(const char *val)
+static inline ConfigObject *StringPoolLookupHash(const StringPool * pool,
+    const char *string, size_t len, size_t hash)
 {
-    ParsePush(ConfigNewString(val));
+    ConfigObject *object;
+
+#ifdef USE_CORE_RC_SHORT_STRING
+    if ((object = (ConfigObject *) StringShortNew(string, len))) {
+	return object;
+    }
+#endif
+    StringTableFind(__atomic_load_n(&pool->Table, __ATOMIC_ACQUIRE), string,
+	len, hash, &object);
+    return object;
 }
 
 /**
-**	Push array.
+**	Lookup string without inserting it.
+**
+**	@param pool	pool to search
+**	@param string	string to find
 **
-**	@param val	push val as array object on value stack
+**	@returns tagged string object of pool, NULL if string isn't in pool.
 */
-static void ParsePushA(const Array * val)
+static inline ConfigObject *StringPoolLookup(const StringPool * pool,
+    const char *string)
 {
-    ParsePush(ConfigNewArray(val));
+    size_t len;
+
+    len = strlen(string);
+    return StringPoolLookupHash(pool, string, len, StringHash(string, len));
 }
 
 /**
-**	Push nil.
+**	Merge a string-pool into another.
+**
+**	Strings not yet in @a dst are moved together with their objects.
+**	The objects of strings already in @a dst must be replaced by the
+**	returned mapping.  The pool @a src is freed.
+**
+**	@param dst	string-pool receiving the strings
+**	@param src	string-pool to merge (freed)
+**
+**	@returns array mapping tagged objects of @a src to objects of @a dst.
 */
-static void ParsePushNil(void)
+static Array *StringPoolMerge(StringPool * dst, StringPool * src)
 {
-    ParsePush(NULL);
-}
+    Array *remap;
+    StringNode *node;
+    StringTail entry;
+    char *tail;
+    size_t i;
+    int class;
+
+    remap = ArrayNew();
+    // stored hashes are reused
+    for (i = 0; i <= src->Table->Mask; ++i) {
+	const StringSlot *slot;
+	ConfigObject *found;
+
+	slot = src->Table->Slots + i;
+	if (slot->Object) {
+	    ConfigObject *object;
+
+	    object = (ConfigObject *) ((size_t)slot->Object & ~7);
+	    found = StringPoolAdd(dst, object->Pointer,
+		StringPoolHeader(object->Pointer)->Length, slot->Hash, object);
+	    if (found != slot->Object) {
+		ArrayIns(&remap, (size_t)slot->Object, (size_t)found);
+	    }
+	}
+    }
+    StringTableDel(src->Table);
+
+    // memory of all strings is moved, replaced strings are wasted
+    if ((node = src->Pools)) {
+	for (class = 0; class < STRING_TAIL_CLASSES; ++class) {
+	    while ((tail = src->Tails[class])) {
+		memcpy(&entry, tail, sizeof(entry));
+		src->Tails[class] = entry.Next;
+		StringPoolAddTail(dst, entry.Node, tail, entry.Size);
+	    }
+	}
+	if (dst->Pools && node->Free) {	// current node of src is full
+	    StringPoolAddTail(dst, node, node->Data + node->Size - node->Free,
+		node->Free);
+	}
+	while (node->Next) {
+	    node = node->Next;
+	}
+	if (dst->Pools) {		// keep current node of dst first
+	    node->Next = dst->Pools->Next;
+	    dst->Pools->Next = src->Pools;
+	} else {
+	    dst->Pools = src->Pools;
+	}
+    }
+    ObjectPoolMerge(&dst->Objects, &src->Objects);
+
+    free(src);
+
+    return remap;
+}
+
+#ifdef CORE_RC_TEST
+
+///
+///	The old string lookup: a tree of arrays, one level for each 8 bytes
+///	of the string.	It is only kept for the interning benchmark.
+///
+
+/**
+**	Generate key for string trie.
+**
+**	@param len	length of key string
+**	@param str	string for key
+**
+**	@returns a 32bit/64bit key for first part of string.
+*/
+static inline size_t StringTrieKeygen(int len, const uint8_t * str)
+{
+    size_t key;
+
+    key = 0;
+    // 8/4 bytes -> index-key
+    switch (len) {
+	default:
+#if SIZE_MAX == (18446744073709551615UL)
+	    // 64 bit version
+	case 8:
+	    key |= str[7] << 0;
+	    // fallthrough
+	case 7:
+	    key |= str[6] << 8;
+	    // fallthrough
+	case 6:
+	    key |= str[5] << 16;
+	    // fallthrough
+	case 5:
+	    key |= str[4] << 24;
+	    // fallthrough
+	case 4:
+	    key |= (size_t)str[3] << 32;
+	    // fallthrough
+	case 3:
+	    key |= (size_t)str[2] << 40;
+	    // fallthrough
+	case 2:
+	    key |= (size_t)str[1] << 48;
+	    // fallthrough
+	case 1:
+	    key |= (size_t)str[0] << 56;
+	    break;
+#else
+	    // 32 bit version
+	case 4:
+	    key |= str[3] << 0;
+	    // fallthrough
+	case 3:
+	    key |= str[2] << 8;
+	    // fallthrough
+	case 2:
+	    key |= str[1] << 16;
+	    // fallthrough
+	case 1:
+	    key |= str[0] << 24;
+	    break;
+#endif
+	case 0:
+	    break;
+    }
+
+    return key;
+}
+
+/**
+**	Free memory used by string trie.
+**
+**	@param array	string trie
+*/
+static void StringTrieDel(Array * array)
+{
+    size_t index;
+    size_t *value;
+
+    index = 0;
+    value = ArrayFirst(array, &index);
+    while (value) {
+	if (!(*value & 4)) {		// strings are tagged
+	    StringTrieDel((Array *) * value);
+	}
+	value = ArrayNext(array, &index);
+    }
+    ArrayFree(array);
+}
+
+/**
+**	Intern string with string trie.
+**
+**	@param pool	pool for string memory and objects
+**	@param root	string trie
+**	@param string	string to add
+**
+**	@returns tagged string object of pool.
+*/
+static ConfigObject *StringTrieIntern(StringPool * pool, Array ** root,
+    const char *string)
+{
+    int len;
+    size_t key;
+    Array **parent;
+    size_t *val;
+    const char *str;
+    ConfigObject *object;
+
+    object = NULL;
+    str = string;
+    len = strlen(str);
+    parent = root;
+    do {
+	key = StringTrieKeygen(len, (uint8_t *) str);
+	val = ArrayIns(parent, key, 0);
+	if (!*val) {			// new key insert string and ready
+	    string = StringPoolAlloc(pool, string, strlen(string), 0);
+	    object = ObjectPoolAlloc(&pool->Objects);
+	    object->Pointer = (char *)string;
+	    *val = (size_t)object | 4;
+	    object = (ConfigObject *) * val;
+	    break;
+	}
+
+	str += sizeof(size_t);
+	len -= sizeof(size_t);
+
+	// *val is string or array
+	if (*val & 4) {			// |4 are string objects
+	    const char *old;
+	    int i;
+
+	    object = (ConfigObject *) * val;
+	    old = ((ConfigObject *) ((size_t)object & ~7))->Pointer;
+
+	    i = strlen(old) - (str - string);
+	    // compare string, if not same
+	    if (i == len && (len < 0 || !strcmp(str, old + (str - string)))) {
+		break;
+	    }
+	    // take next 4/8 bytes as next key
+	    key = StringTrieKeygen(i, (uint8_t *) old + (str - string));
+	    *val = (size_t)ArrayNew();
+	    ArrayIns((Array **) val, key, (size_t)object);
+	}
+	parent = (Array **) val;
+
+    } while (len >= 0);
+
+    return object;
+}
+
+#endif
+
+/// @}
+
+// ----------------------------------------------------------------------------
+
+static StringPool *ConfigStrings;	///< storage of parser strings
+static int ConfigStringsRefs;		///< configs using the string pool
+
+    /// lock for merging parser strings into global string pool
+static pthread_mutex_t ConfigStringsLock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+**	Get reference to global string pool.
+**
+**	@note the caller must hold #ConfigStringsLock
+*/
+static void ConfigStringsRef(void)
+{
+    if (!ConfigStrings) {
+	ConfigStrings = StringPoolNew();
+#ifdef DEBUG_CORE_RC
+	fprintf(stderr, "new string pool\n");
+#endif
+    }
+    ++ConfigStringsRefs;
+}
+
+/**
+**	Release reference to global string pool.
+**
+**	The pool is freed with the last config.
+*/
+static void ConfigStringsUnref(void)
+{
+    pthread_mutex_lock(&ConfigStringsLock);
+    if (!--ConfigStringsRefs) {
+	StringPoolDel(ConfigStrings);
+	ConfigStrings = NULL;
+    }
+    pthread_mutex_unlock(&ConfigStringsLock);
+}
+
+/**
+**	Check if object is fixed integer.
+**
+**	@param object	tagged object pointer
+**
+**	@returns true if object is fixed integer object, false otherwise.
+*/
+static inline int ConfigIsFixed(const ConfigObject * object)
+{
+#ifdef USE_CORE_RC_NAN_BOX
+    return (size_t)object >= CONFIG_NAN_BOX_INTEGER;
+#else
+    return (size_t)object & 1;
+#endif
+}
+
+/**
+**	Check if object is floating-point number.
+**
+**	@param object	tagged object pointer
+*/
+static inline int ConfigIsFloat(const ConfigObject * object)
+{
+#if defined(USE_CORE_RC_NAN_BOX) && defined(USE_CORE_RC_SHORT_STRING)
+    return (size_t)object >= CONFIG_NAN_BOX_DOUBLE
+	&& (size_t)object < CONFIG_NAN_BOX_STRING;
+#elif defined(USE_CORE_RC_NAN_BOX)
+    return (size_t)object >= CONFIG_NAN_BOX_DOUBLE
+	&& (size_t)object < CONFIG_NAN_BOX_INTEGER;
+#elif defined(USE_CORE_RC_SHORT_STRING)
+    return ((size_t)object & 7) == 2;
+#else
+    return !ConfigIsFixed(object) && (size_t)object & 2;
+#endif
+}
+
+/**
+**	Check if object is a word or array object.
+**
+**	@param object	tagged object pointer
+**
+**	@returns true if object is a pointer, false for nil and numbers.
+*/
+static inline int ConfigIsObject(const ConfigObject * object)
+{
+#ifdef USE_CORE_RC_NAN_BOX
+    return object && (size_t)object < CONFIG_NAN_BOX_DOUBLE;
+#else
+    return object && !((size_t)object & 3);
+#endif
+}
+
+#if 0
+
+/**
+**	Check if object is a pointer object.
+**
+**	@param object	tagged object pointer
+*/
+static inline int ConfigIsPointer(const ConfigObject * object)
+{
+    return object && !((size_t)object & 7);
+}
+
+#endif
+
+/**
+**	Check if object is a word object.
+**
+**	@param object	tagged object pointer
+**
+**	@returns true for string objects and short strings.
+*/
+static inline int ConfigIsWord(const ConfigObject * object)
+{
+#if defined(USE_CORE_RC_NAN_BOX) && defined(USE_CORE_RC_SHORT_STRING)
+    return ((size_t)object < CONFIG_NAN_BOX_DOUBLE
+	&& ((size_t)object & 7) == 4) || StringIsShort((size_t)object);
+#elif defined(USE_CORE_RC_NAN_BOX)
+    return (size_t)object < CONFIG_NAN_BOX_DOUBLE
+	&& ((size_t)object & 7) == 4;
+#elif defined(USE_CORE_RC_SHORT_STRING)
+    return ((size_t)object & 5) == 4;	// 100 string, 110 short string
+#else
+    return (((size_t)object & 7) == 4);
+#endif
+}
+
+/**
+**	Check if object is an array object.
+**
+**	@param object	tagged object pointer
+*/
+static inline int ConfigIsArray(const ConfigObject * object)
+{
+#ifdef USE_CORE_RC_NAN_BOX
+    return object && (size_t)object < CONFIG_NAN_BOX_DOUBLE
+	&& !((size_t)object & 7);
+#else
+    return object && !((size_t)object & 7);
+#endif
+}
+
+#if 0
+
+/**
+**	Create a new fixed integer object.
+**
+**	@param integer	31/63 bit used unsigned integer
+**
+**	@returns tagged fixed integer object pointer.
+*/
+static inline ConfigObject *ConfigNewInteger(size_t integer)
+{
+    return (ConfigObject *) ((integer << 1) + 1);
+}
+#endif
+
+/**
+**	Create a new floating-point number object.
+**
+**	@param number	30/62 bit used floating-point number, 29/61 bit
+**			with short strings, all bits NaN-boxed
+**
+**	@returns tagged floating point object pointer.
+*/
+inline ConfigObject *ConfigNewDouble(double number)
+{
+    union
+    {
+#if SIZE_MAX == (18446744073709551615UL)
+	double f;
+#else
+	float f;
+#endif
+	size_t i;
+    } c;
+
+    c.f = number;
+#ifdef USE_CORE_RC_NAN_BOX
+    if (number != number) {		// other NaNs overlap the integers
+	c.i = 0x7FF8000000000000UL;
+    }
+    return (ConfigObject *) (c.i + CONFIG_NAN_BOX_DOUBLE);
+#elif defined(USE_CORE_RC_SHORT_STRING)
+    return (ConfigObject *) ((c.i & ~7) | 2);
+#else
+    return (ConfigObject *) ((c.i & ~3) | 2);
+#endif
+}
+
+/**
+**	Create a new array object.
+**
+**	The array object belongs to nobody, until it is stored into a
+**	config with ConfigDefine().
+**
+**	@param array	core array converted into array object
+**
+**	@returns tagged array object pointer.
+*/
+inline ConfigObject *ConfigNewArray(const Array * array)
+{
+    ConfigObject *object;
+
+    object = ConfigObjectNew();
+    object->Pointer = (void *)array;
+
+    return object;
+}
+
+    /// last generation given to a config
+static size_t ConfigGenerations;
+
+/**
+**	Get a new config generation.
+**
+**	@returns unique generation, never 0.
+*/
+static inline size_t ConfigNextGeneration(void)
+{
+    return __atomic_add_fetch(&ConfigGenerations, 1, __ATOMIC_RELAXED);
+}
+
+/**
+**	Create a new config object.
+**
+**	@param array	core array converted into config object
+**
+**	@returns tagged array object pointer.
+*/
+inline Config *ConfigNewConfig(const Array * array)
+{
+    Config *config;
+
+    pthread_mutex_lock(&ConfigStringsLock);
+    ConfigStringsRef();
+    pthread_mutex_unlock(&ConfigStringsLock);
+
+    config = malloc(sizeof(*config));
+    config->Pointer = (void *)array;
+    config->Arena = ArenaNew();
+    config->Generation = ConfigNextGeneration();
+
+    return config;
+}
+
+/**
+**	Create a new string object.
+**
+**	@param string	string converted into fixed string object
+**
+**	@returns tagged fixed string object pointer.
+**
+**	@todo second array string -> object unnecessary
+*/
+inline ConfigObject *ConfigNewString(const char *string)
+{
+    ConfigObject *object;
+
+    if (!string) {
+	fprintf(stderr, "core-rc: null string\n");
+	string = "";
+    }
+    pthread_mutex_lock(&ConfigStringsLock);
+    object = StringPoolIntern(ConfigStrings, string);
+    pthread_mutex_unlock(&ConfigStringsLock);
+
+    return object;
+}
+
+/**
+**	Find the string objects of a string table.
+**
+**	The strings are only searched in the string pool, not interned.
+**	A string not in the pool gets the table entry self as probe object,
+**	its first member is the string pointer.	 The probe finds only keys
+**	of the frozen arrays of mapped configs, the entry must live as long
+**	as the object is used.
+**
+**	@param table	strings to find, terminated by a NULL string
+**
+**	@returns number of strings found in the pool.
+*/
+int ConfigFindStrings(ConfigInternObject * table)
+{
+    int found;
+
+    found = 0;
+    pthread_mutex_lock(&ConfigStringsLock);
+    for (; table->String; ++table) {
+	if (ConfigStrings
+	    && (table->Object = StringPoolLookup(ConfigStrings,
+		    table->String))) {
+	    ++found;
+	    continue;
+	}
+	table->Object = (ConfigObject *) ((size_t)table | 4);
+    }
+    pthread_mutex_unlock(&ConfigStringsLock);
+
+    return found;
+}
+
+/**
+**	Convert (unchecked) fixed object to C integer.
+**
+**	@param object	tagged object pointer
+**
+**	@returns fixed integer part of object pointer.
+*/
+static inline ssize_t ConfigInteger(const ConfigObject * object)
+{
+#ifdef USE_CORE_RC_NAN_BOX
+    return (ssize_t) ((size_t)object << 15) >> 15;
+#else
+    return (ssize_t) object >> 1;
+#endif
+}
+
+/**
+**	Convert (unchecked) fixed object to C unsigned integer.
+**
+**	@param object	tagged object pointer
+**
+**	@returns fixed unsigned integer part of object pointer.
+*/
+static inline size_t ConfigUnsigned(const ConfigObject * object)
+{
+#ifdef USE_CORE_RC_NAN_BOX
+    return (size_t)object & (CONFIG_NAN_BOX_DOUBLE - 1);
+#else
+    return (size_t)object >> 1;
+#endif
+}
+
+/**
+**	Convert (unchecked) float object to C double.
+*
+**	@param object	tagged object pointer
+**
+**	@returns floating point part of object pointer.
+*/
+static inline double ConfigDouble(const ConfigObject * object)
+{
+    union
+    {
+#if SIZE_MAX == (18446744073709551615UL)
+	double f;
+#else
+	float f;
+#endif
+	size_t i;
+    } c;
+
+#ifdef USE_CORE_RC_NAN_BOX
+    c.i = (size_t)object - CONFIG_NAN_BOX_DOUBLE;
+#else
+    c.i = (size_t)object & ~2;
+#endif
+    return c.f;
+}
+
+/**
+**	Convert (unchecked) word object to C string.
+**
+**	@param object	tagged object pointer
+**	@param buf	buffer of #CONFIG_STRING_BUFFER bytes for short strings
+**
+**	@returns pointer to fixed word string, stored in object or @a buf.
+*/
+static inline const char *ConfigString(const ConfigObject * object,
+    char *buf)
+{
+#ifdef USE_CORE_RC_SHORT_STRING
+    if (StringIsShort((size_t)object)) {
+	return StringShortCopy((size_t)object, buf);
+    }
+#else
+    (void)buf;
+#endif
+    object = (const ConfigObject *)((size_t)object & ~7);
+    return object->Pointer;
+}
+
+/**
+**	Convert (unchecked) word object to stable C string.
+**
+**	Short strings are spelled in the global string pool, when they are
+**	asked for the first time.  Once spelled, they are found without
+**	lock.
+**
+**	@param object	tagged object pointer
+**
+**	@returns pointer to fixed word string, valid as long as the config.
+**	Without string pool a short string is copied into a buffer of the
+**	thread, valid until the next call.
+*/
+static const char *ConfigWord(const ConfigObject * object)
+{
+#ifdef USE_CORE_RC_SHORT_STRING
+    static __thread char buf[CONFIG_STRING_BUFFER];
+    const char *string;
+
+    if (StringIsShort((size_t)object)) {
+	if (ConfigStrings
+	    && (string = StringPoolSpelled(ConfigStrings, (size_t)object))) {
+	    return string;
+	}
+	string = NULL;
+	pthread_mutex_lock(&ConfigStringsLock);
+	if (ConfigStrings) {
+	    string = StringPoolSpell(ConfigStrings, (size_t)object);
+	}
+	pthread_mutex_unlock(&ConfigStringsLock);
+	if (!string) {
+	    string = StringShortCopy((size_t)object, buf);
+	}
+	return string;
+    }
+#endif
+    return ConfigString(object, NULL);
+}
+
+/**
+**	Compare (unchecked) word objects by their strings.
+**
+**	@param a	first tagged word object
+**	@param b	second tagged word object
+**
+**	@returns <0, 0, >0 like strcmp.
+*/
+static int ConfigWordCompare(const ConfigObject * a, const ConfigObject * b)
+{
+    char buf[2][CONFIG_STRING_BUFFER];
+
+#ifdef USE_CORE_RC_SHORT_STRING
+    if (StringIsShort((size_t)a) && StringIsShort((size_t)b)) {
+	return StringShortBytes((size_t)a) < StringShortBytes((size_t)b)
+	    ? -1 : StringShortBytes((size_t)a) > StringShortBytes((size_t)b);
+    }
+#endif
+    return strcmp(ConfigString(a, buf[0]), ConfigString(b, buf[1]));
+}
+
+/**
+**	Convert (unchecked) array object to C array.
+**
+**	@param object	tagged object pointer
+*
+**	@returns pointer to array, stored in object.
+*/
+static inline Array *ConfigArray(const ConfigObject * object)
+{
+    return object->Pointer;
+}
+
+// ------------------------------------------------------------------------ //
+// Array kinds
+// ------------------------------------------------------------------------ //
+
+///
+///	@defgroup arraykind The array kind module.
+///
+///	The pointer stored in an array object is tagged with the kind of
+///	the array.  The get functions handle all kinds, ConfigDefine()
+///	modifies only core arrays.
+///
+///	- #CONFIG_ARRAY_CORE
+///	core-array, keys are ordered by their object pointer.
+///
+///	- #CONFIG_ARRAY_FROZEN
+///	sorted read-only vector of key/value pairs, used by mapped binary
+///	snapshots.  The keys are ordered by arrays, numbers and then words
+///	by their content, to be independent of the address of the strings.
+///	Key 0 is the first key of all kinds.
+///
+///	- #CONFIG_ARRAY_VECTOR
+///	plain vector of values, the keys are the integers 0 .. n-1.  The
+///	parser stores each finished array constructor with such keys as
+///	vector.  An lvalue with another key promotes it to a core array or
+///	a parts array.
+///
+///	- #CONFIG_ARRAY_PARTS
+///	two core arrays, one with the integer keys and one with all other
+///	keys.  The parser stores each finished array constructor with
+///	mixed keys as parts, the FixedKey and StringKey iterators walk only
+///	their own partition.
+///
+///	- #CONFIG_ARRAY_HAMT
+///	persistent hash array mapped trie, used by ConfigSnapshot() and
+///	ConfigUpdate().  The keys are ordered by a hash of the key, the
+///	nodes are immutable and shared by all versions containing them.
+///
+/// @{
+
+#define CONFIG_ARRAY_CORE	0	///< array kind core-array
+#define CONFIG_ARRAY_FROZEN	1	///< array kind frozen vector
+#define CONFIG_ARRAY_VECTOR	2	///< array kind dense vector
+#define CONFIG_ARRAY_PARTS	3	///< array kind key partitions
+#define CONFIG_ARRAY_HAMT	4	///< array kind persistent trie
+
+/**
+**	Get kind of array object.
+**
+**	@param object	array object
+*/
+static inline int ConfigArrayKind(const ConfigObject * object)
+{
+    return (size_t)object->Pointer & 7;
+}
+
+/**
+**	Frozen array item.
+*/
+typedef struct _frozen_item_
+{
+    size_t Key;				///< tagged index object
+    size_t Value;			///< tagged value object
+} FrozenItem;
+
+/**
+**	Frozen array.
+*/
+typedef struct _frozen_array_
+{
+    size_t N;				///< number of items
+    FrozenItem Items[];			///< items sorted by key
+} FrozenArray;
+
+/**
+**	Get frozen array of array object.
+**
+**	@param object	array object of kind #CONFIG_ARRAY_FROZEN
+*/
+static inline const FrozenArray *ConfigFrozen(const ConfigObject * object)
+{
+    return (const FrozenArray *)((size_t)object->Pointer & ~7);
+}
+
+/**
+**	Vector array.
+*/
+typedef struct _vector_array_
+{
+    size_t N;				///< number of values
+    size_t Values[];			///< tagged values of keys 0 .. N-1
+} VectorArray;
+
+/**
+**	Get vector array of array object.
+**
+**	@param object	array object of kind #CONFIG_ARRAY_VECTOR
+*/
+static inline const VectorArray *ConfigVector(const ConfigObject * object)
+{
+    return (const VectorArray *)((size_t)object->Pointer & ~7);
+}
+
+/**
+**	Get position of first integer key of vector array, which is equal
+**	to or greater than index.
+**
+**	@param index	tagged key
+**
+**	@returns position, can be beyond the vector.
+*/
+static inline size_t VectorPosition(size_t index)
+{
+#ifdef USE_CORE_RC_NAN_BOX
+    if (index <= (size_t)ConfigNewInteger(0)) {
+	return 0;
+    }
+    return index - (size_t)ConfigNewInteger(0);
+#else
+    return index / 2;			// key i is stored as 2 * i + 1
+#endif
+}
+
+/**
+**	Parts array.
+*/
+typedef struct _parts_array_
+{
+    Array *Fixed;			///< core array of integer keys
+    Array *Named;			///< core array of all other keys
+} PartsArray;
+
+/**
+**	Get parts array of array object.
+**
+**	@param object	array object of kind #CONFIG_ARRAY_PARTS
+*/
+static inline const PartsArray *ConfigParts(const ConfigObject * object)
+{
+    return (const PartsArray *)((size_t)object->Pointer & ~7);
+}
+
+/**
+**	Get order class of frozen array key.
+**
+**	@param key	tagged key
+**
+**	@returns 0 arrays, 1 numbers, 2 words.
+*/
+static inline int FrozenClass(size_t key)
+{
+    const ConfigObject *object;
+
+    object = (const ConfigObject *)key;
+    if (ConfigIsWord(object)) {
+	return 2;
+    }
+    return ConfigIsFixed(object) || ConfigIsFloat(object);
+}
+
+/**
+**	Compare two keys of frozen array.
+**
+**	@param a	first tagged key
+**	@param b	second tagged key
+**
+**	@returns <0, 0, >0 like strcmp.
+*/
+static int FrozenCompare(size_t a, size_t b)
+{
+    int ca;
+    int cb;
+
+    ca = FrozenClass(a);
+    cb = FrozenClass(b);
+    if (ca != cb) {
+	return ca - cb;
+    }
+    if (ca == 2) {
+	return a == b ? 0 : ConfigWordCompare((const ConfigObject *)a,
+	    (const ConfigObject *)b);
+    }
+    return a < b ? -1 : a > b;
+}
+
+/**
+**	Find first item with key equal or greater than index.
+**
+**	@param array	frozen array
+**	@param index	tagged key
+**
+**	@returns index of item, N if none.
+*/
+static size_t FrozenSearch(const FrozenArray * array, size_t index)
+{
+    size_t lo;
+    size_t hi;
+
+    lo = 0;
+    hi = array->N;
+    while (lo < hi) {
+	size_t mid;
+
+	mid = (lo + hi) / 2;
+	if (FrozenCompare(array->Items[mid].Key, index) < 0) {
+	    lo = mid + 1;
+	} else {
+	    hi = mid;
+	}
+    }
+    return lo;
+}
+
+/**
+**	Find first item with key of order class or greater.
+**
+**	@param array	frozen array
+**	@param class	order class of FrozenClass()
+**
+**	@returns index of item, N if none.
+*/
+static size_t FrozenSearchClass(const FrozenArray * array, int class)
+{
+    size_t lo;
+    size_t hi;
+
+    lo = 0;
+    hi = array->N;
+    while (lo < hi) {
+	size_t mid;
+
+	mid = (lo + hi) / 2;
+	if (FrozenClass(array->Items[mid].Key) < class) {
+	    lo = mid + 1;
+	} else {
+	    hi = mid;
+	}
+    }
+    return lo;
+}
+
+/**
+**	Search both partitions of parts array.
+**
+**	@param parts		parts array
+**	@param[in,out] index	tagged key
+**	@param next		true search exclusive, false inclusive
+**
+**	@returns pointer to value with the smaller key, NULL if none.
+*/
+static const size_t *PartsSeek(const PartsArray * parts, size_t * index,
+    int next)
+{
+    const size_t *value[2];
+    size_t key[2];
+    int i;
+
+    key[0] = *index;
+    key[1] = *index;
+    if (next) {
+	value[0] = ArrayNext(parts->Fixed, &key[0]);
+	value[1] = ArrayNext(parts->Named, &key[1]);
+    } else {
+	value[0] = ArrayFirst(parts->Fixed, &key[0]);
+	value[1] = ArrayFirst(parts->Named, &key[1]);
+    }
+    i = !value[0] || (value[1] && key[1] < key[0]);
+    if (value[i]) {
+	*index = key[i];
+    }
+    return value[i];
+}
+
+#ifdef USE_CORE_RC_PERSISTENT
+
+#define HAMT_BITS	5		///< hash bits used by each trie level
+#define HAMT_HASH_BITS	(sizeof(size_t) * 8)	///< bits of key hash
+
+/**
+**	Persistent array slot.
+*/
+typedef struct _hamt_slot_
+{
+    size_t Key;				///< tagged key, 0 child node
+    size_t Value;			///< tagged value or child node
+} HamtSlot;
+
+/**
+**	Persistent array node.
+**
+**	Nodes are never modified after they are built.  Each node is also
+**	the array object of its subtree, the values of the arrays stored
+**	in a persistent array are their root nodes.
+*/
+typedef struct _hamt_node_
+{
+    void *Pointer;			///< tagged self pointer of array object
+    size_t Refs;			///< parents and configs sharing node
+    size_t N;				///< number of keys in subtree
+    uint32_t Bitmap;			///< used slots of the 32 hash slots
+    HamtSlot Slots[];			///< used slots ordered by hash
+} HamtNode;
+
+/**
+**	Get root node of array object.
+**
+**	@param object	array object of kind #CONFIG_ARRAY_HAMT
+*/
+static inline HamtNode *ConfigHamt(const ConfigObject * object)
+{
+    return (HamtNode *) ((size_t)object->Pointer & ~7);
+}
+
+/**
+**	Hash key of persistent array.
+**
+**	The mixer is a bijection, different keys have different hashes
+**	and the trie needs no collision lists.
+**
+**	@param key	tagged key
+*/
+static inline size_t HamtHash(size_t key)
+{
+#if __SIZEOF_POINTER__ == 8
+    key ^= key >> 32;
+    key *= 0xD6E8FEB86659FD93ULL;
+    key ^= key >> 32;
+#else
+    key ^= key >> 16;
+    key *= 0x045D9F3BU;
+    key ^= key >> 16;
+#endif
+    return key;
+}
+
+/**
+**	Get hash slot of level.
+**
+**	The most significant bits select the slots of the first level, so
+**	the slots of all levels are in hash order.
+**
+**	@param hash	hash of key
+**	@param level	trie level, 0 is the root
+*/
+static inline unsigned HamtIndex(size_t hash, int level)
+{
+    int shift;
+
+    shift = HAMT_HASH_BITS - HAMT_BITS * (level + 1);
+    return (shift >= 0 ? hash >> shift : hash << -shift) & 31;
+}
+
+/**
+**	Get position of hash slot in the used slots of node.
+**
+**	@param bitmap	used slots of node
+**	@param index	hash slot
+*/
+static inline int HamtPosition(uint32_t bitmap, unsigned index)
+{
+    return __builtin_popcount(bitmap & ((1U << index) - 1));
+}
+
+/**
+**	Allocate persistent array node.
+**
+**	@param n	number of used slots
+**
+**	@returns node with one reference, slots are uninitialized.
+*/
+static HamtNode *HamtAlloc(int n)
+{
+    HamtNode *node;
+
+#ifdef USE_CORE_RC_STATISTICS
+    ++ObjectPoolStat.Nodes;
+#endif
+    node = malloc(sizeof(*node) + n * sizeof(*node->Slots));
+    node->Pointer = (void *)((size_t)node | CONFIG_ARRAY_HAMT);
+    node->Refs = 1;
+    node->N = 0;
+    node->Bitmap = 0;
+
+    return node;
+}
+
+/**
+**	Get another reference of persistent array node.
+**
+**	@param node	node to share
+**
+**	@returns @a node.
+*/
+static inline HamtNode *HamtShare(const HamtNode * node)
+{
+    __atomic_add_fetch(&((HamtNode *) node)->Refs, 1, __ATOMIC_RELAXED);
+    return (HamtNode *) node;
+}
+
+/**
+**	Get reference of tagged key or value.
+**
+**	The arrays stored in persistent arrays are persistent arrays.
+**
+**	@param value	tagged key or value
+*/
+static inline void HamtShareValue(size_t value)
+{
+    if (ConfigIsArray((const ConfigObject *)value)) {
+	HamtShare(ConfigHamt((const ConfigObject *)value));
+    }
+}
+
+/**
+**	Get references of slot.
+**
+**	@param slot	leaf or child slot
+*/
+static inline void HamtShareSlot(const HamtSlot * slot)
+{
+    if (slot->Key) {
+	HamtShareValue(slot->Key);
+	HamtShareValue(slot->Value);
+    } else {
+	HamtShare((const HamtNode *)slot->Value);
+    }
+}
+
+static inline void HamtReleaseValue(size_t);
+
+/**
+**	Release reference of persistent array node.
+**
+**	The node is freed with its last reference, its children, keys and
+**	values are released.
+**
+**	@param node	node to release
+*/
+static void HamtRelease(HamtNode * node)
+{
+    int i;
+    int n;
+
+    if (__atomic_sub_fetch(&node->Refs, 1, __ATOMIC_ACQ_REL)) {
+	return;
+    }
+    n = __builtin_popcount(node->Bitmap);
+    for (i = 0; i < n; ++i) {
+	if (node->Slots[i].Key) {
+	    HamtReleaseValue(node->Slots[i].Key);
+	    HamtReleaseValue(node->Slots[i].Value);
+	} else {
+	    HamtRelease((HamtNode *) node->Slots[i].Value);
+	}
+    }
+#ifdef USE_CORE_RC_STATISTICS
+    ++ObjectPoolStat.NodeFrees;
+#endif
+    free(node);
+}
+
+/**
+**	Release reference of tagged key or value.
+**
+**	@param value	tagged key or value
+*/
+static inline void HamtReleaseValue(size_t value)
+{
+    if (ConfigIsArray((const ConfigObject *)value)) {
+	HamtRelease(ConfigHamt((const ConfigObject *)value));
+    }
+}
+
+/**
+**	Get value of persistent array.
+**
+**	@param node	root node
+**	@param key	tagged key
+**
+**	@returns tagged value, 0 if not found.
+*/
+static size_t HamtGet(const HamtNode * node, size_t key)
+{
+    const HamtSlot *slot;
+    size_t hash;
+    unsigned index;
+    int level;
+
+    hash = HamtHash(key);
+    for (level = 0;; ++level) {
+	index = HamtIndex(hash, level);
+	if (!(node->Bitmap & (1U << index))) {
+	    return 0;
+	}
+	slot = &node->Slots[HamtPosition(node->Bitmap, index)];
+	if (slot->Key) {
+	    return slot->Key == key ? slot->Value : 0;
+	}
+	node = (const HamtNode *)slot->Value;
+    }
+}
+
+/**
+**	Find first leaf of persistent array with hash equal or greater.
+**
+**	@param node	node at level
+**	@param hash	hash of key to search
+**	@param level	trie level of node
+**	@param next	true search exclusive, false inclusive
+**
+**	@returns leaf slot, NULL if none.
+*/
+static const HamtSlot *HamtSeek(const HamtNode * node, size_t hash,
+    int level, int next)
+{
+    const HamtSlot *slot;
+    unsigned index;
+    size_t other;
+    int i;
+    int n;
+
+    n = __builtin_popcount(node->Bitmap);
+    index = HamtIndex(hash, level);
+    i = HamtPosition(node->Bitmap, index);
+    if (node->Bitmap & (1U << index)) {
+	slot = &node->Slots[i++];
+	if (!slot->Key) {
+	    if ((slot = HamtSeek((const HamtNode *)slot->Value, hash,
+			level + 1, next))) {
+		return slot;
+	    }
+	} else if ((other = HamtHash(slot->Key)) > hash
+	    || (!next && other == hash)) {
+	    return slot;
+	}
+    }
+    if (i == n) {
+	return NULL;
+    }
+    // all later slots have greater hashes, get the smallest
+    slot = &node->Slots[i];
+    while (!slot->Key) {
+	slot = ((const HamtNode *)slot->Value)->Slots;
+    }
+    return slot;
+}
+
+/**
+**	Get first or next value of persistent array.
+**
+**	@param node		root node
+**	@param[in,out] index	tagged key
+**	@param next		true search exclusive, false inclusive
+**
+**	@returns pointer to value, NULL if none.
+*/
+static const size_t *HamtFirst(const HamtNode * node, size_t * index,
+    int next)
+{
+    const HamtSlot *slot;
+
+    if ((slot = HamtSeek(node, HamtHash(*index), 0, next))) {
+	*index = slot->Key;
+	return &slot->Value;
+    }
+    return NULL;
+}
+
+/**
+**	Copy persistent array node with one slot changed.
+**
+**	@param node	node to copy
+**	@param bitmap	used slots of the copy
+**	@param pos	position of changed slot
+**	@param change	1 insert @a slot, 0 replace with @a slot, -1 remove
+**	@param slot	new slot, its references are moved into the copy
+**	@param n	number of keys in subtree of the copy
+**
+**	@returns copy with one reference, the unchanged slots are shared.
+*/
+static HamtNode *HamtCopy(const HamtNode * node, uint32_t bitmap, int pos,
+    int change, const HamtSlot * slot, size_t n)
+{
+    HamtNode *copy;
+    int used;
+    int i;
+    int j;
+
+    used = __builtin_popcount(node->Bitmap);
+    copy = HamtAlloc(used + change);
+    copy->N = n;
+    copy->Bitmap = bitmap;
+    for (i = j = 0; i < used; ++i) {
+	if (i == pos && change >= 0) {
+	    copy->Slots[j++] = *slot;
+	}
+	if (i == pos && change <= 0) {
+	    continue;
+	}
+	HamtShareSlot(&node->Slots[i]);
+	copy->Slots[j++] = node->Slots[i];
+    }
+    if (pos == used && change > 0) {
+	copy->Slots[j] = *slot;
+    }
+    return copy;
+}
+
+/**
+**	Build node of two leaves with the same hash slot.
+**
+**	@param leaf	first leaf, its references are moved into the node
+**	@param other	second leaf, its references are moved into the node
+**	@param level	trie level of the node
+**
+**	@returns node with one reference.
+*/
+static HamtNode *HamtPair(const HamtSlot * leaf, const HamtSlot * other,
+    int level)
+{
+    HamtNode *node;
+    unsigned a;
+    unsigned b;
+
+    a = HamtIndex(HamtHash(leaf->Key), level);
+    b = HamtIndex(HamtHash(other->Key), level);
+    if (a == b) {			// still the same slot, one level down
+	node = HamtAlloc(1);
+	node->Slots[0].Key = 0;
+	node->Slots[0].Value = (size_t)HamtPair(leaf, other, level + 1);
+    } else {
+	node = HamtAlloc(2);
+	node->Slots[a > b] = *leaf;
+	node->Slots[a < b] = *other;
+    }
+    node->N = 2;
+    node->Bitmap = (1U << a) | (1U << b);
+
+    return node;
+}
+
+/**
+**	Set key of persistent array node.
+**
+**	Only the nodes on the path of the key are copied, all other nodes
+**	are shared with @a node, which is unchanged.
+**
+**	@param node	node at level
+**	@param key	tagged key
+**	@param hash	hash of key
+**	@param value	tagged value, 0 removes the key
+**	@param level	trie level of node
+**
+**	@returns new node with one reference, @a node itself if nothing
+**	changed, NULL if the node has no keys left.
+*/
+static HamtNode *HamtSet(const HamtNode * node, size_t key, size_t hash,
+    size_t value, int level)
+{
+    const HamtSlot *slot;
+    const HamtNode *child;
+    HamtNode *copy;
+    HamtSlot item;
+    HamtSlot leaf;
+    uint32_t bit;
+    size_t n;
+    int pos;
+
+    bit = 1U << HamtIndex(hash, level);
+    pos = HamtPosition(node->Bitmap, HamtIndex(hash, level));
+    leaf.Key = key;
+    leaf.Value = value;
+    if (!(node->Bitmap & bit)) {	// free slot: insert leaf
+	if (!value) {
+	    return HamtShare(node);
+	}
+	HamtShareSlot(&leaf);
+	return HamtCopy(node, node->Bitmap | bit, pos, 1, &leaf,
+	    node->N + 1);
+    }
+    slot = &node->Slots[pos];
+    if (slot->Key == key) {		// same key: replace or remove leaf
+	if (slot->Value == value) {
+	    return HamtShare(node);
+	}
+	if (!value) {
+	    return node->N == 1 ? NULL : HamtCopy(node, node->Bitmap & ~bit,
+		pos, -1, NULL, node->N - 1);
+	}
+	HamtShareSlot(&leaf);
+	return HamtCopy(node, node->Bitmap, pos, 0, &leaf, node->N);
+    }
+    if (slot->Key) {			// other key: split into child
+	if (!value) {
+	    return HamtShare(node);
+	}
+	HamtShareSlot(slot);
+	HamtShareSlot(&leaf);
+	item.Key = 0;
+	item.Value = (size_t)HamtPair(slot, &leaf, level + 1);
+	return HamtCopy(node, node->Bitmap, pos, 0, &item, node->N + 1);
+    }
+
+    child = (const HamtNode *)slot->Value;
+    copy = HamtSet(child, key, hash, value, level + 1);
+    if (copy == child) {
+	HamtRelease(copy);
+	return HamtShare(node);
+    }
+    // children have at least two keys, a single leaf moves up
+    n = node->N - child->N + copy->N;
+    if (copy->N == 1) {
+	item = copy->Slots[0];
+	HamtShareSlot(&item);
+	HamtRelease(copy);
+    } else {
+	item.Key = 0;
+	item.Value = (size_t)copy;
+    }
+    return HamtCopy(node, node->Bitmap, pos, 0, &item, n);
+}
+
+/**
+**	Set key of persistent array.
+**
+**	@param root	root node, unchanged
+**	@param key	tagged key
+**	@param value	tagged value, 0 removes the key
+**
+**	@returns new root node with one reference.
+*/
+static HamtNode *HamtUpdate(const HamtNode * root, size_t key, size_t value)
+{
+    HamtNode *node;
+
+    if (!(node = HamtSet(root, key, HamtHash(key), value, 0))) {
+	node = HamtAlloc(0);		// last key removed
+    }
+    return node;
+}
+
+#endif
+
+/**
+**	Get value of array object.
+**
+**	@param object	array object of any kind
+**	@param index	tagged key
+**
+**	@returns tagged value, 0 if not found.
+*/
+static size_t ObjectArrayGet(const ConfigObject * object, size_t index)
+{
+    const FrozenArray *array;
+    const VectorArray *vector;
+    size_t i;
+
+    if (ConfigArrayKind(object) == CONFIG_ARRAY_CORE) {
+	return ArrayGet(object->Pointer, index);
+    }
+    if (ConfigArrayKind(object) == CONFIG_ARRAY_VECTOR) {
+	vector = ConfigVector(object);
+	i = VectorPosition(index);
+	return i < vector->N && index == (size_t)ConfigNewInteger(i)
+	    ? vector->Values[i] : 0;
+    }
+    if (ConfigArrayKind(object) == CONFIG_ARRAY_PARTS) {
+	return ArrayGet(ConfigIsFixed((const ConfigObject *)index)
+	    ? ConfigParts(object)->Fixed : ConfigParts(object)->Named, index);
+    }
+#ifdef USE_CORE_RC_PERSISTENT
+    if (ConfigArrayKind(object) == CONFIG_ARRAY_HAMT) {
+	return HamtGet(ConfigHamt(object), index);
+    }
+#endif
+    array = ConfigFrozen(object);
+    i = FrozenSearch(array, index);
+    if (i < array->N && !FrozenCompare(array->Items[i].Key, index)) {
+	return array->Items[i].Value;
+    }
+    return 0;
+}
+
+/**
+**	Get first value of array object.
+**
+**	Search (inclusive) for the first index that is equal to or greater
+**	than index.
+**
+**	@param object		array object of any kind
+**	@param[in,out] index	tagged key
+**
+**	@returns pointer to value, NULL if none.
+*/
+static const size_t *ObjectArrayFirst(const ConfigObject * object,
+    size_t * index)
+{
+    const FrozenArray *array;
+    const VectorArray *vector;
+    size_t i;
+
+    if (ConfigArrayKind(object) == CONFIG_ARRAY_CORE) {
+	return ArrayFirst(object->Pointer, index);
+    }
+    if (ConfigArrayKind(object) == CONFIG_ARRAY_VECTOR) {
+	vector = ConfigVector(object);
+	if ((i = VectorPosition(*index)) < vector->N) {
+	    *index = (size_t)ConfigNewInteger(i);
+	    return &vector->Values[i];
+	}
+	return NULL;
+    }
+    if (ConfigArrayKind(object) == CONFIG_ARRAY_PARTS) {
+	return PartsSeek(ConfigParts(object), index, 0);
+    }
+#ifdef USE_CORE_RC_PERSISTENT
+    if (ConfigArrayKind(object) == CONFIG_ARRAY_HAMT) {
+	return HamtFirst(ConfigHamt(object), index, 0);
+    }
+#endif
+    array = ConfigFrozen(object);
+    if ((i = FrozenSearch(array, *index)) < array->N) {
+	*index = array->Items[i].Key;
+	return &array->Items[i].Value;
+    }
+    return NULL;
+}
+
+/**
+**	Get next value of array object.
+**
+**	Search (exclusive) for the next index that is greater than index.
+**
+**	@param object		array object of any kind
+**	@param[in,out] index	tagged key
+**
+**	@returns pointer to value, NULL if none.
+*/
+static const size_t *ObjectArrayNext(const ConfigObject * object,
+    size_t * index)
+{
+    const FrozenArray *array;
+    const VectorArray *vector;
+    size_t i;
+
+    if (ConfigArrayKind(object) == CONFIG_ARRAY_CORE) {
+	return ArrayNext(object->Pointer, index);
+    }
+    if (ConfigArrayKind(object) == CONFIG_ARRAY_VECTOR) {
+	vector = ConfigVector(object);
+	i = VectorPosition(*index);
+	if (i < vector->N && *index == (size_t)ConfigNewInteger(i)) {
+	    ++i;
+	}
+	if (i < vector->N) {
+	    *index = (size_t)ConfigNewInteger(i);
+	    return &vector->Values[i];
+	}
+	return NULL;
+    }
+    if (ConfigArrayKind(object) == CONFIG_ARRAY_PARTS) {
+	return PartsSeek(ConfigParts(object), index, 1);
+    }
+#ifdef USE_CORE_RC_PERSISTENT
+    if (ConfigArrayKind(object) == CONFIG_ARRAY_HAMT) {
+	return HamtFirst(ConfigHamt(object), index, 1);
+    }
+#endif
+    array = ConfigFrozen(object);
+    i = FrozenSearch(array, *index);
+    if (i < array->N && !FrozenCompare(array->Items[i].Key, *index)) {
+	++i;
+    }
+    if (i < array->N) {
+	*index = array->Items[i].Key;
+	return &array->Items[i].Value;
+    }
+    return NULL;
+}
+
+/**
+**	Get first or next value of array object with integer or string key.
+**
+**	@param object		array object of any kind
+**	@param[in,out] index	tagged key
+**	@param word		true string keys, false integer keys
+**	@param next		true search exclusive, false inclusive
+**
+**	@returns pointer to value, NULL if none.
+*/
+static const size_t *ObjectArraySeekKey(const ConfigObject * object,
+    size_t * index, int word, int next)
+{
+    const PartsArray *parts;
+    const FrozenArray *array;
+    const size_t *value;
+    size_t i;
+    size_t j;
+
+    switch (ConfigArrayKind(object)) {
+	case CONFIG_ARRAY_VECTOR:	// only integer keys
+	    if (word) {
+		return NULL;
+	    }
+	    break;
+	case CONFIG_ARRAY_PARTS:
+	    parts = ConfigParts(object);
+	    if (!word) {
+		return next ? ArrayNext(parts->Fixed, index)
+		    : ArrayFirst(parts->Fixed, index);
+	    }
+	    value = next ? ArrayNext(parts->Named, index)
+		: ArrayFirst(parts->Named, index);
+	    while (value && !ConfigIsWord((const ConfigObject *)*index)) {
+		value = ArrayNext(parts->Named, index);
+	    }
+	    return value;
+	case CONFIG_ARRAY_FROZEN:	// classes are partitions
+	    array = ConfigFrozen(object);
+	    i = FrozenSearch(array, *index);
+	    if (next && i < array->N
+		&& !FrozenCompare(array->Items[i].Key, *index)) {
+		++i;
+	    }
+	    if (i < (j = FrozenSearchClass(array, word ? 2 : 1))) {
+		i = j;
+	    }
+	    for (; i < array->N; ++i) {
+		const ConfigObject *key;
+
+		key = (const ConfigObject *)array->Items[i].Key;
+		if (word ? ConfigIsWord(key) : ConfigIsFixed(key)) {
+		    *index = (size_t)key;
+		    return &array->Items[i].Value;
+		}
+		if (FrozenClass((size_t)key) > 1) {
+		    break;
+		}
+	    }
+	    return NULL;
+    }
+    value = next ? ObjectArrayNext(object, index)
+	: ObjectArrayFirst(object, index);
+    while (value && (word ? !ConfigIsWord((const ConfigObject *)*index)
+	    : !ConfigIsFixed((const ConfigObject *)*index))) {
+	value = ObjectArrayNext(object, index);
+    }
+    return value;
+}
+
+/**
+**	Get number of keys of core array.
+**
+**	@param array	core array
+*/
+static size_t CoreArrayLength(const Array * array)
+{
+    size_t index;
+    const size_t *value;
+    size_t n;
+
+    n = 0;
+    index = 0;
+    value = ArrayFirst(array, &index);
+    while (value) {
+	++n;
+	value = ArrayNext(array, &index);
+    }
+    return n;
+}
+
+/**
+**	Choose kind of array finished by the parser.
+**
+**	Keys 0 .. n-1 give a vector array, integer keys mixed with other
+**	keys give a parts array.  All other arrays are kept, empty arrays
+**	are filled by lvalues.
+**
+**	@param array	core array, freed if converted
+**
+**	@returns tagged array pointer for an array object.
+*/
+static Array *ArrayChooseKind(Array * array)
+{
+    VectorArray *vector;
+    PartsArray *parts;
+    size_t index;
+    size_t *value;
+    size_t n;
+    size_t fixed;
+    int dense;
+
+    n = 0;
+    fixed = 0;
+    dense = 1;
+    index = 0;
+    value = ArrayFirst(array, &index);
+    while (value) {
+	fixed += ConfigIsFixed((const ConfigObject *)index);
+	dense &= index == (size_t)ConfigNewInteger(n);
+	++n;
+	value = ArrayNext(array, &index);
+    }
+    if (n && dense) {
+	vector = malloc(sizeof(*vector) + n * sizeof(*vector->Values));
+	vector->N = n;
+	n = 0;
+	index = 0;
+	value = ArrayFirst(array, &index);
+	while (value) {
+	    vector->Values[n++] = *value;
+	    value = ArrayNext(array, &index);
+	}
+	ArrayFree(array);
+	return (Array *) ((size_t)vector | CONFIG_ARRAY_VECTOR);
+    }
+    if (fixed && fixed < n) {
+	parts = malloc(sizeof(*parts));
+	parts->Fixed = ArrayNew();
+	parts->Named = ArrayNew();
+	index = 0;
+	value = ArrayFirst(array, &index);
+	while (value) {
+	    ArrayIns(ConfigIsFixed((const ConfigObject *)index) ? &parts->Fixed
+		: &parts->Named, index, *value);
+	    value = ArrayNext(array, &index);
+	}
+	ArrayFree(array);
+	return (Array *) ((size_t)parts | CONFIG_ARRAY_PARTS);
+    }
+    return array;
+}
+
+/**
+**	Promote vector array into core array.
+**
+**	@param vector	vector array, freed
+**
+**	@returns core array with the same keys and values.
+*/
+static Array *VectorToArray(VectorArray * vector)
+{
+    Array *array;
+    size_t i;
+
+    array = ArrayNew();
+    for (i = 0; i < vector->N; ++i) {
+	ArrayIns(&array, (size_t)ConfigNewInteger(i), vector->Values[i]);
+    }
+    free(vector);
+
+    return array;
+}
+
+/**
+**	Free array of array object created by parser or ConfigNewArray().
+**
+**	@param object	array object of kind core, vector or parts
+*/
+static void ObjectArrayFree(ConfigObject * object)
+{
+    PartsArray *parts;
+
+    switch (ConfigArrayKind(object)) {
+	case CONFIG_ARRAY_CORE:
+	    ArrayFree(object->Pointer);
+	    break;
+	case CONFIG_ARRAY_PARTS:
+	    parts = (PartsArray *) ConfigParts(object);
+	    ArrayFree(parts->Fixed);
+	    ArrayFree(parts->Named);
+	    free(parts);
+	    break;
+	default:
+	    free((void *)((size_t)object->Pointer & ~7));
+	    break;
+    }
+}
+
+/// @}
+
+/**
+**	Check if value is a fixed integer object.
+**
+**	@param object		tagged object pointer
+**	@param[out] result	fixed integer object is stored in result
+**
+**	@returns true if object is fixed integer object, false otherwise.
+*/
+int ConfigCheckInteger(const ConfigObject * object, ssize_t * result)
+{
+    if (ConfigIsFixed(object)) {
+	*result = ConfigInteger(object);
+	return 1;
+    }
+    return 0;
+}
+
+/**
+**	Check if value is an unsigned integer object.
+**
+**	@param object		tagged object pointer
+**	@param[out] result	unsigned integer object is stored in result
+**
+**	@returns true if object is unsigned integer object, false otherwise.
+*/
+int ConfigCheckUnsigned(const ConfigObject * object, size_t *result)
+{
+    if (ConfigIsFixed(object)) {
+	*result = ConfigUnsigned(object);
+	return 1;
+    }
+    return 0;
+}
+
+/**
+**	Check if value is a floating point object.
+**
+**	@param object		tagged object pointer
+**	@param[out] result	floating point object is stored in result
+**
+**	@returns true if object is floating point object, false otherwise.
+*/
+int ConfigCheckDouble(const ConfigObject * object, double *result)
+{
+    if (ConfigIsFloat(object)) {
+	*result = ConfigDouble(object);
+	return 1;
+    }
+    return 0;
+}
+
+/**
+**	Check if value is a fixed string object.
+**
+**	@param object		tagged object pointer
+**	@param[out] result	fixed string is stored in result
+**
+**	@returns true if object is fixed string object, false otherwise.
+**
+**	@see ConfigStringBuffer() for short strings without pool copy.
+*/
+int ConfigCheckString(const ConfigObject * object, const char **result)
+{
+    if (ConfigIsWord(object)) {
+	*result = ConfigWord(object);
+	return 1;
+    }
+    return 0;
+}
+
+/**
+**	Get string of string object into buffer.
+**
+**	Short strings are copied into @a buf, the others are returned from
+**	their string pool.  Other than ConfigCheckString(), short strings
+**	are never spelled in the pool.
+**
+**	@param object	tagged object pointer
+**	@param buf	buffer of #CONFIG_STRING_BUFFER bytes
+**
+**	@returns the string, NULL if object isn't a string.
+*/
+const char *ConfigStringBuffer(const ConfigObject * object, char *buf)
+{
+    if (ConfigIsWord(object)) {
+	return ConfigString(object, buf);
+    }
+    return NULL;
+}
+
+/**
+**	Get length of string object.
+**
+**	The length is stored with the string.
+**
+**	@param object	tagged string object pointer
+**
+**	@returns length of string without '\0', 0 if object isn't a string.
+*/
+size_t ConfigStringLength(const ConfigObject * object)
+{
+#ifdef USE_CORE_RC_SHORT_STRING
+    if (StringIsShort((size_t)object)) {
+	return StringShortLength((size_t)object);
+    }
+#endif
+    if (ConfigIsWord(object)) {
+	return StringPoolHeader(ConfigString(object, NULL))->Length;
+    }
+    return 0;
+}
+
+/**
+**	Get hash of string object.
+**
+**	The hash is calculated, when the string is interned.  Equal strings
+**	have equal hashes, also across programs and binary snapshots.
+**
+**	@param object	tagged string object pointer
+**
+**	@returns 32 bit hash of string, 0 if object isn't a string.
+*/
+size_t ConfigStringHash(const ConfigObject * object)
+{
+#ifdef USE_CORE_RC_SHORT_STRING
+    char buf[CONFIG_STRING_BUFFER];
+
+    if (StringIsShort((size_t)object)) {
+	StringShortCopy((size_t)object, buf);
+	return (uint32_t) StringHash(buf, StringShortLength((size_t)object));
+    }
+#endif
+    if (ConfigIsWord(object)) {
+	return StringPoolHeader(ConfigString(object, NULL))->Hash;
+    }
+    return 0;
+}
+
+/**
+**	Check if value is an array object.
+**
+**	@param object		tagged object pointer
+**	@param[out] result	array object is stored in result
+**
+**	@returns true if object is an array object, false otherwise.
+*/
+int ConfigCheckArray(const ConfigObject * object, const ConfigObject ** result)
+{
+    if (ConfigIsArray(object)) {
+	*result = object;
+	return 1;
+    }
+    return 0;
+}
+
+#ifdef USE_CORE_RC_GET_STRINGS
+
+/**
+**	Lookup config object.
+**
+**	The names are only searched in the string pool, not interned.  A
+**	name that isn't in the pool can't be a key of a parsed config, but
+**	of a mapped binary snapshot, their frozen arrays compare the words
+**	by content.  Those names are searched with a probe object on the
+**	stack.	Lookups of missing keys don't grow or modify the pool.
+**	The pool is searched without lock, other threads can merge their
+**	parsed strings meanwhile.
+**
+**	@param config	config dictionary or sub array
+**	@param ap	array of strings NULL terminated, to select value
+**
+**	@returns object stored in dictionary at index ap
+*/
+static const ConfigObject *ConfigStringsLookup(const ConfigObject * config,
+    va_list ap)
+{
+    const char *name;
+    const ConfigObject *key;
+    ConfigObject probe;
+
+    // loop over all index keys
+    while ((name = va_arg(ap, const char *)))
+    {
+	if (!ConfigIsArray(config)) {
+	    fprintf(stderr, "array required for index '%s'\n", name);
+	    config = NULL;
+	    break;
+	}
+	if (!(key = StringPoolLookup(ConfigStrings, name))) {
+	    probe.Pointer = (void *)name;
+	    key = (const ConfigObject *)((size_t)&probe | 4);
+	}
+	config = (const ConfigObject *)ObjectArrayGet(config, (size_t)key);
+    }
+
+    return config;
+}
+
+/**
+**	Get config any value object.
+**
+**	@param config		config dictionary
+**	@param[out] result	object result
+**	@param ...		list of objects NULL terminated, to select value
+**
+**	@returns true if value found at index in dictionary.
+*/
+int ConfigStringsGetObject(const ConfigObject * config,
+    const ConfigObject ** result, ...)
+{
+    va_list ap;
+    const ConfigObject *value;
+
+    va_start(ap, result);
+    value = ConfigStringsLookup(config, ap);
+    va_end(ap);
+
+    if (value) {
+	*result = value;
+	return 1;
+    }
+    return 0;
+}
+
+/**
+**	Get config integer object.
+**
+**	@param config		config dictionary
+**	@param[out] result	signed integer result
+**	@param ...		list of objects NULL terminated, to select value
+**
+**	@returns true if value found at index in dictionary.
+*/
+int ConfigStringsGetInteger(const ConfigObject * config, ssize_t * result, ...)
+{
+    va_list ap;
+    const ConfigObject *value;
+
+    va_start(ap, result);
+    value = ConfigStringsLookup(config, ap);
+    va_end(ap);
+
+    if (ConfigIsFixed(value)) {
+	*result = ConfigInteger(value);
+	return 1;
+    }
+    if (value) {
+	fprintf(stderr, "value isn't a fixed integer\n");
+    }
+    return 0;
+}
+
+/**
+**	Get config unsigned object.
+**
+**	@param config		config dictionary
+**	@param[out] result	unsigned integer result
+**	@param ...		list of objects NULL terminated, to select value
+**
+**	@returns true if value found at index in dictionary.
+*/
+int ConfigStringsGetUnsigned(const ConfigObject * config, size_t *result, ...)
+{
+    va_list ap;
+    const ConfigObject *value;
+
+    va_start(ap, result);
+    value = ConfigStringsLookup(config, ap);
+    va_end(ap);
+
+    if (ConfigIsFixed(value)) {
+	*result = ConfigInteger(value);
+	return 1;
+    }
+    if (value) {
+	fprintf(stderr, "value isn't a fixed unsigned\n");
+    }
+    return 0;
+}
+
+/**
+**	Get config boolean object.
+**
+**	@param config		config dictionary
+**	@param ...		list of objects NULL terminated, to select value
+**
+**	@retval -1	if index didn't exists in dictionary.
+**	@retval	true	if value is not false.
+**	@retval	false	if value is 'false' or 0.
+*/
+int ConfigStringsGetBoolean(const ConfigObject * config, ...)
+{
+    va_list ap;
+    const ConfigObject *value;
+
+    va_start(ap, config);
+    value = ConfigStringsLookup(config, ap);
+    va_end(ap);
+
+    if (ConfigIsFixed(value)) {
+	return ConfigInteger(value);
+    }
+    if (value) {
+	fprintf(stderr, "value isn't a fixed integer\n");
+    }
+    return -1;
+}
+
+/**
+**	Get config double object.
+**
+**	@param config		config dictionary
+**	@param[out] result	double result
+**	@param ...		list of objects NULL terminated, to select value
+**
+**	@returns true if value found at index in dictionary.
+*/
+int ConfigStringsGetDouble(const ConfigObject * config, double *result, ...)
+{
+    va_list ap;
+    const ConfigObject *value;
+
+    va_start(ap, result);
+    value = ConfigStringsLookup(config, ap);
+    va_end(ap);
+
+    if (ConfigIsFloat(value)) {
+	*result = ConfigDouble(value);
+	return 1;
+    }
+    if (value) {
+	fprintf(stderr, "value isn't a double\n");
+    }
+    return 0;
+}
+
+/**
+**	Get config string object.
+**
+**	@param config		config dictionary
+**	@param[out] result	string result
+**	@param ...		list of objects NULL terminated, to select value
+**
+**	@returns true if value found at index in dictionary.
+*/
+int ConfigStringsGetString(const ConfigObject * config, const char **result,
+    ...)
+{
+    va_list ap;
+    const ConfigObject *value;
+
+    va_start(ap, result);
+    value = ConfigStringsLookup(config, ap);
+    va_end(ap);
+
+    if (ConfigIsWord(value)) {
+	*result = ConfigWord(value);
+	return 1;
+    }
+    if (value) {
+	fprintf(stderr, "value isn't a string\n");
+    }
+    return 0;
+}
+
+/**
+**	Get config array object.
+**
+**	@param config		config dictionary
+**	@param[out] result	array result
+**	@param ...		list of objects NULL terminated, to select value
+**
+**	@returns true if value found at index in dictionary.
+*/
+int ConfigStringsGetArray(const ConfigObject * config,
+    const ConfigObject ** result, ...)
+{
+    va_list ap;
+    const ConfigObject *value;
+
+    va_start(ap, result);
+    value = ConfigStringsLookup(config, ap);
+    va_end(ap);
+
+    if (ConfigIsArray(value)) {
+	*result = value;
+	return 1;
+    }
+    if (value) {
+	fprintf(stderr, "value isn't an array\n");
+    }
+    return 0;
+}
+
+#endif // USE_CORE_RC_GET_STRINGS
+
+/**
+**	Lookup config object.
+**
+**	@param config	config dictionary or sub array
+**	@param ap	array of objects NULL terminated, to select value
+**
+**	@returns object stored in dictionary at index ap
+*/
+static const ConfigObject *ConfigLookup(const ConfigObject * config,
+    va_list ap)
+{
+    const ConfigObject *index;
+
+    // loop over all index keys
+    while ((index = va_arg(ap, const ConfigObject *)))
+    {
+	if (!ConfigIsArray(config)) {
+	    fprintf(stderr, "array required for index '%p'\n", index);
+	    return NULL;
+	}
+	config = (const ConfigObject *)ObjectArrayGet(config, (size_t)index);
+    }
+    return config;
+}
+
+/**
+**	Get config any value object.
+**
+**	@param config		config dictionary
+**	@param[out] result	object result
+**	@param ...		list of objects NULL terminated, to select value
+**
+**	@returns true if value found at index in dictionary.
+*/
+int ConfigGetObject(const ConfigObject * config, const ConfigObject ** result,
+    ...)
+{
+    va_list ap;
+    const ConfigObject *value;
+
+    va_start(ap, result);
+    value = ConfigLookup(config, ap);
+    va_end(ap);
+
+    if (value) {
+	*result = value;
+	return 1;
+    }
+    return 0;
+}
+
+/**
+**	Get config integer object.
+**
+**	@param config		config dictionary
+**	@param[out] result	signed integer result
+**	@param ...		list of objects NULL terminated, to select value
+**
+**	@returns true if value found at index in dictionary.
+*/
+int ConfigGetInteger(const ConfigObject * config, ssize_t * result, ...)
+{
+    va_list ap;
+    const ConfigObject *value;
+
+    va_start(ap, result);
+    value = ConfigLookup(config, ap);
+    va_end(ap);
+
+    if (ConfigIsFixed(value)) {
+	*result = ConfigInteger(value);
+	return 1;
+    }
+    if (value) {
+	fprintf(stderr, "value isn't a fixed integer\n");
+    }
+    return 0;
+}
+
+/**
+**	Get config unsigned object.
+**
+**	@param config		config dictionary
+**	@param[out] result	unsigned integer result
+**	@param ...		list of objects NULL terminated, to select value
+**
+**	@returns true if value found at index in dictionary.
+*/
+int ConfigGetUnsigned(const ConfigObject * config, size_t *result, ...)
+{
+    va_list ap;
+    const ConfigObject *value;
+
+    va_start(ap, result);
+    value = ConfigLookup(config, ap);
+    va_end(ap);
+
+    if (ConfigIsFixed(value)) {
+	*result = ConfigUnsigned(value);
+	return 1;
+    }
+    if (value) {
+	fprintf(stderr, "value isn't a fixed unsigned\n");
+    }
+    return 0;
+}
+
+/**
+**	Get config boolean object.
+**
+**	@param config		config dictionary
+**	@param ...		list of objects NULL terminated, to select value
+**
+**	@retval -1	if index didn't exists in dictionary.
+**	@retval	true	if value is not false.
+**	@retval	false	if value is 'false' or 0.
+*/
+int ConfigGetBoolean(const ConfigObject * config, ...)
+{
+    va_list ap;
+    const ConfigObject *value;
+
+    va_start(ap, config);
+    value = ConfigLookup(config, ap);
+    va_end(ap);
+
+    if (ConfigIsFixed(value)) {
+	return ConfigInteger(value);
+    }
+    if (value) {
+	fprintf(stderr, "value isn't a fixed integer\n");
+    }
+    return -1;
+}
+
+/**
+**	Get config double object.
+**
+**	@param config		config dictionary
+**	@param[out] result	double result
+**	@param ...		list of objects NULL terminated, to select value
+**
+**	@returns true if value found at index in dictionary.
+*/
+int ConfigGetDouble(const ConfigObject * config, double *result, ...)
+{
+    va_list ap;
+    const ConfigObject *value;
+
+    va_start(ap, result);
+    value = ConfigLookup(config, ap);
+    va_end(ap);
+
+    if (ConfigIsFloat(value)) {
+	*result = ConfigDouble(value);
+	return 1;
+    }
+    if (value) {
+	fprintf(stderr, "value isn't a double\n");
+    }
+    return 0;
+}
+
+/**
+**	Get config string object.
+**
+**	@param config		config dictionary
+**	@param[out] result	string result
+**	@param ...		list of objects NULL terminated, to select value
+**
+**	@returns true if value found at index in dictionary.
+*/
+int ConfigGetString(const ConfigObject * config, const char **result, ...)
+{
+    va_list ap;
+    const ConfigObject *value;
+
+    va_start(ap, result);
+    value = ConfigLookup(config, ap);
+    va_end(ap);
+
+    if (ConfigIsWord(value)) {
+	*result = ConfigWord(value);
+	return 1;
+    }
+    if (value) {
+	fprintf(stderr, "value isn't a string\n");
+    }
+    return 0;
+}
+
+/**
+**	Get config array object.
+**
+**	@param config		config dictionary
+**	@param[out] result	array result
+**	@param ...		list of objects NULL terminated, to select value
+**
+**	@returns true if value found at index in dictionary.
+*/
+int ConfigGetArray(const ConfigObject * config, const ConfigObject ** result,
+    ...)
+{
+    va_list ap;
+    const ConfigObject *value;
+
+    va_start(ap, result);
+    value = ConfigLookup(config, ap);
+    va_end(ap);
+
+    if (ConfigIsArray(value)) {
+	*result = value;
+	return 1;
+    }
+    if (value) {
+	fprintf(stderr, "value isn't an array\n");
+    }
+    return 0;
+}
+
+#ifdef USE_CORE_RC_PATH
+
+/**
+**	Compiled config path.
+*/
+struct _config_path_
+{
+    int N;				///< number of keys
+    const ConfigObject *Keys[1];	///< interned keys of path
+};
+
+/**
+**	Parse config path into keys.
+**
+**	Without @a probes the words are interned.  With @a probes they are
+**	only searched, a word not in the pool is copied to the same offset
+**	in @a buf and gets the probe object of its key, which finds only
+**	keys of the frozen arrays of mapped configs.
+**
+**	@param text		config path
+**	@param s		position in text to continue parsing
+**	@param[in,out] keys	keys of path, room for strlen(text) keys
+**	@param i		number of keys already parsed before @a s
+**	@param probes		probe objects, room for strlen(text) objects,
+**				NULL intern words
+**	@param buf		probe strings, strlen(text) + 1 bytes
+**
+**	@returns number of keys, -1 if path has a syntax error.
+**
+**	@note without @a probes the caller must hold #ConfigStringsLock
+*/
+static int ConfigPathParse(const char *text, const char *s,
+    const ConfigObject ** keys, int i, ConfigObject * probes, char *buf)
+{
+    char *end;
+    size_t hash;
+    size_t n;
+
+    while (*s) {
+	if (*s == '[') {		// [n] integer index
+	    keys[i++] = ConfigNewInteger(strtol(s + 1, &end, 0));
+	    if (end == s + 1 || *end != ']') {
+		goto error;
+	    }
+	    s = end + 1;
+	} else {			// word index
+	    if (i && *s++ != '.') {
+		goto error;
+	    }
+	    n = strcspn(s, ".[");
+	    if (!n) {
+		goto error;
+	    }
+	    hash = StringHash(s, n);
+	    if (!probes) {
+		keys[i] = StringPoolInsertHash(ConfigStrings, s, n, hash, NULL);
+	    } else if (!(keys[i] =
+		    StringPoolLookupHash(ConfigStrings, s, n, hash))) {
+		probes[i].Pointer = memcpy(buf + (s - text), s, n);
+		buf[s - text + n] = '\0';
+		keys[i] = (const ConfigObject *)((size_t)(probes + i) | 4);
+	    }
+	    ++i;
+	    s += n;
+	}
+    }
+    return i;
+
+  error:
+    fprintf(stderr, "core-rc: syntax error in config path '%s' at '%s'\n",
+	text, s);
+    return -1;
+}
+
+/**
+**	Compile config path.
+**
+**	The path is a list of words separated by '.', "[n]" selects the
+**	integer index n: "server.http.port" or "servers[0].name".  The
+**	words are interned once, a lookup with the compiled path costs only
+**	the array probes.
+**
+**	@param text	config path
+**
+**	@returns compiled path, NULL if path has a syntax error.
+*/
+ConfigPath *ConfigPathCompile(const char *text)
+{
+    ConfigPath *path;
+
+    // enough for all keys, each key has at least one character
+    path = malloc(sizeof(*path) + strlen(text) * sizeof(path->Keys[0]));
+
+    pthread_mutex_lock(&ConfigStringsLock);
+    ConfigStringsRef();
+    path->N = ConfigPathParse(text, text, path->Keys, 0, NULL, NULL);
+    pthread_mutex_unlock(&ConfigStringsLock);
+    if (path->N <= 0) {
+	if (!path->N) {
+	    fprintf(stderr, "core-rc: empty config path\n");
+	}
+	ConfigPathDel(path);
+	return NULL;
+    }
+
+    return path;
+}
+
+/**
+**	Delete compiled config path.
+**
+**	@param path	compiled path, can be NULL
+*/
+void ConfigPathDel(ConfigPath * path)
+{
+    if (path) {
+	free(path);
+	ConfigStringsUnref();
+    }
+}
+
+/**
+**	Lookup config object with keys of path.
+**
+**	@param config	config dictionary or sub array
+**	@param keys	keys of path
+**	@param n	number of keys
+**
+**	@returns object stored in dictionary at path, NULL if not found.
+*/
+static const ConfigObject *ConfigKeysLookup(const ConfigObject * config,
+    const ConfigObject * const *keys, int n)
+{
+    char buf[CONFIG_STRING_BUFFER];
+    int i;
+
+    for (i = 0; i < n && config; ++i) {
+	if (!ConfigIsArray(config)) {
+	    if (ConfigIsWord(keys[i])) {
+		fprintf(stderr, "array required for index '%s'\n",
+		    ConfigString(keys[i], buf));
+	    } else {
+		fprintf(stderr, "array required for index %zd\n",
+		    ConfigInteger(keys[i]));
+	    }
+	    return NULL;
+	}
+	config = (const ConfigObject *)ObjectArrayGet(config, (size_t)keys[i]);
+    }
+    return config;
+}
+
+/**
+**	Lookup config object with compiled path.
+**
+**	@param config	config dictionary or sub array
+**	@param path	compiled config path
+**
+**	@returns object stored in dictionary at path, NULL if not found.
+*/
+static const ConfigObject *ConfigPathLookup(const ConfigObject * config,
+    const ConfigPath * path)
+{
+    return ConfigKeysLookup(config, path->Keys, path->N);
+}
+
+#if defined(USE_CORE_RC_CACHE) || defined(USE_CORE_RC_INDEX)
+
+    /// paths up to this length are found without malloc
+#define CONFIG_FIND_PATH 64
+
+/**
+**	Find config object with uncompiled path.
+**
+**	The words of the path are only searched in the string pool, like
+**	ConfigBind() does, without lock and without interning them.
+**
+**	@param config	config dictionary or sub array
+**	@param text	config path, see ConfigPathCompile()
+**
+**	@returns object stored in dictionary at path, NULL if not found.
+*/
+static const ConfigObject *ConfigPathFind(const ConfigObject * config,
+    const char *text)
+{
+    const ConfigObject *stack_keys[CONFIG_FIND_PATH];
+    ConfigObject stack_probes[CONFIG_FIND_PATH];
+    char stack_buf[CONFIG_FIND_PATH + 1];
+    const ConfigObject **keys;
+    ConfigObject *probes;
+    char *buf;
+    const ConfigObject *value;
+    size_t size;
+    int n;
+
+    keys = stack_keys;
+    probes = stack_probes;
+    buf = stack_buf;
+    size = strlen(text);
+    if (size > CONFIG_FIND_PATH) {
+	keys = malloc(size * (sizeof(*keys) + sizeof(*probes) + 1) + 1);
+	probes = (ConfigObject *) (keys + size);
+	buf = (char *)(probes + size);
+    }
+
+    value = NULL;
+    n = ConfigPathParse(text, text, keys, 0, probes, buf);
+    if (!n) {
+	fprintf(stderr, "core-rc: empty config path\n");
+    }
+    if (n > 0) {
+	value = ConfigKeysLookup(config, keys, n);
+    }
+    if (keys != stack_keys) {
+	free(keys);
+    }
+    return value;
+}
+
+#endif
+
+/**
+**	Get config any value object with compiled path.
+**
+**	@param config		config dictionary
+**	@param[out] result	object result
+**	@param path		compiled path to select value
+**
+**	@returns true if value found at path in dictionary.
+*/
+int ConfigPathGetObject(const ConfigObject * config,
+    const ConfigObject ** result, const ConfigPath * path)
+{
+    const ConfigObject *value;
+
+    if ((value = ConfigPathLookup(config, path))) {
+	*result = value;
+	return 1;
+    }
+    return 0;
+}
+
+/**
+**	Get config integer object with compiled path.
+**
+**	@param config		config dictionary
+**	@param[out] result	signed integer result
+**	@param path		compiled path to select value
+**
+**	@returns true if value found at path in dictionary.
+*/
+int ConfigPathGetInteger(const ConfigObject * config, ssize_t * result,
+    const ConfigPath * path)
+{
+    const ConfigObject *value;
+
+    value = ConfigPathLookup(config, path);
+    if (ConfigIsFixed(value)) {
+	*result = ConfigInteger(value);
+	return 1;
+    }
+    if (value) {
+	fprintf(stderr, "value isn't a fixed integer\n");
+    }
+    return 0;
+}
+
+/**
+**	Get config unsigned object with compiled path.
+**
+**	@param config		config dictionary
+**	@param[out] result	unsigned integer result
+**	@param path		compiled path to select value
+**
+**	@returns true if value found at path in dictionary.
+*/
+int ConfigPathGetUnsigned(const ConfigObject * config, size_t *result,
+    const ConfigPath * path)
+{
+    const ConfigObject *value;
+
+    value = ConfigPathLookup(config, path);
+    if (ConfigIsFixed(value)) {
+	*result = ConfigUnsigned(value);
+	return 1;
+    }
+    if (value) {
+	fprintf(stderr, "value isn't a fixed unsigned\n");
+    }
+    return 0;
+}
+
+/**
+**	Get config boolean object with compiled path.
+**
+**	@param config		config dictionary
+**	@param path		compiled path to select value
+**
+**	@retval -1	if path didn't exists in dictionary.
+**	@retval	true	if value is not false.
+**	@retval	false	if value is 'false' or 0.
+*/
+int ConfigPathGetBoolean(const ConfigObject * config, const ConfigPath * path)
+{
+    const ConfigObject *value;
+
+    value = ConfigPathLookup(config, path);
+    if (ConfigIsFixed(value)) {
+	return ConfigInteger(value);
+    }
+    if (value) {
+	fprintf(stderr, "value isn't a fixed integer\n");
+    }
+    return -1;
+}
+
+/**
+**	Get config double object with compiled path.
+**
+**	@param config		config dictionary
+**	@param[out] result	double result
+**	@param path		compiled path to select value
+**
+**	@returns true if value found at path in dictionary.
+*/
+int ConfigPathGetDouble(const ConfigObject * config, double *result,
+    const ConfigPath * path)
+{
+    const ConfigObject *value;
+
+    value = ConfigPathLookup(config, path);
+    if (ConfigIsFloat(value)) {
+	*result = ConfigDouble(value);
+	return 1;
+    }
+    if (value) {
+	fprintf(stderr, "value isn't a double\n");
+    }
+    return 0;
+}
+
+/**
+**	Get config string object with compiled path.
+**
+**	@param config		config dictionary
+**	@param[out] result	string result
+**	@param path		compiled path to select value
+**
+**	@returns true if value found at path in dictionary.
+*/
+int ConfigPathGetString(const ConfigObject * config, const char **result,
+    const ConfigPath * path)
+{
+    const ConfigObject *value;
+
+    value = ConfigPathLookup(config, path);
+    if (ConfigIsWord(value)) {
+	*result = ConfigWord(value);
+	return 1;
+    }
+    if (value) {
+	fprintf(stderr, "value isn't a string\n");
+    }
+    return 0;
+}
+
+/**
+**	Get config array object with compiled path.
+**
+**	@param config		config dictionary
+**	@param[out] result	array result
+**	@param path		compiled path to select value
+**
+**	@returns true if value found at path in dictionary.
+*/
+int ConfigPathGetArray(const ConfigObject * config,
+    const ConfigObject ** result, const ConfigPath * path)
+{
+    const ConfigObject *value;
+
+    value = ConfigPathLookup(config, path);
+    if (ConfigIsArray(value)) {
+	*result = value;
+	return 1;
+    }
+    if (value) {
+	fprintf(stderr, "value isn't an array\n");
+    }
+    return 0;
+}
+
+#endif
+
+#ifdef USE_CORE_RC_CACHE
+
+/**
+**	Resolve path of lookup cache.
+**
+**	Called by ConfigCacheLookup(), when the cache is for another config
+**	generation.  Not found values are cached too.
+**
+**	@param cache	lookup cache
+**	@param config	configuration loaded
+**	@param text	config path, see ConfigPathCompile()
+**
+**	@returns object stored in dictionary at path, NULL if not found.
+*/
+const ConfigObject *ConfigCacheResolve(ConfigCache * cache,
+    const Config * config, const char *text)
+{
+    const ConfigObject *value;
+
+    value = ConfigPathFind(ConfigDict(config), text);
+    cache->Value = value;
+    cache->Generation = config->Generation;
+
+    return value;
+}
+
+#endif
+
+#ifdef USE_CORE_RC_BIND
+
+/**
+**	Store config value into bound field.
+**
+**	@param value	config value found at path of binding, NULL missing
+**	@param binding	binding of field
+**	@param dst	destination struct
+**
+**	@returns 0 if value is stored, 1 if value is missing or mistyped.
+*/
+static int ConfigBindStore(const ConfigObject * value,
+    const ConfigBinding * binding, char *dst)
+{
+    void *field;
+    const char *type;
+
+    if (!value) {
+	fprintf(stderr, "core-rc: config '%s' missing\n", binding->Path);
+	return 1;
+    }
+    field = dst + binding->Offset;
+    switch (binding->Type) {
+	case ConfigBindInteger:
+	    if (ConfigCheckInteger(value, field)) {
+		return 0;
+	    }
+	    type = "a fixed integer";
+	    break;
+	case ConfigBindUnsigned:
+	    if (ConfigCheckUnsigned(value, field)) {
+		return 0;
+	    }
+	    type = "a fixed integer";
+	    break;
+	case ConfigBindDouble:
+	    if (ConfigCheckDouble(value, field)) {
+		return 0;
+	    }
+	    type = "a floating point";
+	    break;
+	case ConfigBindBoolean:
+	    if (ConfigIsFixed(value)) {
+		*(int *)field = !!ConfigInteger(value);
+		return 0;
+	    }
+	    type = "a fixed integer";
+	    break;
+	case ConfigBindString:
+	    if (ConfigCheckString(value, field)) {
+		return 0;
+	    }
+	    type = "a string";
+	    break;
+	case ConfigBindArray:
+	    if (ConfigCheckArray(value, field)) {
+		return 0;
+	    }
+	    type = "an array";
+	    break;
+	default:
+	    fprintf(stderr, "core-rc: config '%s' unknown bind type %d\n",
+		binding->Path, binding->Type);
+	    return 1;
+    }
+    fprintf(stderr, "core-rc: config '%s' isn't %s\n", binding->Path, type);
+    return 1;
+}
+
+/**
+**	Bind config values to the fields of a C struct.
+**
+**	The table lists the path (see ConfigPathCompile()), the type and the
+**	offset of each field, it ends with a NULL path.	 The table is done
+**	in one pass, a field shares the parsed keys and the looked up values
+**	of the path prefix it has in common with the field before.  Fields
+**	of the same sub array should be listed together.  Fields not found
+**	keep their value, every missing or mistyped field is reported.
+**
+**	@code
+**	static const ConfigBinding table[] = {
+**	    {"server.port", ConfigBindInteger, offsetof(Settings, Port)},
+**	    {"server.name", ConfigBindString, offsetof(Settings, Name)},
+**	    {NULL, 0, 0}
+**	};
+**
+**	errors = ConfigBind(ConfigDict(config), table, &settings);
+**	@endcode
+**
+**	@param config	config dictionary
+**	@param table	binding table, terminated by a NULL path
+**	@param dst	destination struct
+**
+**	@returns number of missing or mistyped fields, 0 if all are bound.
+*/
+int ConfigBind(const ConfigObject * config, const ConfigBinding * table,
+    void *dst)
+{
+    const ConfigObject **keys;
+    const ConfigObject **values;
+    ConfigObject *probes;
+    const char *prev;
+    const char *s;
+    size_t size;
+    size_t reuse;
+    size_t j;
+    int errors;
+    int n;
+    int k;
+    int i;
+
+    size = 1;
+    for (i = 0; table[i].Path; ++i) {
+	if (size <= strlen(table[i].Path)) {
+	    size = strlen(table[i].Path) + 1;
+	}
+    }
+    // values[d] is the value of the first d keys
+    keys = malloc(size * (2 * sizeof(*keys) + sizeof(*probes) + 1));
+    values = keys + size;
+    probes = (ConfigObject *) (values + size);
+    values[0] = config;
+
+    errors = 0;
+    prev = NULL;
+    // the words are only searched, not interned, this needs no lock
+    for (; table->Path; ++table) {
+	if (!ConfigStrings) {
+	    fprintf(stderr, "core-rc: config '%s' missing\n", table->Path);
+	    ++errors;
+	    continue;
+	}
+	// keep keys and values of the common prefix with the previous path
+	s = table->Path;
+	reuse = 0;
+	n = 0;
+	if (prev) {
+	    for (j = 1, k = 1; s[j] && prev[j - 1] == s[j - 1]; ++j) {
+		if (s[j] == '.' || s[j] == '[') {
+		    if (prev[j] == s[j] || !prev[j]) {
+			reuse = j;
+			n = k;
+		    }
+		    ++k;
+		}
+	    }
+	}
+	prev = NULL;
+	if ((i = ConfigPathParse(s, s + reuse, keys, n, probes,
+		    (char *)(probes + size))) < 0) {
+	    ++errors;
+	    continue;
+	}
+	for (; n < i; ++n) {
+	    values[n + 1] = ConfigIsArray(values[n])
+		? (const ConfigObject *)ObjectArrayGet(values[n],
+		(size_t)keys[n]) : NULL;
+	}
+	errors += ConfigBindStore(values[i], table, dst);
+	prev = s;
+    }
+
+    free(keys);
+    return errors;
+}
+
+#endif
+
+#ifdef USE_CORE_RC_INDEX
+
+///
+///	The path index maps the full path of each value of a config, like
+///	"a.b.c" or "t1[3]", with a minimal perfect hash (compress, hash and
+///	displace) to its value.	 A lookup is one hash of the path, one read
+///	of the displacement of its bucket and one probe of the slot.
+///
+
+    /// maximal depth of indexed paths, stops cycles
+#define PATH_INDEX_MAX_DEPTH 64
+
+    /// average number of keys in a bucket
+#define PATH_INDEX_BUCKET_SIZE 3
+
+/**
+**	Path index slot.
+*/
+typedef struct _path_index_slot_
+{
+    uint64_t Hash;			///< hash of path
+    const char *Path;			///< full path
+    const ConfigObject *Value;		///< value at path
+} PathIndexSlot;
+
+/**
+**	Displacement of path index bucket.
+*/
+typedef struct _path_index_bucket_
+{
+    uint32_t D0;			///< multiplier of second hash
+    uint32_t D1;			///< offset
+} PathIndexBucket;
+
+/**
+**	Path index structure.
+*/
+struct _path_index_
+{
+    size_t N;				///< number of paths and slots
+    size_t BucketN;			///< number of buckets
+    uint64_t Seed;			///< seed of second hash
+    PathIndexBucket *Buckets;		///< displacements of buckets
+    PathIndexSlot *Slots;		///< slots of paths
+    char *Strings;			///< memory of paths
+};
+
+/**
+**	Path index builder.
+*/
+typedef struct _path_index_builder_
+{
+    char *Path;				///< current path
+    size_t PathMax;			///< allocated size of path
+    char *Strings;			///< all paths
+    size_t StringsN;			///< used bytes of paths
+    size_t StringsMax;			///< allocated bytes of paths
+    PathIndexSlot *Slots;		///< paths, offset in path memory
+    size_t SlotN;			///< number of paths
+    size_t SlotMax;			///< allocated paths
+    const ConfigObject *Stack[PATH_INDEX_MAX_DEPTH];	///< arrays of path
+} PathIndexBuilder;
+
+/**
+**	Free path index.
+**
+**	@param index	path index, can be NULL
+*/
+static void PathIndexDel(PathIndex * index)
+{
+    if (index) {
+	free(index->Buckets);
+	free(index->Slots);
+	free(index->Strings);
+	free(index);
+    }
+}
+
+/**
+**	Get bucket of path hash.
+*/
+static inline size_t PathIndexBucketOf(const PathIndex * index, uint64_t hash)
+{
+    return (hash >> 32) % index->BucketN;
+}
+
+/**
+**	Get step of path hash for the displacement multiplier.
+*/
+static inline size_t PathIndexStepOf(const PathIndex * index, uint64_t hash)
+{
+    return StringHashMix(hash ^ STRING_HASH_K1,
+	index->Seed ^ STRING_HASH_K0) % index->N;
+}
+
+/**
+**	Get slot of path hash with displacement.
+*/
+static inline size_t PathIndexSlotOf(const PathIndex * index, uint64_t hash,
+    size_t step, const PathIndexBucket * bucket)
+{
+    return ((uint32_t) hash + (uint64_t) bucket->D0 * step + bucket->D1)
+	% index->N;
+}
+
+/**
+**	Add path and value to path index builder.
+**
+**	@param builder	path index builder
+**	@param len	length of current path
+**	@param value	value at current path
+*/
+static void PathIndexAdd(PathIndexBuilder * builder, size_t len,
+    const ConfigObject * value)
+{
+    PathIndexSlot *slot;
+
+    if (builder->SlotN == builder->SlotMax) {
+	builder->SlotMax = builder->SlotMax ? builder->SlotMax * 2 : 256;
+	builder->Slots =
+	    realloc(builder->Slots, builder->SlotMax * sizeof(*slot));
+    }
+    if (builder->StringsN + len + 1 > builder->StringsMax) {
+	while (builder->StringsN + len + 1 > builder->StringsMax) {
+	    builder->StringsMax =
+		builder->StringsMax ? builder->StringsMax * 2 : 4096;
+	}
+	builder->Strings = realloc(builder->Strings, builder->StringsMax);
+    }
+    slot = builder->Slots + builder->SlotN++;
+    slot->Hash = StringHash(builder->Path, len);
+    slot->Path = (const char *)builder->StringsN;	// offset until done
+    slot->Value = value;
+    memcpy(builder->Strings + builder->StringsN, builder->Path, len + 1);
+    builder->StringsN += len + 1;
+}
+
+/**
+**	Collect all paths of an array.
+**
+**	Keys, which can't be written as path, are skipped: arrays, floats
+**	and words with '.' or '['.
+**
+**	@param builder	path index builder
+**	@param array	array object
+**	@param len	length of path of array
+**	@param depth	depth of array
+*/
+static void PathIndexWalk(PathIndexBuilder * builder,
+    const ConfigObject * array, size_t len, int depth)
+{
+    size_t index;
+    const size_t *value;
+    int i;
+
+    for (i = 0; i < depth; ++i) {	// cyclic config
+	if (builder->Stack[i] == array) {
+	    return;
+	}
+    }
+    builder->Stack[depth] = array;
+
+    index = 0;
+    value = ObjectArrayFirst(array, &index);
+    while (value) {
+	const ConfigObject *key;
+	char buf[CONFIG_STRING_BUFFER];
+	size_t n;
+
+	key = (const ConfigObject *)index;
+	n = 0;
+	if (ConfigIsWord(key)) {
+	    n = ConfigStringLength(key);
+	    if (!n || strpbrk(ConfigString(key, buf), ".[")) {
+		n = 0;
+	    }
+	} else if (ConfigIsFixed(key)) {
+	    n = 24;
+	}
+	if (n) {
+	    if (len + n + 2 > builder->PathMax) {
+		builder->PathMax = (len + n + 2) * 2;
+		builder->Path = realloc(builder->Path, builder->PathMax);
+	    }
+	    if (ConfigIsWord(key)) {
+		char *s;
+
+		s = builder->Path + len;
+		if (len) {
+		    *s++ = '.';
+		}
+		memcpy(s, ConfigString(key, buf), n + 1);
+		n += s - builder->Path;
+	    } else {
+		n = len + sprintf(builder->Path + len, "[%zd]",
+		    ConfigInteger(key));
+	    }
+	    PathIndexAdd(builder, n, (const ConfigObject *)*value);
+	    if (ConfigIsArray((const ConfigObject *)*value)
+		&& depth + 1 < PATH_INDEX_MAX_DEPTH) {
+		PathIndexWalk(builder, (const ConfigObject *)*value, n,
+		    depth + 1);
+	    }
+	}
+	value = ObjectArrayNext(array, &index);
+    }
+}
+
+/**
+**	Find displacements of all buckets.
+**
+**	Buckets are placed biggest first.  For each bucket the displacements
+**	are tried until all its paths get free slots.  Buckets with a single
+**	path are displaced directly to the next free slot.
+**
+**	@param index	path index with slots of paths
+**	@param paths	paths, will be placed into index slots
+**
+**	@returns true if all buckets are placed.
+*/
+static int PathIndexPlace(PathIndex * index, const PathIndexSlot * paths)
+{
+    size_t *start;
+    size_t *keys;
+    size_t *fill;
+    size_t *count;
+    size_t *order;
+    size_t *slots;
+    size_t *steps;
+    uint8_t *taken;
+    size_t next;
+    size_t i;
+    size_t j;
+    size_t k;
+    size_t b;
+    size_t max;
+    int done;
+
+    // counting sort of paths by bucket
+    start = calloc(index->BucketN + 1, sizeof(*start));
+    for (i = 0; i < index->N; ++i) {
+	++start[PathIndexBucketOf(index, paths[i].Hash) + 1];
+    }
+    max = 0;
+    for (b = 0; b < index->BucketN; ++b) {
+	if (start[b + 1] > max) {
+	    max = start[b + 1];
+	}
+	start[b + 1] += start[b];
+    }
+    keys = malloc(index->N * sizeof(*keys));
+    steps = malloc(index->N * sizeof(*steps));
+    fill = calloc(index->BucketN, sizeof(*fill));
+    for (i = 0; i < index->N; ++i) {
+	b = PathIndexBucketOf(index, paths[i].Hash);
+	keys[start[b] + fill[b]] = i;
+	steps[start[b] + fill[b]++] = PathIndexStepOf(index, paths[i].Hash);
+    }
+
+    // counting sort of buckets by size, biggest first
+    memset(fill, 0, index->BucketN * sizeof(*fill));
+    count = calloc(max + 2, sizeof(*count));
+    for (b = 0; b < index->BucketN; ++b) {
+	++count[max - (start[b + 1] - start[b]) + 1];
+    }
+    for (i = 0; i <= max; ++i) {
+	count[i + 1] += count[i];
+    }
+    order = malloc(index->BucketN * sizeof(*order));
+    for (b = 0; b < index->BucketN; ++b) {
+	order[count[max - (start[b + 1] - start[b])]++] = b;
+    }
+    free(count);
+    free(fill);
+    slots = malloc(max * sizeof(*slots));
+
+    taken = calloc(index->N, 1);
+    next = 0;
+    done = 1;
+    for (i = 0; i < index->BucketN && done; ++i) {
+	PathIndexBucket *bucket;
+	size_t n;
+
+	b = order[i];
+	n = start[b + 1] - start[b];
+	if (!n) {
+	    break;			// all other buckets are empty
+	}
+	bucket = index->Buckets + b;
+	if (n == 1) {			// single path: take next free slot
+	    while (taken[next]) {
+		++next;
+	    }
+	    slots[0] = next;
+	    bucket->D1 = (next + index->N
+		- (uint32_t) paths[keys[start[b]]].Hash % index->N) % index->N;
+	    goto placed;
+	}
+	for (bucket->D0 = 0; bucket->D0 < 64; ++bucket->D0) {
+	    for (bucket->D1 = 0; bucket->D1 < index->N; ++bucket->D1) {
+		for (j = 0; j < n; ++j) {
+		    slots[j] = PathIndexSlotOf(index,
+			paths[keys[start[b] + j]].Hash, steps[start[b] + j],
+			bucket);
+		    if (taken[slots[j]]) {
+			break;
+		    }
+		    for (k = 0; k < j && slots[k] != slots[j]; ++k) {
+		    }
+		    if (k < j) {
+			break;
+		    }
+		}
+		if (j == n) {
+		    goto placed;
+		}
+	    }
+	}
+	done = 0;			// give up, try another seed
+	break;
+
+      placed:
+	for (j = 0; j < n; ++j) {
+	    taken[slots[j]] = 1;
+	    index->Slots[slots[j]] = paths[keys[start[b] + j]];
+	}
+    }
+
+    free(taken);
+    free(order);
+    free(slots);
+    free(steps);
+    free(keys);
+    free(start);
+    return done;
+}
+
+/**
+**	Build index of all full paths of config.
+**
+**	Afterwards ConfigGetByPath() finds each value with one hash and one
+**	probe, independent of the depth of the path.  The index is freed
+**	with the config and dropped by ConfigDefine().
+**
+**	@param config	configuration loaded
+**
+**	@returns true if index is built.
+*/
+int ConfigBuildPathIndex(Config * config)
+{
+    PathIndexBuilder builder;
+    PathIndex *index;
+    size_t i;
+
+    PathIndexDel(config->Arena->Index);
+    config->Arena->Index = NULL;
+
+    memset(&builder, 0, sizeof(builder));
+    builder.PathMax = 256;
+    builder.Path = malloc(builder.PathMax);
+    builder.Path[0] = '\0';
+    if (ConfigIsArray(ConfigDict(config))) {
+	PathIndexWalk(&builder, ConfigDict(config), 0, 0);
+    }
+    free(builder.Path);
+
+    index = calloc(1, sizeof(*index));
+    index->N = builder.SlotN;
+    index->BucketN = index->N / PATH_INDEX_BUCKET_SIZE + 1;
+    index->Buckets = calloc(index->BucketN, sizeof(*index->Buckets));
+    index->Slots = calloc(index->N, sizeof(*index->Slots));
+    index->Strings = builder.Strings;
+    for (i = 0; i < builder.SlotN; ++i) {
+	builder.Slots[i].Path = builder.Strings + (size_t)builder.Slots[i].Path;
+    }
+
+    while (index->N && !PathIndexPlace(index, builder.Slots)) {
+	if (++index->Seed == 16) {
+	    fprintf(stderr, "core-rc: can't build path index\n");
+	    free(builder.Slots);
+	    PathIndexDel(index);
+	    return 0;
+	}
+	memset(index->Buckets, 0, index->BucketN * sizeof(*index->Buckets));
+    }
+    free(builder.Slots);
+
+    config->Arena->Index = index;
+    return 1;
+}
+
+/**
+**	Get config object by full path.
+**
+**	Uses the index of ConfigBuildPathIndex(), the path must be written
+**	like the index does: words separated by '.', integer keys as "[n]".
+**	Without index the path is found with ConfigPathFind(), without lock
+**	and without interning its words.
+**
+**	@param config	configuration loaded
+**	@param path	full path of value
+**
+**	@returns object stored at path, NULL if not found.
+*/
+const ConfigObject *ConfigGetByPath(const Config * config, const char *path)
+{
+    const PathIndex *index;
+    const PathIndexSlot *slot;
+    uint64_t hash;
+
+    if (!(index = config->Arena->Index)) {
+	return ConfigPathFind(ConfigDict(config), path);
+    }
+    if (!index->N) {
+	return NULL;
+    }
+    hash = StringHash(path, strlen(path));
+    slot = index->Slots + PathIndexSlotOf(index, hash,
+	PathIndexStepOf(index, hash),
+	index->Buckets + PathIndexBucketOf(index, hash));
+    if (slot->Hash == hash && !strcmp(slot->Path, path)) {
+	return slot->Value;
+    }
+    return NULL;
+}
+
+#endif
+
+/**
+**	Get value from config array.
+**
+**	@param array	config array value, can be any value
+**	@param index	config index value
+**
+**	@returns value stored in array at index, NULL if array isn't an
+**	array or has no value at index.
+*/
+const ConfigObject *ConfigArrayGet(const ConfigObject * array,
+    const ConfigObject * index)
+{
+    if (!ConfigIsArray(array)) {
+	return NULL;
+    }
+    return (const ConfigObject *)ObjectArrayGet(array, (size_t)index);
+}
+
+/**
+**	Get value from config array by position.
+**
+**	Lists are stored as vector arrays, for them this is O(1).  Other
+**	arrays are searched for the integer key @a i.
+**
+**	@param array	config array value, can be any value
+**	@param i	position in list
+**
+**	@returns value stored in array at key i, NULL if array isn't an
+**	array or has no value at key i.
+*/
+const ConfigObject *ConfigArrayAt(const ConfigObject * array, size_t i)
+{
+    const VectorArray *vector;
+
+    if (!ConfigIsArray(array)) {
+	return NULL;
+    }
+    if (ConfigArrayKind(array) == CONFIG_ARRAY_VECTOR) {
+	vector = ConfigVector(array);
+	return i < vector->N ? (const ConfigObject *)vector->Values[i] : NULL;
+    }
+    return (const ConfigObject *)ObjectArrayGet(array,
+	(size_t)ConfigNewInteger(i));
+}
+
+/**
+**	Get number of items of config array.
+**
+**	O(1) for lists, mapped and persistent arrays, other arrays are
+**	counted.
+**
+**	@param array	config array value, can be any value
+**
+**	@returns number of keys of array, 0 if array isn't an array.
+*/
+size_t ConfigArrayLength(const ConfigObject * array)
+{
+    if (!ConfigIsArray(array)) {
+	return 0;
+    }
+    switch (ConfigArrayKind(array)) {
+	case CONFIG_ARRAY_VECTOR:
+	    return ConfigVector(array)->N;
+	case CONFIG_ARRAY_FROZEN:
+	    return ConfigFrozen(array)->N;
+	case CONFIG_ARRAY_PARTS:
+	    return CoreArrayLength(ConfigParts(array)->Fixed)
+		+ CoreArrayLength(ConfigParts(array)->Named);
+#ifdef USE_CORE_RC_PERSISTENT
+	case CONFIG_ARRAY_HAMT:
+	    return ConfigHamt(array)->N;
+#endif
+    }
+    return CoreArrayLength(array->Pointer);
+}
+
+/**
+**	Get first value from config array.
+**
+**	Search (inclusive) for the first index that is equal to or greater
+**	than index.
+**
+**	@param array		config array value
+**	@param[in,out] index	config index value
+*/
+const ConfigObject *ConfigArrayFirst(const ConfigObject * array,
+    const ConfigObject ** index)
+{
+    const size_t *value;
+    size_t key;
+
+    key = (size_t)*index;
+    value = ObjectArrayFirst(array, &key);
+    *index = (const ConfigObject *)key;
+    return value ? (const ConfigObject *)*value : NULL;
+}
+
+/**
+**	Get next value from config array.
+**
+**	Search (exclusive) for the next index that is greater than index.
+**
+**	@param array		config array value
+**	@param[in,out] index	config index value
+*/
+const ConfigObject *ConfigArrayNext(const ConfigObject * array,
+    const ConfigObject ** index)
+{
+    const size_t *value;
+    size_t key;
+
+    key = (size_t)*index;
+    value = ObjectArrayNext(array, &key);
+    *index = (const ConfigObject *)key;
+    return value ? (const ConfigObject *)*value : NULL;
+}
+
+/**
+**	Get first value with integer key from config array.
+**
+**	Search (inclusive) for the first index that is equal to or greater
+**	than index.  Only the integer keys of the array are searched.
+**
+**	@param array		config array value
+**	@param[in,out] index	config index value
+*/
+const ConfigObject *ConfigArrayFirstFixedKey(const ConfigObject * array,
+    const ConfigObject ** index)
+{
+    const size_t *value;
+    size_t key;
+
+    key = (size_t)*index;
+    value = ObjectArraySeekKey(array, &key, 0, 0);
+    *index = (const ConfigObject *)key;
+    return value ? (const ConfigObject *)*value : NULL;
+}
+
+/**
+**	Get next value with integer key from config array.
+**
+**	Search (exclusive) for the next index that is greater than index.
+**	Only the integer keys of the array are searched.
+**
+**	@param array		config array value
+**	@param[in,out] index	config index value
+*/
+const ConfigObject *ConfigArrayNextFixedKey(const ConfigObject * array,
+    const ConfigObject ** index)
+{
+    const size_t *value;
+    size_t key;
+
+    key = (size_t)*index;
+    value = ObjectArraySeekKey(array, &key, 0, 1);
+    *index = (const ConfigObject *)key;
+    return value ? (const ConfigObject *)*value : NULL;
+}
+
+/**
+**	Get first value with string key from config array.
+**
+**	Search (inclusive) for the first index that is equal to or greater
+**	than index.  Only the string keys of the array are searched.
+**
+**	@param array		config array value
+**	@param[in,out] index	config index value
+*/
+const ConfigObject *ConfigArrayFirstStringKey(const ConfigObject * array,
+    const ConfigObject ** index)
+{
+    const size_t *value;
+    size_t key;
+
+    key = (size_t)*index;
+    value = ObjectArraySeekKey(array, &key, 1, 0);
+    *index = (const ConfigObject *)key;
+    return value ? (const ConfigObject *)*value : NULL;
+}
+
+/**
+**	Get next value with string key from config array.
+**
+**	Search (exclusive) for the next index that is greater than index.
+**	Only the string keys of the array are searched.
+**
+**	@param array		config array value
+**	@param[in,out] index	config index value
+*/
+const ConfigObject *ConfigArrayNextStringKey(const ConfigObject * array,
+    const ConfigObject ** index)
+{
+    const size_t *value;
+    size_t key;
+
+    key = (size_t)*index;
+    value = ObjectArraySeekKey(array, &key, 1, 1);
+    *index = (const ConfigObject *)key;
+    return value ? (const ConfigObject *)*value : NULL;
+}
+
+#if defined(USE_CORE_RC_PRINT) || defined(USE_CORE_RC_WRITE)
+
+/**
+**	Print config object.
+**
+**	@param object	tagged object pointer
+**	@param level	indent level
+**	@param out	output stream
+**
+**	@todo this is nice print, but no beautifier yet.
+*/
+void ConfigPrint(const ConfigObject * object, int level, FILE * out)
+{
+    char buf[CONFIG_STRING_BUFFER];
+
+    if (!object) {
+	printf("nil");
+	return;
+    }
+    if (ConfigIsFixed(object)) {
+	fprintf(out, "%zd", ConfigInteger(object));
+    } else if (ConfigIsFloat(object)) {
+	fprintf(out, "%.1g", ConfigDouble(object));
+    } else if (ConfigIsWord(object)) {
+	fprintf(out, "\"%s\"", ConfigString(object, buf));
+    } else {
+	size_t index;
+	const size_t *value;
+
+	index = 0;
+	value = ObjectArrayFirst(object, &index);
+	if (value) {
+	    fprintf(out, "[;%p\n", object);
+	    while (value) {
+		const ConfigObject *lvalue;
+
+		//
+		//	string
+		//
+		lvalue = (const ConfigObject *)index;
+		// FIXME: must check if word contains only a-zA-Z0-9_-
+		if (ConfigIsWord(lvalue)) {
+		    fprintf(out, "%*s%s = ", level, "", ConfigString(lvalue,
+			    buf));
+		} else {
+		    fprintf(out, "%*s[", level, "");
+		    ConfigPrint(lvalue, level + 2, out);
+		    fprintf(out, "] = ");
+		}
+
+		ConfigPrint((const ConfigObject *)*value, level + 4, out);
+		fprintf(out, "\n");
+
+		value = ObjectArrayNext(object, &index);
+	    }
+	    fprintf(out, "%*s]", level < 2 ? 0 : level - 2, "");
+	} else {			// empty array
+	    fprintf(out, "[];%p", object);
+	}
+    }
+}
+#endif
+
+// ------------------------------------------------------------------------ //
+// Config file parser
+// ------------------------------------------------------------------------ //
+
+///
+///	@defgroup parse The parse module.
+///
+///	This module handles parsing of config file.
+///
+/// @{
+
+/**
+**	Parse open file stack typedef.
+*/
+typedef struct _parse_file_stack_ ParseFileStack;
+
+#ifdef USE_CORE_RC_PARALLEL
+
+/**
+**	Parse include files of worker threads typedef.
+*/
+typedef struct _parse_jobs_ ParseJobs;
+
+#endif
+
+/**
+**	Parse open file stack structure.
+*/
+struct _parse_file_stack_
+{
+    const char *Name;			///< previous file name
+    FILE *File;				///< previous file stream
+    int LineNr;				///< previous line number
+};
+
+/**
+**	Config parser structure.
+**
+**	All state of the parser is kept here.  Independent configs can be
+**	parsed in parallel by different threads, each with its own parser.
+*/
+struct _config_parser_
+{
+    struct _yycontext *Yy;		///< peg parser generator context
+
+    const char *Name;			///< current file name
+    FILE *File;				///< current file stream
+    const char *Input;			///< current memory input, NULL: File
+    const char *InputEnd;		///< end of memory input
+    int LineNr;				///< current line number
+
+    ConfigObject **Stack;		///< parser stack
+    int SP;				///< parser stack pointer
+    int StackSize;			///< parser stack size
+
+    StringPool *Strings;		///< strings of parsed config
+    int PrivateStrings;			///< strings are merged after parse
+    ConfigArena *Arena;			///< arena of parsed config
+    Array *GlobalArray;			///< global array
+    Array *CurrentArray;		///< current array
+    int CurrentIndex;			///< current array index
+    Array **CurrentLvalue;		///< current lvalue
+
+    ConfigArena *Root;			///< arena of config
+#ifdef USE_CORE_RC_RELOAD
+    int Track;				///< record fragments of config
+    int Depth;				///< include depth
+    int Top;				///< next lvalue is top-level key
+    ConfigFragment *Fragment;		///< current fragment
+    uint64_t Hash;			///< hash of current file
+#endif
+#ifdef USE_CORE_RC_DESCENT
+    int Descent;			///< use descent parser
+    char *Text;				///< descent parser text buffer
+    size_t TextSize;			///< size of text buffer
+#endif
+#ifdef USE_CORE_RC_PARALLEL
+    int Threads;			///< threads parsing include files
+    ParseJobs *Jobs;			///< include files parsed by threads
+    int Worker;				///< worker thread, log assigns
+    int Fallback;			///< worker: parse file again in order
+    const ConfigObject **Log;		///< assign log of worker
+    size_t LogN;			///< number of log entries
+    size_t LogMax;			///< allocated log entries
+    size_t LogStart;			///< log entry of current assign
+#endif
+};
+
+#ifdef USE_CORE_RC_PARALLEL
+
+///
+///	Include files of the main file are parsed by worker threads.  A
+///	worker logs the assigns of its file instead of doing them, the log
+///	is replayed in source order when the main file reaches the include.
+///	The worker collects strings and arrays in a private string pool and
+///	arena.	Its strings are merged into the pool of the main parser by
+///	the worker, under the lock of the jobs.	 Files which read variables
+///	or print messages are parsed again in order.
+///
+
+/**
+**	Include file parsed by a worker thread.
+*/
+typedef struct _parse_job_
+{
+    char *Name;				///< include file name
+    int Done;				///< worker has finished
+    int Fallback;			///< parse file again in order
+    ConfigArena *Root;			///< arena of include file
+    const ConfigObject **Log;		///< assign log
+    size_t LogN;			///< number of log entries
+} ParseJob;
+
+/**
+**	Include files of the main file parsed by worker threads.
+*/
+struct _parse_jobs_
+{
+    char *Name;				///< main file name
+#ifdef USE_CORE_RC_RELOAD
+    int Track;				///< record fragments of config
+#endif
+    StringPool *Strings;		///< string pool of main parser
+    ParseJob *Jobs;			///< include files in source order
+    int JobN;				///< number of include files
+    int Taken;				///< next include file for workers
+    int Next;				///< next include file to replay
+    int Nested;				///< depth of in order includes
+    pthread_mutex_t Lock;		///< lock of done flags and strings
+    pthread_cond_t Cond;		///< signals finished include files
+    pthread_t *Threads;			///< worker threads
+    int ThreadN;			///< number of worker threads
+};
+
+#endif
+
+    /// parse recursive file
+static void ParseRecursive(ConfigParser *, const char *);
+
+#ifdef USE_CORE_RC_PARALLEL
+    /// parse include file of main file
+static void ParseJobsInclude(ConfigParser *, const char *);
+#endif
+
+/**
+**	Check if parser messages must be suppressed.
+**
+**	Workers print no messages, their file is parsed again in order.
+**
+**	@param parser	config parser
+**
+**	@returns true if the message must not be printed.
+*/
+static inline int ParseQuiet(ConfigParser * parser)
+{
+#ifdef USE_CORE_RC_PARALLEL
+    if (parser->Worker) {
+	parser->Fallback = 1;
+	return 1;
+    }
+#endif
+    (void)parser;
+    return 0;
+}
+
+#ifdef never_DEBUG_CORE_RC
+
+/**
+**	Print debug about object.
+**
+**	@param object	config object
+*/
+static void ParseDebug(const ConfigObject * object)
+{
+    char buf[CONFIG_STRING_BUFFER];
+
+    if (!object) {
+	printf("nil");
+	return;
+    }
+    if (ConfigIsFixed(object)) {
+	printf("fixed(%zd)", ConfigInteger(object));
+    } else if (ConfigIsFloat(object)) {
+	printf("float(%.1g)", ConfigDouble(object));
+    } else if (ConfigIsWord(object)) {
+	printf("word(%s)", ConfigString(object, buf));
+    } else {
+	printf("array(%p)", object);
+    }
+}
+
+/**
+**	Print a parser object
+**
+**	@param object	config object
+*/
+static void ParsePrint(const ConfigObject * object)
+{
+    char buf[CONFIG_STRING_BUFFER];
+
+    if (!object) {
+	printf("nil");
+	return;
+    }
+    if (ConfigIsFixed(object)) {
+	printf("%zd", ConfigInteger(object));
+    } else if (ConfigIsFloat(object)) {
+	printf("%.1g", ConfigDouble(object));
+    } else if (ConfigIsWord(object)) {
+	printf("\"%s\"", ConfigString(object, buf));
+    } else {
+	printf("[=%p]", object);
+    }
+}
+
+/**
+**	Dump parsed config
+**
+**	@param array	config main array
+**	@param level	indent level
+**
+**	@todo nil? detect recursive structures and cycles
+*/
+static void ParseDump(const Array * array, int level)
+{
+    size_t index;
+    size_t *value;
+
+    index = 0;
+    value = ArrayFirst(array, &index);
+    while (value) {
+	const ConfigObject *object;
+
+	printf("%*s[", level, "");
+	ParsePrint((const ConfigObject *)index);
+	printf("] = ");
+	object = (const ConfigObject *)*value;
+	if (ConfigIsArray(object)) {
+	    printf("[\n");
+	    ParseDump(ConfigArray(object), level + 4);
+	    printf("%*s]\n", level, "");
+	} else {
+	    ParsePrint(object);
+	    printf("\n");
+	}
+
+	value = ArrayNext(array, &index);
+    }
+}
+#endif
+
+/**
+**	Pop object from parser stack.
+**
+**	@param parser	config parser
+**
+**	@returns	top config object on parser stack
+*/
+static ConfigObject *ParsePop(ConfigParser * parser)
+{
+    if (!parser->SP) {
+	fprintf(stderr, "internal error no objects on stack\n");
+	return NULL;
+    }
+    return parser->Stack[--parser->SP];
+}
+
+/**
+**	Push object on parser stack.
+**
+**	@param parser	config parser
+**	@param object	config object
+*/
+static void ParsePush(ConfigParser * parser, const ConfigObject * object)
+{
+    if (parser->SP + 1 == parser->StackSize) {	// reach stack end
+	parser->StackSize += 8;
+	parser->Stack = realloc(parser->Stack,
+	    parser->StackSize * sizeof(ConfigObject *));
+    }
+    parser->Stack[parser->SP++] = (ConfigObject *) object;
+}
+
+/**
+**	Push integer.
+**
+**	@param parser	config parser
+**	@param val	push val as integer object on value stack
+*/
+static void ParsePushI(ConfigParser * parser, ssize_t val)
+{
+    ParsePush(parser, ConfigNewInteger(val));
+}
+
+/**
+**	Push double float.
+**
+**	@param parser	config parser
+**	@param val	push val as floating point object on value stack
+*/
+static void ParsePushF(ConfigParser * parser, double val)
+{
+    ParsePush(parser, ConfigNewDouble(val));
+}
+
+/**
+**	Push string.
+**
+**	@param parser	config parser
+**	@param val	push val as string object on value stack
+*/
+static void ParsePushS(ConfigParser * parser, const char *val)
+{
+#ifdef USE_CORE_RC_PARALLEL
+    if (parser->Jobs) {			// workers merge their strings
+	ConfigObject *object;
+
+	pthread_mutex_lock(&parser->Jobs->Lock);
+	object = StringPoolIntern(parser->Strings, val);
+	pthread_mutex_unlock(&parser->Jobs->Lock);
+	ParsePush(parser, object);
+	return;
+    }
+#endif
+    ParsePush(parser, StringPoolIntern(parser->Strings, val));
+}
+
+/**
+**	Push array.
+**
+**	@param parser	config parser
+**	@param val	push val as array object on value stack, lists are
+**			converted to vector arrays
+*/
+static void ParsePushA(ConfigParser * parser, Array * val)
+{
+    ParsePush(parser, ArenaNewArray(parser->Arena, ArrayChooseKind(val)));
+}
+
+/**
+**	Push nil.
+**
+**	@param parser	config parser
+*/
+static void ParsePushNil(ConfigParser * parser)
+{
+    ParsePush(parser, NULL);
+}
+
+/**
+**	Parse include statement.
+**
+**	@param parser	config parser
+**	@param file	include file name
+*/
+static void ParseInclude(ConfigParser * parser, const ConfigObject * file)
+{
+    char buf[CONFIG_STRING_BUFFER];
+    const char *filename;
+
+    filename = ConfigString(file, buf);
+#ifdef DEBUG_CORE_RC
+    printf("Must include '%s'\n", filename);
+#endif
+#ifdef USE_CORE_RC_PARALLEL
+    if (parser->Jobs) {
+	ParseJobsInclude(parser, filename);
+	return;
+    }
+#endif
+    ParseRecursive(parser, filename);
+}
+
+#ifdef USE_CORE_RC_PARALLEL
+
+/**
+**	Add object to assign log of worker.
+**
+**	@param parser	config parser of worker
+**	@param object	config object
+*/
+static void ParseLogAdd(ConfigParser * parser, const ConfigObject * object)
+{
+    if (parser->LogN == parser->LogMax) {
+	parser->LogMax = parser->LogMax ? parser->LogMax * 2 : 64;
+	parser->Log =
+	    realloc(parser->Log, parser->LogMax * sizeof(*parser->Log));
+    }
+    parser->Log[parser->LogN++] = object;
+}
+
+#endif
+
+/**
+**	Generate store into array.
+**
+**	@param parser	config parser
+**	@param index	index key into array
+**	@param value	value stored into array
+*/
+static void ParseArrayAddItem(ConfigParser * parser,
+    const ConfigObject * index, const ConfigObject * value)
+{
+#ifdef never_DEBUG_CORE_RC
+    printf("add %p:", index);
+    ParseDebug(index);
+    printf("=%p:", value);
+    ParseDebug(value);
+    printf("\n");
+#endif
+    if (ConfigIsFixed(index)) {
+	parser->CurrentIndex = ConfigInteger(index) + 1;
+
+    }
+#ifdef DEBUG_CORE_RC
+    if (*ArrayIns(&parser->CurrentArray, (size_t)index, (size_t)value)
+	!= (size_t)value) {
+	fprintf(stderr, "assign error\n");
+    }
+#else
+    ArrayIns(&parser->CurrentArray, (size_t)index, (size_t)value);
+#endif
+}
+
+/**
+**	Generate store into next index of array.
+**
+**	@param parser	config parser
+**	@param value	value stored into array
+**
+**	@note CurrentIndex is incremented in ParseArrayAddItem.
+*/
+static void ParseArrayNextItem(ConfigParser * parser,
+    const ConfigObject * value)
+{
+    ParseArrayAddItem(parser, ConfigNewInteger(parser->CurrentIndex), value);
+}
+
+/**
+**	Prepare new array.
+**
+**	The outer array is stacked untagged, no object is needed.
+**
+**	@param parser	config parser
+*/
+static void ParseArrayStart(ConfigParser * parser)
+{
+    ParsePush(parser, (const ConfigObject *)parser->CurrentArray);
+    ParsePushI(parser, parser->CurrentIndex);
+
+    parser->CurrentArray = ArrayNew();
+    parser->CurrentIndex = 0;
+}
+
+/**
+**	Finish array.
+**
+**	@param parser	config parser
+*/
+static void ParseArrayFinal(ConfigParser * parser)
+{
+    ConfigObject *object;
+    Array *array;
+
+    object = ParsePop(parser);
+    if (!object || !ConfigIsFixed(object)) {
+	fprintf(stderr, "internal error\n");
+	exit(-1);
+    }
+    parser->CurrentIndex = ConfigInteger(object);
+
+    array = (Array *) ParsePop(parser);	// untagged outer array
+
+    ParsePushA(parser, parser->CurrentArray);
+
+    parser->CurrentArray = array;
+}
+
+/**
+**	Generate start of lvalue.
+**
+**	@param parser	config parser
+*/
+static void ParseLvalue(ConfigParser * parser)
+{
+#ifdef USE_CORE_RC_PARALLEL
+    if (parser->Worker) {		// number of keys is set by assign
+	parser->LogStart = parser->LogN;
+	ParseLogAdd(parser, NULL);
+	return;
+    }
+#endif
+    parser->CurrentLvalue = &parser->CurrentArray;
+#ifdef USE_CORE_RC_RELOAD
+    parser->Top = 1;
+#endif
+}
+
+#ifdef USE_CORE_RC_RELOAD
+
+/**
+**	Remember top-level key written by current fragment.
+**
+**	@param parser	config parser
+**	@param index	first index of lvalue
+*/
+static void ParseTopKey(ConfigParser * parser, const ConfigObject * index)
+{
+    if (parser->Top) {
+	if (parser->Fragment) {
+	    ArrayIns(&parser->Fragment->Keys, (size_t)index, 1);
+	}
+	parser->Top = 0;
+    }
+}
+
+#endif
+
+/**
+**	Get value of lvalue array.
+**
+**	@param array	tagged pointer of core, vector or parts array
+**	@param index	tagged key
+**
+**	@returns tagged value, 0 if not found.
+*/
+static size_t ParseArrayGet(const Array * array, size_t index)
+{
+    const VectorArray *vector;
+    const PartsArray *parts;
+    size_t i;
+
+    switch ((size_t)array & 7) {
+	case CONFIG_ARRAY_VECTOR:
+	    vector = (const VectorArray *)((size_t)array & ~7);
+	    i = VectorPosition(index);
+	    return i < vector->N && index == (size_t)ConfigNewInteger(i)
+		? vector->Values[i] : 0;
+	case CONFIG_ARRAY_PARTS:
+	    parts = (const PartsArray *)((size_t)array & ~7);
+	    return ArrayGet(ConfigIsFixed((const ConfigObject *)index)
+		? parts->Fixed : parts->Named, index);
+    }
+    return ArrayGet(array, index);
+}
+
+/**
+**	Insert into lvalue array.
+**
+**	A vector array is extended by its next key.  Another integer key
+**	promotes it to a core array, any other key to a parts array.
+**
+**	@param array	pointer to tagged pointer of core, vector or parts
+**			array
+**	@param index	tagged key
+**	@param value	tagged value
+**
+**	@returns pointer to value, the old value if key was already used.
+*/
+static size_t *ParseArrayIns(Array ** array, size_t index, size_t value)
+{
+    VectorArray *vector;
+    PartsArray *parts;
+    size_t i;
+
+    switch ((size_t)*array & 7) {
+	case CONFIG_ARRAY_VECTOR:
+	    break;
+	case CONFIG_ARRAY_PARTS:
+	    parts = (PartsArray *) ((size_t)*array & ~7);
+	    return ArrayIns(ConfigIsFixed((const ConfigObject *)index)
+		? &parts->Fixed : &parts->Named, index, value);
+	default:
+	    return ArrayIns(array, index, value);
+    }
+    vector = (VectorArray *) ((size_t)*array & ~7);
+    i = VectorPosition(index);
+    if (i <= vector->N && index == (size_t)ConfigNewInteger(i)) {
+	if (i == vector->N) {
+	    vector = realloc(vector,
+		sizeof(*vector) + (i + 1) * sizeof(*vector->Values));
+	    vector->Values[vector->N++] = value;
+	    *array = (Array *) ((size_t)vector | CONFIG_ARRAY_VECTOR);
+	}
+	return &vector->Values[i];
+    }
+    if (ConfigIsFixed((const ConfigObject *)index)) {
+	*array = VectorToArray(vector);
+	return ArrayIns(array, index, value);
+    }
+    parts = malloc(sizeof(*parts));
+    parts->Fixed = VectorToArray(vector);
+    parts->Named = ArrayNew();
+    *array = (Array *) ((size_t)parts | CONFIG_ARRAY_PARTS);
+    return ArrayIns(&parts->Named, index, value);
+}
+
+/**
+**	Generate assign operator
+**
+**	@param parser	config parser
+**	@param index	lvalue
+**	@param value	value associated with index
+*/
+static void ParseAssign(ConfigParser * parser, const ConfigObject * index,
+    const ConfigObject * value)
+{
+    const ConfigObject **vp;
+
+#ifdef never_DEBUG_CORE_RC
+    printf("assign %p:", index);
+    ParseDebug(index);
+    printf("=%p:", value);
+    ParseDebug(value);
+    printf("\n");
+#endif
+#ifdef USE_CORE_RC_PARALLEL
+    if (parser->Worker) {
+	ParseLogAdd(parser, index);
+	ParseLogAdd(parser, value);
+	parser->Log[parser->LogStart] =
+	    ConfigNewInteger(parser->LogN - parser->LogStart - 2);
+	return;
+    }
+#endif
+#ifdef USE_CORE_RC_RELOAD
+    ParseTopKey(parser, index);
+#endif
+    if (*parser->CurrentLvalue == parser->GlobalArray) {
+	vp = (const ConfigObject **)ArrayIns(parser->CurrentLvalue,
+	    (size_t)index, (size_t)value);
+	parser->GlobalArray = *parser->CurrentLvalue;
+    } else {
+	vp = (const ConfigObject **)ParseArrayIns(parser->CurrentLvalue,
+	    (size_t)index, (size_t)value);
+    }
+    if (*vp != value) {
+	// FIXME: value already set, loose memory! cycles!
+	printf("need to overwrite old value\n");
+	*vp = value;
+    }
+}
+
+/**
+**	Generate dot operator
+**
+**	@param parser	config parser
+**	@param global	lvalue
+**	@param index	select index of global lvalue
+*/
+static void ParseDot(ConfigParser * parser, const ConfigObject * global,
+    const ConfigObject * index)
+{
+    ConfigObject *value;
+
+#ifdef never_DEBUG_CORE_RC
+    printf("dot %p:", global);
+    ParseDebug(global);
+
+    printf(",%p:", index);
+    ParseDebug(index);
+    printf("\n");
+#endif
+
+#ifdef USE_CORE_RC_PARALLEL
+    if (parser->Worker) {
+	ParseLogAdd(parser, global);
+	ParsePush(parser, index);
+	return;
+    }
+#endif
+#ifdef USE_CORE_RC_RELOAD
+    ParseTopKey(parser, global);
+#endif
+    value =
+	(ConfigObject *) ParseArrayGet(*parser->CurrentLvalue,
+	(size_t)global);
+
+    if (!value) {
+	value = ArenaNewArray(parser->Arena, ArrayNew());
+	if (*parser->CurrentLvalue == parser->GlobalArray) {
+	    ArrayIns(parser->CurrentLvalue, (size_t)global, (size_t)value);
+
+	    parser->GlobalArray = *parser->CurrentLvalue;
+	} else {
+	    ParseArrayIns(parser->CurrentLvalue, (size_t)global,
+		(size_t)value);
+	}
+
+    } else if (!ConfigIsArray(value)) {
+	fprintf(stderr, "lvalue required\n");
+	ParsePush(parser, index);
+	return;
+    }
+    parser->CurrentLvalue = (Array **) & value->Pointer;
+
+    ParsePush(parser, index);
+}
+
+/**
+**	Generate string .
+**
+**	Concat the strings.
+**
+**	@param parser	config parser
+**	@param o1	string object
+**	@param o2	strong object
+*/
+static void ParseStringCat(ConfigParser * parser, const ConfigObject * o1,
+    const ConfigObject * o2)
+{
+    size_t l1;
+    size_t l2;
+    char *buf;
+    char tmp[2][CONFIG_STRING_BUFFER];
+
+    if (!ConfigIsWord(o1) || !ConfigIsWord(o2)) {
+	if (!ParseQuiet(parser)) {
+	    fprintf(stderr, "wrong types for string-cat operator\n");
+	}
+	ParsePushS(parser, "error");
+	return;
+    }
+    l1 = ConfigStringLength(o1);
+    l2 = ConfigStringLength(o2);
+
+    buf = alloca(l1 + l2 + 1);
+    memcpy(buf, ConfigString(o1, tmp[0]), l1);
+    memcpy(buf + l1, ConfigString(o2, tmp[1]), l2 + 1);
+    ParsePushS(parser, buf);
+}
+
+/**
+**	Generate variable.
+**
+**	@param parser	config parser
+**	@param v	variable name
+*/
+static void ParseVariable(ConfigParser * parser, const ConfigObject * v)
+{
+    const ConfigObject *value;
+    char buf[CONFIG_STRING_BUFFER];
+
+#ifdef USE_CORE_RC_PARALLEL
+    if (parser->Worker) {		// value depends on statements before
+	parser->Fallback = 1;
+	ParsePush(parser, NULL);
+	return;
+    }
+#endif
+#ifdef USE_CORE_RC_RELOAD
+    if (parser->Fragment) {
+	ArrayIns(&parser->Fragment->Reads, (size_t)v, 1);
+    }
+#endif
+    value = (const ConfigObject *)ArrayGet(parser->GlobalArray, (size_t)v);
+    if (!value) {
+	fprintf(stderr, "core-rc: undefined `%s` used\n",
+	    ConfigIsWord(v) ? ConfigString(v, buf) : "<expr>");
+    }
+    ParsePush(parser, value);
+}
+
+// ----------------------------------------------------------------------------
+
+    /// peg parser generator class of external entry points
+#define YY_PARSE(T)	static T
+
+    /// peg parser generator context is passed to all functions
+#define YY_CTX_LOCAL
+
+    /// peg parser generator context members
+#define YY_CTX_MEMBERS	ConfigParser *Parser;
+
+//#define YY_DEBUG
+
+/**
+**	Read next bytes of current file.
+**
+**	Memory input (mapped files, buffers) is copied directly into the
+**	buffer of the parser generator, without stdio.
+**
+**	@param parser	config parser
+**	@param buf	buffer read position
+**	@param size	how many free bytes are in buffer
+**
+**	@returns number of bytes read.
+*/
+static inline size_t ParseInput(ConfigParser * parser, char *buf, size_t size)
+{
+    size_t n;
+
+    if (parser->Input) {
+	n = parser->InputEnd - parser->Input;
+	if (n > size) {
+	    n = size;
+	}
+	memcpy(buf, parser->Input, n);
+	parser->Input += n;
+    } else {
+	n = fread(buf, 1, size, parser->File);
+    }
+#ifdef USE_CORE_RC_RELOAD
+    if (parser->Track) {
+	parser->Hash = FileHashUpdate(parser->Hash, buf, n);
+    }
+#endif
+    return n;
+}
+
+/**
+**	Macro of parser generator, to read next bytes
+**
+**	@param yy		parser generator context
+**	@param buf		buffer read position
+**	@param[out] result	number of bytes read
+**	@param max_size		how many free bytes are in buffer
+*/
+#define YY_INPUT(yy, buf, result, max_size) \
+    do { \
+	result = ParseInput((yy)->Parser, buf, max_size); \
+    } while (0)
+
+/*
+**	The actions of the grammar have no parser argument, pass the parser
+**	of the parser generator context.
+*/
+#define ParseLineNr			yy->Parser->LineNr
+#define ParsePop()			ParsePop(yy->Parser)
+#define ParsePushI(v)			ParsePushI(yy->Parser, v)
+#define ParsePushF(v)			ParsePushF(yy->Parser, v)
+#define ParsePushS(v)			ParsePushS(yy->Parser, v)
+#define ParsePushNil()			ParsePushNil(yy->Parser)
+#define ParseInclude(f)			ParseInclude(yy->Parser, f)
+#define ParseArrayAddItem(i, v)		ParseArrayAddItem(yy->Parser, i, v)
+#define ParseArrayNextItem(v)		ParseArrayNextItem(yy->Parser, v)
+#define ParseArrayStart()		ParseArrayStart(yy->Parser)
+#define ParseArrayFinal()		ParseArrayFinal(yy->Parser)
+#define ParseLvalue()			ParseLvalue(yy->Parser)
+#define ParseAssign(i, v)		ParseAssign(yy->Parser, i, v)
+#define ParseDot(g, i)			ParseDot(yy->Parser, g, i)
+#define ParseStringCat(o1, o2)		ParseStringCat(yy->Parser, o1, o2)
+#define ParseVariable(v)		ParseVariable(yy->Parser, v)
+
+/*
+**	Parser generator generated:
+*/
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+
+#include "core-rc_parser.c"
+
+#pragma GCC diagnostic pop
+
+#undef ParseLineNr
+#undef ParsePop
+#undef ParsePushI
+#undef ParsePushF
+#undef ParsePushS
+#undef ParsePushNil
+#undef ParseInclude
+#undef ParseArrayAddItem
+#undef ParseArrayNextItem
+#undef ParseArrayStart
+#undef ParseArrayFinal
+#undef ParseLvalue
+#undef ParseAssign
+#undef ParseDot
+#undef ParseStringCat
+#undef ParseVariable
+
+/**
+**	Map file as memory input of parser.
+**
+**	The parser generator moves its buffer after each statement, the
+**	mapped bytes are read through ParseInput() and not parsed in place.
+**
+**	@param parser	config parser
+**	@param file	opened file stream at start of file
+**
+**	@returns start of mapping, NULL if file is read with stdio.
+*/
+static char *ParseMap(ConfigParser * parser, FILE * file)
+{
+    struct stat info;
+    char *addr;
+
+    if (fstat(fileno(file), &info) || !S_ISREG(info.st_mode)
+	|| !info.st_size) {
+	return NULL;
+    }
+    addr = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+    if (addr == MAP_FAILED) {
+	return NULL;
+    }
+    madvise(addr, info.st_size, MADV_SEQUENTIAL);
+    parser->Input = addr;
+    parser->InputEnd = addr + info.st_size;
+
+    return addr;
+}
+
+/**
+**	Unmap file mapped as memory input of parser.
+**
+**	@param parser	config parser
+**	@param addr	start of mapping returned by ParseMap()
+*/
+static void ParseUnmap(ConfigParser * parser, char *addr)
+{
+    if (addr) {
+	munmap(addr, parser->InputEnd - addr);
+    }
+    parser->Input = NULL;
+    parser->InputEnd = NULL;
+}
+
+/**
+**	Handle parser generator error message.
+**
+**	@param parser	config parser
+**	@param message	error message
+*/
+static void yyerror(ConfigParser * parser, const char *message)
+{
+    yycontext *yyctx;
+
+    yyctx = parser->Yy;
+    fprintf(stderr, "%s:%d: %s", parser->Name, parser->LineNr, message);
+    if (yyctx->__text[0]) {
+	fprintf(stderr, " near token '%s'", yyctx->__text);
+    }
+    if (yyctx->__pos < yyctx->__limit || (parser->Input
+	    ? parser->Input < parser->InputEnd : !feof(parser->File))) {
+	yyctx->__buf[yyctx->__limit] = '\0';
+	fprintf(stderr, " before text \"");
+	while (yyctx->__pos < yyctx->__limit) {
+	    if ('\n' == yyctx->__buf[yyctx->__pos]
+		|| '\r' == yyctx->__buf[yyctx->__pos]) {
+		break;
+	    }
+	    fputc(yyctx->__buf[yyctx->__pos++], stderr);
+	}
+	if (yyctx->__pos == yyctx->__limit) {
+	    int c;
+
+	    for (;;) {
+		if (parser->Input) {	// memory input
+		    c = parser->Input < parser->InputEnd
+			? (unsigned char)*parser->Input++ : EOF;
+		} else {
+		    c = fgetc(parser->File);
+		}
+		if (EOF == c || '\n' == c || '\r' == c) {
+		    break;
+		}
+		fputc(c, stderr);
+	    }
+	}
+	fputc('\"', stderr);
+    }
+    fprintf(stderr, "\n");
+    // exit(1);
+}
+
+#ifdef USE_CORE_RC_DESCENT
+
+// ----------------------------------------------------------------------------
+// Scanner
+// ----------------------------------------------------------------------------
+
+///
+///	@defgroup scan The scanner kernel module.
+///
+///	Kernels used by the descent parser on its hot paths: runs of spaces,
+///	comments and string bodies.  With #USE_CORE_RC_SIMD they compare 16
+///	(SSE2) or 32 (AVX2) bytes at once, the AVX2 kernels are selected at
+///	run time.  The scalar kernels handle the tails and other cpus.
+///
+/// @{
+
+#if defined(USE_CORE_RC_SIMD) && defined(__SSE2__)
+#define SCAN_SSE2			///< SSE2 and AVX2 kernels available
+#endif
+
+#if defined(SCAN_SSE2) || defined(CORE_RC_TEST)
+    /// scanner kernel level: 0 scalar, 1 SSE2, 2 AVX2
+static int ScanLevel;
+#endif
+
+    /// parsers of all threads select the kernels once
+static pthread_once_t ScanOnce = PTHREAD_ONCE_INIT;
+
+/**
+**	Select the scanner kernels of the cpu.
+*/
+static void ScanInit(void)
+{
+#ifdef SCAN_SSE2
+    __builtin_cpu_init();
+    ScanLevel = __builtin_cpu_supports("avx2") ? 2 : 1;
+#endif
+}
+
+/**
+**	Skip spaces (scalar).
+**
+**	@param p	start of input
+**	@param e	end of input
+**
+**	@returns first character at or after p, which isn't a space or end of
+**	line.
+*/
+static const char *ScanSpacesScalar(const char *p, const char *e)
+{
+    while (p < e && (*p == ' ' || (*p >= '\t' && *p <= '\r'))) {
+	++p;
+    }
+    return p;
+}
+
+/**
+**	Find first of two characters (scalar).
+**
+**	@param p	start of input
+**	@param e	end of input
+**	@param a	character to find
+**	@param b	other character to find
+**
+**	@returns first a or b at or after p, e if none.
+*/
+static const char *ScanFindScalar(const char *p, const char *e, int a, int b)
+{
+    while (p < e && *p != a && *p != b) {
+	++p;
+    }
+    return p;
+}
+
+/**
+**	Count lines (scalar).
+**
+**	@param p	start of input
+**	@param e	end of input
+**
+**	@returns number of '\\n' and '\\r' not followed by '\\n'.
+*/
+static size_t ScanLinesScalar(const char *p, const char *e)
+{
+    size_t n;
+
+    for (n = 0; p < e; ++p) {
+	if (*p == '\n' || (*p == '\r' && (p + 1 == e || p[1] != '\n'))) {
+	    ++n;
+	}
+    }
+    return n;
+}
+
+#ifdef SCAN_SSE2
+
+/**
+**	Skip spaces (SSE2).
+**
+**	@param p	start of input
+**	@param e	end of input
+*/
+static const char *ScanSpacesSse2(const char *p, const char *e)
+{
+    const __m128i blank = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i four = _mm_set1_epi8('\r' - '\t');
+
+    for (; p + 16 <= e; p += 16) {
+	__m128i v;
+	__m128i c;
+	unsigned m;
+
+	v = _mm_loadu_si128((const __m128i *)p);
+	c = _mm_sub_epi8(v, tab);	// '\t' .. '\r' => 0 .. 4
+	c = _mm_or_si128(_mm_cmpeq_epi8(v, blank),
+	    _mm_cmpeq_epi8(_mm_min_epu8(c, four), c));
+	if ((m = ~_mm_movemask_epi8(c) & 0xFFFF)) {
+	    return p + __builtin_ctz(m);
+	}
+    }
+    return ScanSpacesScalar(p, e);
+}
+
+/**
+**	Find first of two characters (SSE2).
+**
+**	@param p	start of input
+**	@param e	end of input
+**	@param a	character to find
+**	@param b	other character to find
+*/
+static const char *ScanFindSse2(const char *p, const char *e, int a, int b)
+{
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+
+    for (; p + 16 <= e; p += 16) {
+	__m128i v;
+	unsigned m;
+
+	v = _mm_loadu_si128((const __m128i *)p);
+	if ((m = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, va),
+			_mm_cmpeq_epi8(v, vb))))) {
+	    return p + __builtin_ctz(m);
+	}
+    }
+    return ScanFindScalar(p, e, a, b);
+}
+
+/**
+**	Count lines (SSE2).
+**
+**	@param p	start of input
+**	@param e	end of input
+*/
+static size_t ScanLinesSse2(const char *p, const char *e)
+{
+    const __m128i nl = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+    size_t n;
+
+    // the byte after the block is needed for "\r\n"
+    for (n = 0; p + 16 < e;) {
+	__m128i sum;
+	int i;
+
+	// byte counters, added up before they overflow
+	sum = _mm_setzero_si128();
+	for (i = 0; i < 255 && p + 16 < e; ++i, p += 16) {
+	    __m128i v;
+	    __m128i c;
+
+	    v = _mm_loadu_si128((const __m128i *)p);
+	    c = _mm_andnot_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const
+			    __m128i *)(p + 1)), nl), _mm_cmpeq_epi8(v, cr));
+	    sum = _mm_sub_epi8(sum, _mm_or_si128(_mm_cmpeq_epi8(v, nl), c));
+	}
+	sum = _mm_sad_epu8(sum, _mm_setzero_si128());
+	n += _mm_cvtsi128_si32(sum) + _mm_extract_epi16(sum, 4);
+    }
+    return n + ScanLinesScalar(p, e);
+}
+
+/**
+**	Skip spaces (AVX2).
+**
+**	@param p	start of input
+**	@param e	end of input
+*/
+__attribute__ ((target("avx2")))
+static const char *ScanSpacesAvx2(const char *p, const char *e)
+{
+    const __m256i blank = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i four = _mm256_set1_epi8('\r' - '\t');
+
+    for (; p + 32 <= e; p += 32) {
+	__m256i v;
+	__m256i c;
+	unsigned m;
+
+	v = _mm256_loadu_si256((const __m256i *)p);
+	c = _mm256_sub_epi8(v, tab);
+	c = _mm256_or_si256(_mm256_cmpeq_epi8(v, blank),
+	    _mm256_cmpeq_epi8(_mm256_min_epu8(c, four), c));
+	if ((m = ~(unsigned)_mm256_movemask_epi8(c))) {
+	    return p + __builtin_ctz(m);
+	}
+    }
+    return ScanSpacesSse2(p, e);
+}
+
+/**
+**	Find first of two characters (AVX2).
+**
+**	@param p	start of input
+**	@param e	end of input
+**	@param a	character to find
+**	@param b	other character to find
+*/
+__attribute__ ((target("avx2")))
+static const char *ScanFindAvx2(const char *p, const char *e, int a, int b)
+{
+    const __m256i va = _mm256_set1_epi8(a);
+    const __m256i vb = _mm256_set1_epi8(b);
+
+    for (; p + 32 <= e; p += 32) {
+	__m256i v;
+	unsigned m;
+
+	v = _mm256_loadu_si256((const __m256i *)p);
+	if ((m = _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v,
+			    va), _mm256_cmpeq_epi8(v, vb))))) {
+	    return p + __builtin_ctz(m);
+	}
+    }
+    return ScanFindSse2(p, e, a, b);
+}
+
+/**
+**	Count lines (AVX2).
+**
+**	@param p	start of input
+**	@param e	end of input
+*/
+__attribute__ ((target("avx2")))
+static size_t ScanLinesAvx2(const char *p, const char *e)
+{
+    const __m256i nl = _mm256_set1_epi8('\n');
+    const __m256i cr = _mm256_set1_epi8('\r');
+    size_t n;
+
+    for (n = 0; p + 32 < e;) {
+	__m256i sum;
+	int i;
+
+	sum = _mm256_setzero_si256();
+	for (i = 0; i < 255 && p + 32 < e; ++i, p += 32) {
+	    __m256i v;
+	    __m256i c;
+
+	    v = _mm256_loadu_si256((const __m256i *)p);
+	    c = _mm256_andnot_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256((const
+			    __m256i *)(p + 1)), nl), _mm256_cmpeq_epi8(v, cr));
+	    sum = _mm256_sub_epi8(sum, _mm256_or_si256(_mm256_cmpeq_epi8(v,
+			nl), c));
+	}
+	sum = _mm256_sad_epu8(sum, _mm256_setzero_si256());
+	n += _mm256_extract_epi64(sum, 0) + _mm256_extract_epi64(sum, 1)
+	    + _mm256_extract_epi64(sum, 2) + _mm256_extract_epi64(sum, 3);
+    }
+    return n + ScanLinesSse2(p, e);
+}
+
+#endif
+
+/**
+**	Skip spaces and end of lines.
+**
+**	@param p	start of input
+**	@param e	end of input
+**
+**	@returns first character at or after p, which isn't a space or end of
+**	line.
+*/
+static inline const char *ScanSpaces(const char *p, const char *e)
+{
+#ifdef SCAN_SSE2
+    if (ScanLevel == 2) {
+	return ScanSpacesAvx2(p, e);
+    }
+    if (ScanLevel == 1) {
+	return ScanSpacesSse2(p, e);
+    }
+#endif
+    return ScanSpacesScalar(p, e);
+}
+
+/**
+**	Find first of two characters.
+**
+**	@param p	start of input
+**	@param e	end of input
+**	@param a	character to find
+**	@param b	other character to find
+**
+**	@returns first a or b at or after p, e if none.
+*/
+static inline const char *ScanFind(const char *p, const char *e, int a, int b)
+{
+#ifdef SCAN_SSE2
+    if (ScanLevel == 2) {
+	return ScanFindAvx2(p, e, a, b);
+    }
+    if (ScanLevel == 1) {
+	return ScanFindSse2(p, e, a, b);
+    }
+#endif
+    return ScanFindScalar(p, e, a, b);
+}
+
+/**
+**	Count lines.
+**
+**	@param p	start of input
+**	@param e	end of input
+**
+**	@returns number of end of lines "\\n", "\\r\\n" and "\\r" in input.
+**	"\\r" at the end of input is counted.
+*/
+static inline size_t ScanLines(const char *p, const char *e)
+{
+#ifdef SCAN_SSE2
+    if (ScanLevel == 2) {
+	return ScanLinesAvx2(p, e);
+    }
+    if (ScanLevel == 1) {
+	return ScanLinesSse2(p, e);
+    }
+#endif
+    return ScanLinesScalar(p, e);
+}
+
+/// @}
+
+// ----------------------------------------------------------------------------
+// Descent parser
+// ----------------------------------------------------------------------------
+
+///
+///	@defgroup descent The recursive descent parser module.
+///
+///	Hand-written parser of the grammar core-rc_parser.peg, used instead
+///	of the peg generated parser with #USE_CORE_RC_DESCENT.	The actions
+///	run immediately and aren't recorded and replayed.  The outer arrays
+///	of nested arrays are kept in the C stack frames.  The file is parsed
+///	in place, if it is in memory.
+///
+///	Two rules need more than one character lookahead: an include
+///	statement and array items starting with an identifier or '['.  Both
+///	are checked with a dry run, which runs no actions.
+///
+///	@note after a syntax error, actions of the failing statement may
+///	already be done, the peg parser drops them.
+///
+/// @{
+
+    /// character of identifier start
+#define DESCENT_ALPHA(c) \
+    (((c) >= 'a' && (c) <= 'z') || ((c) >= 'A' && (c) <= 'Z') || (c) == '_')
+
+    /// decimal digit character
+#define DESCENT_DIGIT(c)	((c) >= '0' && (c) <= '9')
+
+    /// hex digit character
+#define DESCENT_XDIGIT(c) \
+    (DESCENT_DIGIT(c) || ((c) >= 'a' && (c) <= 'f') || ((c) >= 'A' \
+	    && (c) <= 'F'))
+
+/**
+**	Descent parser state of one file.
+*/
+typedef struct _descent_state_
+{
+    ConfigParser *Parser;		///< config parser
+    const char *Pos;			///< current read position
+    const char *End;			///< end of input
+    int Dry;				///< dry run, only check syntax
+    const char *Token;			///< text of last string or identifier
+    const char *TokenEnd;		///< end of token text
+} DescentState;
+
+/**
+**	Get length of end of line.
+**
+**	@param d	descent parser state
+**	@param p	read position
+**
+**	@returns number of end of line characters at p, 0 if none.
+*/
+static inline int DescentEol(const DescentState * d, const char *p)
+{
+    if (p < d->End) {
+	if (*p == '\n') {
+	    return 1;
+	}
+	if (*p == '\r') {
+	    return p + 1 < d->End && p[1] == '\n' ? 2 : 1;
+	}
+    }
+    return 0;
+}
+
+/**
+**	Count lines.
+**
+**	@param d	descent parser state
+**	@param n	number of lines
+*/
+static inline void DescentLines(DescentState * d, size_t n)
+{
+    if (!d->Dry) {
+	d->Parser->LineNr += n;
+    }
+}
+
+/**
+**	Count digits.
+**
+**	@param d	descent parser state
+**	@param p	read position
+**
+**	@returns number of decimal digits at p.
+*/
+static size_t DescentDigits(const DescentState * d, const char *p)
+{
+    const char *s;
+
+    for (s = p; s < d->End && DESCENT_DIGIT(*s); ++s) {
+    }
+    return s - p;
+}
+
+/**
+**	Skip spaces and comments.
+**
+**	Newlines in block comments and strings aren't counted, like in the
+**	peg grammar.
+**
+**	@param d	descent parser state
+*/
+static void DescentSpaces(DescentState * d)
+{
+    const char *p;
+    const char *e;
+
+    p = d->Pos;
+    while (p < d->End) {
+	e = ScanSpaces(p, d->End);
+	if (e != p) {
+	    DescentLines(d, ScanLines(p, e));
+	    p = e;
+	    continue;
+	}
+	if (*p != ';') {
+	    break;
+	}
+	if (p + 1 < d->End && p[1] == '{') {
+	    for (e = p + 2; (e = ScanFind(e, d->End, ';', ';')) < d->End - 1;
+		++e) {
+		if (e[1] == '}') {
+		    break;
+		}
+	    }
+	    if (e < d->End - 1) {
+		p = e + 2;
+		continue;
+	    }
+	}
+	// line comment must end with end of line
+	e = ScanFind(p + 1, d->End, '\n', '\r');
+	if (e == d->End) {
+	    break;
+	}
+	p = e + DescentEol(d, e);
+	DescentLines(d, 1);
+    }
+    d->Pos = p;
+}
+
+/**
+**	Push text as string.
+**
+**	@param d	descent parser state
+**	@param begin	start of text
+**	@param end	end of text
+*/
+static void DescentPushS(DescentState * d, const char *begin,
+    const char *end)
+{
+    ConfigParser *parser;
+    size_t n;
+
+    d->Token = begin;
+    d->TokenEnd = end;
+    if (d->Dry) {
+	return;
+    }
+    parser = d->Parser;
+    n = end - begin;
+    if (n + 1 > parser->TextSize) {
+	parser->TextSize = n + 1 > 2 * parser->TextSize ? n + 1
+	    : 2 * parser->TextSize;
+	parser->Text = realloc(parser->Text, parser->TextSize);
+    }
+    memcpy(parser->Text, begin, n);
+    parser->Text[n] = '\0';
+
+    ParsePushS(parser, parser->Text);
+}
+
+/**
+**	Parse identifier.
+**
+**	@param d	descent parser state
+*/
+static int DescentIdentifier(DescentState * d)
+{
+    const char *begin;
+    const char *p;
+
+    begin = d->Pos;
+    if (begin == d->End || !DESCENT_ALPHA(*begin)) {
+	return 0;
+    }
+    for (p = begin + 1; p < d->End && (DESCENT_ALPHA(*p) || DESCENT_DIGIT(*p)
+	    || *p == '-'); ++p) {
+    }
+    d->Pos = p;
+    DescentSpaces(d);
+    DescentPushS(d, begin, p);
+    return 1;
+}
+
+/**
+**	Parse word.
+**
+**	@param d	descent parser state
+*/
+static int DescentWord(DescentState * d)
+{
+    if (d->Pos == d->End || *d->Pos != '`') {
+	return 0;
+    }
+    ++d->Pos;
+    if (!DescentIdentifier(d)) {
+	--d->Pos;
+	return 0;
+    }
+    return 1;
+}
+
+/**
+**	Get length of character of string.
+**
+**	@param d	descent parser state
+**	@param p	read position
+**
+**	@returns number of characters of the (escaped) character at p, 0
+**	if none.
+*/
+static int DescentChar(const DescentState * d, const char *p)
+{
+    size_t n;
+
+    n = d->End - p;
+    if (!n) {
+	return 0;
+    }
+    if (*p != '\\') {
+	return 1;
+    }
+    if (n >= 2 && p[1] && strchr("abefnrtv'\"\\", p[1])) {
+	return 2;
+    }
+    if (n >= 4 && (p[1] == 'x' || p[1] == 'X') && DESCENT_XDIGIT(p[2])
+	&& DESCENT_XDIGIT(p[3])) {
+	return 4;
+    }
+    if (n >= 4 && p[1] >= '0' && p[1] <= '3' && p[2] >= '0' && p[2] <= '7'
+	&& p[3] >= '0' && p[3] <= '7') {
+	return 4;
+    }
+    if (n >= 6 && (p[1] == 'u' || p[1] == 'U') && DESCENT_XDIGIT(p[2])
+	&& DESCENT_XDIGIT(p[3]) && DESCENT_XDIGIT(p[4])
+	&& DESCENT_XDIGIT(p[5])) {
+	return 6;
+    }
+    return 0;
+}
+
+/**
+**	Parse string.
+**
+**	@param d	descent parser state
+*/
+static int DescentString(DescentState * d)
+{
+    const char *p;
+    const char *begin;
+    const char *end;
+    int lines;
+    int n;
+
+    p = d->Pos;
+    lines = 0;
+    if (p == d->End) {
+	return 0;
+    }
+    if (*p == '"') {
+	begin = ++p;
+	while ((p = ScanFind(p, d->End, '"', '\\')) < d->End && *p != '"') {
+	    if (!(n = DescentChar(d, p))) {
+		return 0;
+	    }
+	    p += n;
+	}
+	if (p == d->End) {
+	    return 0;
+	}
+	end = p++;
+    } else if (*p == '{') {
+	if ((n = DescentEol(d, ++p))) {
+	    p += n;
+	    ++lines;
+	}
+	begin = p;
+	// until end of line? '}', the end of line belongs to the end
+	if ((p = ScanFind(p, d->End, '}', '}')) == d->End) {
+	    return 0;
+	}
+	if (p - 2 >= begin && p[-2] == '\r' && p[-1] == '\n') {
+	    p -= 2;
+	} else if (p - 1 >= begin && (p[-1] == '\n' || p[-1] == '\r')) {
+	    --p;
+	}
+	end = p;
+	if ((n = DescentEol(d, p))) {
+	    p += n;
+	    ++lines;
+	}
+	++p;
+    } else {
+	return 0;
+    }
+    DescentLines(d, lines);
+    d->Pos = p;
+    DescentSpaces(d);
+    DescentPushS(d, begin, end);
+    return 1;
+}
+
+/**
+**	Parse number.
+**
+**	Floats, integers (decimal, hex and octal) and characters.
+**
+**	@param d	descent parser state
+*/
+static int DescentNumber(DescentState * d)
+{
+    ConfigParser *parser;
+    const char *p;
+    const char *s;
+    const char *q;
+    size_t n;
+    char *text;
+
+    parser = d->Parser;
+    p = d->Pos;
+    if (p == d->End) {
+	return 0;
+    }
+    if (*p == '\'') {			// character
+	if (!(n = DescentChar(d, p + 1))) {
+	    return 0;
+	}
+	d->Pos = p + 1 + n;
+	DescentSpaces(d);
+	if (!d->Dry) {
+	    ParsePushI(parser, p[1]);
+	}
+	return 1;
+    }
+
+    s = p + (*p == '-' || *p == '+');
+    n = DescentDigits(d, s);
+    q = NULL;
+    if (n && s + n < d->End && s[n] == '.') {
+	q = s + n + 1;
+	q += DescentDigits(d, q);
+    } else if (!n && s < d->End && *s == '.' && DescentDigits(d, s + 1)) {
+	q = s + 1;
+	q += DescentDigits(d, q);
+    } else if (n && s + n < d->End && (s[n] == 'e' || s[n] == 'E')) {
+	q = s + n;
+    }
+    if (q) {				// float, with optional exponent
+	if (q < d->End && (*q == 'e' || *q == 'E')) {
+	    ++q;
+	    if (q < d->End && (*q == '-' || *q == '+')) {
+		++q;
+	    }
+	    q += DescentDigits(d, q);
+	}
+    } else if (s < d->End && *s >= '1' && *s <= '9') {	// decimal
+	q = s + n;
+    } else if (*p == '0' && p + 2 < d->End && (p[1] == 'x' || p[1] == 'X')
+	&& DESCENT_XDIGIT(p[2])) {	// hex
+	for (q = p + 3; q < d->End && DESCENT_XDIGIT(*q); ++q) {
+	}
+    } else if (*p == '0') {		// octal
+	for (q = p + 1; q < d->End && *q >= '0' && *q <= '7'; ++q) {
+	}
+    } else {
+	return 0;
+    }
+    d->Pos = q;
+    DescentSpaces(d);
+    if (!d->Dry) {
+	text = alloca(q - p + 1);
+	memcpy(text, p, q - p);
+	text[q - p] = '\0';
+	if (s + n < d->End && (s[n] == '.' || s[n] == 'e' || s[n] == 'E')) {
+	    ParsePushF(parser, strtod(text, NULL));
+	} else {
+	    ParsePushI(parser, strtol(text, NULL, 0));
+	}
+    }
+    return 1;
+}
+
+    /// parse expression
+static int DescentExpr(DescentState *);
+
+/**
+**	Check for index item: '[' expr ']' '='.
+**
+**	@param d	descent parser state
+*/
+static int DescentIndexItem(DescentState * d)
+{
+    if (d->Pos == d->End || *d->Pos != '[') {
+	return 0;
+    }
+    ++d->Pos;
+    DescentSpaces(d);
+    if (!DescentExpr(d) || d->Pos == d->End || *d->Pos != ']') {
+	return 0;
+    }
+    ++d->Pos;
+    DescentSpaces(d);
+    return d->Pos < d->End && *d->Pos == '=';
+}
+
+/**
+**	Check for named item: (identifier / word) '='.
+**
+**	@param d	descent parser state
+*/
+static int DescentNamedItem(DescentState * d)
+{
+    return (DescentIdentifier(d) || DescentWord(d)) && d->Pos < d->End
+	&& *d->Pos == '=';
+}
+
+/**
+**	Check syntax with a dry run, without moving the read position.
+**
+**	@param d	descent parser state
+**	@param rule	rule to check
+*/
+static int DescentCheck(DescentState * d, int (*rule) (DescentState *))
+{
+    const char *pos;
+    int dry;
+    int ok;
+
+    pos = d->Pos;
+    dry = d->Dry;
+    d->Dry = 1;
+    ok = rule(d);
+    d->Dry = dry;
+    d->Pos = pos;
+
+    return ok;
+}
+
+/**
+**	Parse array item.
+**
+**	@param d	descent parser state
+*/
+static int DescentArrayItem(DescentState * d)
+{
+    ConfigParser *parser;
+    const ConfigObject *v1;
+
+    parser = d->Parser;
+    if (DescentCheck(d, DescentIndexItem)) {
+	// '[' spaces expr ']' spaces '=' spaces expr
+	++d->Pos;
+	DescentSpaces(d);
+	DescentExpr(d);
+	++d->Pos;
+	DescentSpaces(d);
+    } else if (DescentCheck(d, DescentNamedItem)) {
+	// (identifier / word) '=' spaces expr
+	if (!DescentIdentifier(d)) {
+	    DescentWord(d);
+	}
+    } else {
+	// expr
+	if (!DescentExpr(d)) {
+	    return 0;
+	}
+	if (!d->Dry) {
+	    ParseArrayNextItem(parser, ParsePop(parser));
+	}
+	return 1;
+    }
+    ++d->Pos;				// '='
+    DescentSpaces(d);
+    if (!DescentExpr(d)) {
+	return 0;
+    }
+    if (!d->Dry) {
+	v1 = ParsePop(parser);
+	ParseArrayAddItem(parser, ParsePop(parser), v1);
+    }
+    return 1;
+}
+
+/**
+**	Parse array.
+**
+**	The outer array is kept in the stack frame.
+**
+**	@param d	descent parser state
+*/
+static int DescentArray(DescentState * d)
+{
+    ConfigParser *parser;
+    Array *array;
+    int index;
+
+    if (d->Pos == d->End || *d->Pos != '[') {
+	return 0;
+    }
+    parser = d->Parser;
+    array = parser->CurrentArray;
+    index = parser->CurrentIndex;
+    if (!d->Dry) {
+	parser->CurrentArray = ArrayNew();
+	parser->CurrentIndex = 0;
+    }
+    ++d->Pos;
+    DescentSpaces(d);
+    while (DescentArrayItem(d)) {
+	if (d->Pos < d->End && *d->Pos == ',') {
+	    ++d->Pos;
+	    DescentSpaces(d);
+	}
+    }
+    if (d->Pos == d->End || *d->Pos != ']') {
+	if (!d->Dry) {
+	    ArrayFree(parser->CurrentArray);
+	    parser->CurrentArray = array;
+	    parser->CurrentIndex = index;
+	}
+	return 0;
+    }
+    ++d->Pos;
+    DescentSpaces(d);
+    if (!d->Dry) {
+	ParsePushA(parser, parser->CurrentArray);
+	parser->CurrentArray = array;
+	parser->CurrentIndex = index;
+    }
+    return 1;
+}
+
+/**
+**	Parse keyword.
+**
+**	@param d	descent parser state
+**	@param keyword	keyword, also matches prefix of identifiers
+**	@param n	length of keyword
+*/
+static int DescentKeyword(DescentState * d, const char *keyword, size_t n)
+{
+    if ((size_t)(d->End - d->Pos) < n || memcmp(d->Pos, keyword, n)) {
+	return 0;
+    }
+    d->Pos += n;
+    DescentSpaces(d);
+    return 1;
+}
+
+/**
+**	Parse simple expression.
+**
+**	@param d	descent parser state
+*/
+static int DescentExpr0(DescentState * d)
+{
+    ConfigParser *parser;
+
+    parser = d->Parser;
+    if (DescentKeyword(d, "nil", 3)) {
+	if (!d->Dry) {
+	    ParsePushNil(parser);
+	}
+	return 1;
+    }
+    if (DescentKeyword(d, "false", 5)) {
+	if (!d->Dry) {
+	    ParsePushI(parser, 0);
+	}
+	return 1;
+    }
+    if (DescentKeyword(d, "true", 4)) {
+	if (!d->Dry) {
+	    ParsePushI(parser, 1);
+	}
+	return 1;
+    }
+    if (DescentNumber(d) || DescentString(d) || DescentWord(d)) {
+	return 1;
+    }
+    if (DescentIdentifier(d)) {
+	if (!d->Dry) {
+	    ParseVariable(parser, ParsePop(parser));
+	}
+	return 1;
+    }
+    return DescentArray(d);
+}
+
+/**
+**	Parse expression.
+**
+**	@param d	descent parser state
+*/
+static int DescentExpr(DescentState * d)
+{
+    ConfigParser *parser;
+    const ConfigObject *v1;
+
+    parser = d->Parser;
+    if (d->Pos < d->End && *d->Pos == '(') {
+	++d->Pos;
+	DescentSpaces(d);
+	if (!DescentExpr(d) || d->Pos == d->End || *d->Pos != ')') {
+	    return 0;
+	}
+	++d->Pos;
+	DescentSpaces(d);
+	return 1;
+    }
+    if (!DescentExpr0(d)) {
+	return 0;
+    }
+    if (d->Pos < d->End && *d->Pos == '~') {
+	++d->Pos;
+	DescentSpaces(d);
+	if (!DescentExpr(d)) {
+	    return 0;
+	}
+	if (!d->Dry) {
+	    v1 = ParsePop(parser);
+	    ParseStringCat(parser, ParsePop(parser), v1);
+	}
+    }
+    return 1;
+}
+
+/**
+**	Parse lvalue.
+**
+**	@param d	descent parser state
+*/
+static int DescentLvalue(DescentState * d)
+{
+    ConfigParser *parser;
+    const ConfigObject *v1;
+
+    parser = d->Parser;
+    if (!DescentIdentifier(d)) {
+	return 0;
+    }
+    if (!d->Dry) {
+	ParseLvalue(parser);
+    }
+    while (d->Pos < d->End) {
+	if (*d->Pos == '.') {
+	    ++d->Pos;
+	    DescentSpaces(d);
+	    if (!DescentIdentifier(d)) {
+		return 0;
+	    }
+	} else if (*d->Pos == '[') {
+	    ++d->Pos;
+	    DescentSpaces(d);
+	    if (!DescentExpr(d) || d->Pos == d->End || *d->Pos != ']') {
+		return 0;
+	    }
+	    ++d->Pos;
+	    DescentSpaces(d);
+	} else {
+	    break;
+	}
+	if (!d->Dry) {
+	    v1 = ParsePop(parser);
+	    ParseDot(parser, ParsePop(parser), v1);
+	}
+    }
+    return 1;
+}
+
+/**
+**	Check for include statement.
+**
+**	@param d	descent parser state
+*/
+static int DescentInclude(DescentState * d)
+{
+    return DescentKeyword(d, "include", 7) && DescentString(d);
+}
+
+/**
+**	Parse all statements of file.
+**
+**	@param d	descent parser state
+**
+**	@returns true if the whole file is parsed.
+*/
+static int DescentConfigs(DescentState * d)
+{
+    ConfigParser *parser;
+    const ConfigObject *v1;
+
+    parser = d->Parser;
+    DescentSpaces(d);
+    while (d->Pos < d->End) {
+	const char *pos;
+	int line_nr;
+	int sp;
+
+	if (DescentCheck(d, DescentInclude)) {
+	    DescentInclude(d);
+	    ParseInclude(parser, ParsePop(parser));
+	    continue;
+	}
+	pos = d->Pos;
+	line_nr = parser->LineNr;
+	sp = parser->SP;
+	if (DescentLvalue(d) && d->Pos < d->End && *d->Pos == '=') {
+	    ++d->Pos;
+	    DescentSpaces(d);
+	    if (DescentExpr(d)) {
+		v1 = ParsePop(parser);
+		ParseAssign(parser, ParsePop(parser), v1);
+		continue;
+	    }
+	}
+	// report error at start of statement
+	d->Pos = pos;
+	parser->LineNr = line_nr;
+	parser->SP = sp;
+	return 0;
+    }
+    return 1;
+}
+
+#ifdef USE_CORE_RC_PARALLEL
+
+/**
+**	Collect the include files of the current file.
+**
+**	Dry run over the statements of the memory input, it stops at the
+**	first syntax error like the parser.
+**
+**	@param parser		config parser with memory input
+**	@param[out] names	include file names, malloced
+**
+**	@returns number of include files.
+*/
+static int DescentIncludes(ConfigParser * parser, char ***names)
+{
+    DescentState d;
+    int n;
+
+    d.Parser = parser;
+    d.Pos = parser->Input;
+    d.End = parser->InputEnd;
+    d.Dry = 1;
+
+    *names = NULL;
+    n = 0;
+    DescentSpaces(&d);
+    while (d.Pos < d.End) {
+	if (DescentCheck(&d, DescentInclude)) {
+	    DescentInclude(&d);
+	    *names = realloc(*names, (n + 1) * sizeof(**names));
+	    (*names)[n++] = strndup(d.Token, d.TokenEnd - d.Token);
+	    continue;
+	}
+	if (!DescentLvalue(&d) || d.Pos == d.End || *d.Pos != '=') {
+	    break;
+	}
+	++d.Pos;
+	DescentSpaces(&d);
+	if (!DescentExpr(&d)) {
+	    break;
+	}
+    }
+    return n;
+}
+
+#endif
+
+/**
+**	Parse current file with descent parser.
+**
+**	@param parser	config parser
+**
+**	@returns true if file is parsed without syntax error.
+*/
+static int DescentParse(ConfigParser * parser)
+{
+    DescentState d;
+    char *buf;
+    int ok;
+
+    buf = NULL;
+    if (parser->Input) {		// parse in place
+	d.Pos = parser->Input;
+	d.End = parser->InputEnd;
+    } else {
+	size_t size;
+	size_t max;
+	size_t n;
+
+	size = 0;
+	max = 0;
+	do {
+	    if (size == max) {
+		max = max ? max * 2 : 4096;
+		buf = realloc(buf, max);
+	    }
+	    n = fread(buf + size, 1, max - size, parser->File);
+	    size += n;
+	} while (n);
+	d.Pos = buf;
+	d.End = buf + size;
+    }
+#ifdef USE_CORE_RC_RELOAD
+    if (parser->Track) {
+	parser->Hash = FileHashUpdate(parser->Hash, d.Pos, d.End - d.Pos);
+    }
+#endif
+    d.Parser = parser;
+    d.Dry = 0;
+
+    if ((ok = DescentConfigs(&d))) {
+#ifdef DEBUG_CORE_RC
+	printf("success\n");
+#endif
+    } else if (!ParseQuiet(parser)) {
+	const char *p;
+
+	fprintf(stderr, "%s:%d: syntax error before text \"", parser->Name,
+	    parser->LineNr);
+	for (p = d.Pos; p < d.End && *p != '\n' && *p != '\r'; ++p) {
+	    fputc(*p, stderr);
+	}
+	fprintf(stderr, "\"\n");
+    }
+    free(buf);
+
+    return ok;
+}
+
+/// @}
+
+#endif
+
+/**
+**	Parse current file.
+**
+**	@param parser	config parser
+*/
+static void ParseFile(ConfigParser * parser)
+{
+#ifdef USE_CORE_RC_DESCENT
+    if (parser->Descent) {
+	DescentParse(parser);
+	return;
+    }
+#endif
+    if (yyparse(parser->Yy)) {
+#ifdef DEBUG_CORE_RC
+	printf("success\n");
+#endif
+    } else {
+	yyerror(parser, "syntax error");
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+///
+///	saved peg parser state
+///
+struct _saved_state_
+{
+    /// parser generator variables
+    yycontext yyctx;
+
+    const char *Name;			///< previous file name
+    FILE *File;				///< previous file stream
+    const char *Input;			///< previous memory input
+    const char *InputEnd;		///< end of previous memory input
+    int LineNr;				///< previous line number
+#ifdef USE_CORE_RC_RELOAD
+    ConfigArena *Arena;			///< previous arena
+    ConfigFragment *Fragment;		///< previous fragment
+    uint64_t Hash;			///< hash of previous file
+#endif
+};
+
+/**
+**	Push parser state for includes.
+**
+**	@param parser	config parser
+**	@param filename	config include file name
+*/
+static void ParseRecursive(ConfigParser * parser, const char *filename)
+{
+    struct _saved_state_ s;
+    FILE *file;
+    char *buf;
+    char *addr;
+#ifdef USE_CORE_RC_RELOAD
+    int i;
+#endif
+
+    //
+    // Save current state.
+    //
+    s.yyctx = *parser->Yy;
+    s.Name = parser->Name;
+    s.File = parser->File;
+    s.Input = parser->Input;
+    s.InputEnd = parser->InputEnd;
+    s.LineNr = parser->LineNr;
+#ifdef USE_CORE_RC_RELOAD
+    s.Arena = parser->Arena;
+    s.Fragment = parser->Fragment;
+    s.Hash = parser->Hash;
+#endif
+
+    //
+    //	initialize
+    //
+    memset(parser->Yy, 0, sizeof(yycontext));
+    parser->Yy->Parser = parser;
+
+    file = fopen(filename, "rb");
+    if (!file) {
+	// absolute path
+	if (filename[0] != '/' && (filename[0] != '.' || filename[1] != '/')
+	    && (filename[0] != '.' || filename[1] != '.'
+		|| filename[2] != '/')) {
+	    char *s;
+
+	    buf = alloca(strlen(parser->Name) + strlen(filename) + 2);
+	    if ((s = strrchr(parser->Name, '/'))) {
+		s = stpncpy(buf, parser->Name, s - parser->Name + 1);
+		strcpy(s, filename);
+	    } else {
+		strcpy(buf, filename);
+	    }
+	    filename = buf;
+	    file = fopen(filename, "rb");
+	}
+	if (!file && !ParseQuiet(parser)) {
+	    fprintf(stderr, "can't open include file '%s'\n", filename);
+	}
+    }
+    // missing files are also watched
+    ArenaAddFile(parser->Root, filename);
+#ifdef USE_CORE_RC_RELOAD
+    i = 0;
+    if (parser->Track) {
+	if (!parser->Depth) {		// included by main file: new fragment
+	    parser->Fragment = FragmentNew();
+	    ArenaAddFragment(parser->Root, parser->Fragment);
+	    parser->Arena = parser->Fragment->Arena;
+	}
+	i = FragmentAddFile(parser->Fragment, filename, file);
+	parser->Hash = FILE_HASH_BASIS;
+    }
+    ++parser->Depth;
+#endif
+    if (file) {
+	parser->Name = filename;
+	parser->File = file;
+	parser->LineNr = 1;
+	parser->Input = NULL;
+	addr = ParseMap(parser, file);
+	ParseFile(parser);
+	ParseUnmap(parser, addr);
+	fclose(file);
+    }
+#ifdef USE_CORE_RC_RELOAD
+    --parser->Depth;
+    if (parser->Track) {
+	parser->Fragment->Files[i].Hash = parser->Hash;
+    }
+#endif
+    //
+    //	cleanup
+    //
+    yyrelease(parser->Yy);
+
+    //
+    // Restore current state
+    //
+    *parser->Yy = s.yyctx;
+    parser->Name = s.Name;
+    parser->File = s.File;
+    parser->Input = s.Input;
+    parser->InputEnd = s.InputEnd;
+    parser->LineNr = s.LineNr;
+#ifdef USE_CORE_RC_RELOAD
+    parser->Arena = s.Arena;
+    parser->Fragment = s.Fragment;
+    parser->Hash = s.Hash;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+
+/// @}
+
+// ----------------------------------------------------------------------------
+
+/**
+**	Define a configuration variable.
+**
+**	@param config	config dictionary.
+**	@param index	key
+**	@param value	data
+*/
+extern void ConfigDefine(Config * config, const ConfigObject * index,
+    const ConfigObject * value)
+{
+    ConfigObject *dict;
+    Array *array;
+    size_t *vp;
+
+    // FIXME: ConfigDictNoConst(config)
+    dict = (ConfigObject *) (config);
+    if (!ConfigIsArray(dict) || ConfigArrayKind(dict) != CONFIG_ARRAY_CORE) {
+	fprintf(stderr, "core-rc: config is no modifiable array\n");
+	return;
+    }
+    ArenaAdopt(config->Arena, index);
+    ArenaAdopt(config->Arena, value);
+#ifdef USE_CORE_RC_RELOAD
+    config->Arena->Modified = 1;
+#endif
+    config->Generation = ConfigNextGeneration();
+#ifdef USE_CORE_RC_INDEX
+    PathIndexDel(config->Arena->Index);	// index is out of date
+    config->Arena->Index = NULL;
+#endif
+    array = ConfigArray(dict);
+    vp = ArrayIns(&array, (size_t)index, (size_t)value);
+    if (*vp != (size_t)value) {
+	fprintf(stderr, "redefined old value\n");
+	*vp = (size_t)value;
+    }
+    dict->Pointer = array;
+}
+
+/**
+**	Replace string objects in an array.
+**
+**	@param array	pointer to array
+**	@param remap	mapping of string objects
+*/
+static void ParseRemapArray(Array ** array, const Array * remap)
+{
+    size_t index;
+    size_t *value;
+    size_t to;
+    int keys;
+
+    keys = 0;
+    index = 0;
+    value = ArrayFirst(*array, &index);
+    while (value) {
+	if (ConfigIsWord((const ConfigObject *)*value)
+	    && (to = ArrayGet(remap, *value))) {
+	    *value = to;
+	}
+	if (ConfigIsWord((const ConfigObject *)index)
+	    && ArrayGet(remap, index)) {
+	    keys = 1;
+	}
+	value = ArrayNext(*array, &index);
+    }
+    if (keys) {				// keys changed, array must be rebuild
+	Array *new;
+
+	new = ArrayNew();
+	index = 0;
+	value = ArrayFirst(*array, &index);
+	while (value) {
+	    if (!ConfigIsWord((const ConfigObject *)index)
+		|| !(to = ArrayGet(remap, index))) {
+		to = index;
+	    }
+	    ArrayIns(&new, to, *value);
+	    value = ArrayNext(*array, &index);
+	}
+	ArrayFree(*array);
+	*array = new;
+    }
+}
+
+/**
+**	Replace string objects in a vector array.
+**
+**	@param vector	vector array, its integer keys are kept
+**	@param remap	mapping of string objects
+*/
+static void ParseRemapVector(VectorArray * vector, const Array * remap)
+{
+    size_t i;
+    size_t to;
+
+    for (i = 0; i < vector->N; ++i) {
+	if (ConfigIsWord((const ConfigObject *)vector->Values[i])
+	    && (to = ArrayGet(remap, vector->Values[i]))) {
+	    vector->Values[i] = to;
+	}
+    }
+}
+
+/**
+**	Replace string objects in the arrays of an arena.
+**
+**	The arrays are taken from the arena, the tree isn't walked.
+**
+**	@param arena	arena of arrays using the replaced string objects
+**	@param remap	mapping of string objects
+*/
+static void ParseRemapArena(ConfigArena * arena, const Array * remap)
+{
+    size_t i;
+
+    for (i = 0; i < arena->ArrayN; ++i) {
+	ConfigObject *object;
+	PartsArray *parts;
+
+	object = (ConfigObject *) ((size_t)arena->Arrays[i] & ~1);
+	switch (ConfigArrayKind(object)) {
+	    case CONFIG_ARRAY_VECTOR:
+		ParseRemapVector((VectorArray *) ConfigVector(object),
+		    remap);
+		break;
+	    case CONFIG_ARRAY_PARTS:
+		parts = (PartsArray *) ConfigParts(object);
+		ParseRemapArray(&parts->Fixed, remap);
+		ParseRemapArray(&parts->Named, remap);
+		break;
+	    default:
+		ParseRemapArray((Array **) & object->Pointer, remap);
+		break;
+	}
+    }
+#ifdef USE_CORE_RC_RELOAD
+    for (i = 0; i < (size_t)arena->FragmentN; ++i) {
+	ConfigFragment *fragment;
+
+	fragment = arena->Fragments[i];
+	ParseRemapArena(fragment->Arena, remap);
+	ParseRemapArray(&fragment->Keys, remap);
+	ParseRemapArray(&fragment->Reads, remap);
+    }
+#endif
+}
+
+/**
+**	Replace string objects in a config.
+**
+**	@param config	config using the replaced string objects
+**	@param remap	mapping of string objects
+*/
+static void ParseRemap(Config * config, const Array * remap)
+{
+    ParseRemapArray((Array **) & config->Pointer, remap);
+    ParseRemapArena(config->Arena, remap);
+}
+
+/**
+**	Prepare parser stack and strings.
+**
+**	@param parser	config parser
+*/
+static void ParseStart(ConfigParser * parser)
+{
+    parser->StackSize = 16;
+    parser->Stack = malloc(parser->StackSize * sizeof(ConfigObject *));
+    parser->SP = 0;
+
+    if (parser->PrivateStrings) {
+	parser->Strings = StringPoolNew();
+    } else {
+	pthread_mutex_lock(&ConfigStringsLock);
+	ConfigStringsRef();
+	pthread_mutex_unlock(&ConfigStringsLock);
+	parser->Strings = ConfigStrings;
+    }
+}
+
+/**
+**	Release parser stack and merge private strings.
+**
+**	The parsed config holds a reference of the global string pool.
+**
+**	@param parser	config parser
+**
+**	@returns mapping of string objects to replace, NULL if nothing to
+**	replace.
+*/
+static Array *ParseStop(ConfigParser * parser)
+{
+    Array *remap;
+
+    free(parser->Stack);
+    parser->Stack = NULL;
+
+    remap = NULL;
+    if (parser->PrivateStrings) {
+	pthread_mutex_lock(&ConfigStringsLock);
+	ConfigStringsRef();
+	remap = StringPoolMerge(ConfigStrings, parser->Strings);
+	pthread_mutex_unlock(&ConfigStringsLock);
+    }
+    parser->Strings = NULL;
+
+    return remap;
+}
+
+#ifdef USE_CORE_RC_PARALLEL
+
+/**
+**	Parse include file in worker thread.
+**
+**	@param jobs	include files of main file
+**	@param job	include file to parse
+*/
+static void ParseJobRun(ParseJobs * jobs, ParseJob * job)
+{
+    ConfigParser *worker;
+    Array *remap;
+    size_t to;
+    size_t i;
+
+    worker = ConfigParserNew();
+    worker->Worker = 1;
+    ParseStart(worker);
+    worker->Root = ArenaNew();
+    worker->Arena = worker->Root;
+    worker->Name = jobs->Name;
+#ifdef USE_CORE_RC_RELOAD
+    worker->Track = jobs->Track;
+#endif
+
+    ParseRecursive(worker, job->Name);
+
+    job->Fallback = worker->Fallback;
+    job->Root = worker->Root;
+    job->Log = worker->Log;
+    job->LogN = worker->LogN;
+
+    if (job->Fallback) {
+	StringPoolDel(worker->Strings);
+    } else {
+	// strings are merged, keys must be the objects of main parser
+	pthread_mutex_lock(&jobs->Lock);
+	remap = StringPoolMerge(jobs->Strings, worker->Strings);
+	pthread_mutex_unlock(&jobs->Lock);
+
+	ParseRemapArena(job->Root, remap);
+	for (i = 0; i < job->LogN; ++i) {
+	    if (ConfigIsWord(job->Log[i])
+		&& (to = ArrayGet(remap, (size_t)job->Log[i]))) {
+		job->Log[i] = (const ConfigObject *)to;
+	    }
+	}
+	ArrayFree(remap);
+    }
+
+    free(worker->Stack);
+    worker->Log = NULL;
+    ConfigParserDel(worker);
+}
+
+/**
+**	Worker thread, parses include files in source order.
+**
+**	@param arg	include files of main file
+*/
+static void *ParseJobsWorker(void *arg)
+{
+    ParseJobs *jobs;
+    int i;
+
+    jobs = arg;
+    while ((i = __atomic_fetch_add(&jobs->Taken, 1, __ATOMIC_RELAXED))
+	< jobs->JobN) {
+	ParseJobRun(jobs, jobs->Jobs + i);
+
+	pthread_mutex_lock(&jobs->Lock);
+	jobs->Jobs[i].Done = 1;
+	pthread_cond_broadcast(&jobs->Cond);
+	pthread_mutex_unlock(&jobs->Lock);
+    }
+    return NULL;
+}
+
+/**
+**	Release include file parsed by worker.
+**
+**	@param job	include file
+*/
+static void ParseJobFree(ParseJob * job)
+{
+    free(job->Name);
+    free(job->Log);
+    if (job->Root) {
+	ArenaDel(job->Root);
+    }
+}
+
+/**
+**	Start worker threads for the include files of the main file.
+**
+**	@param parser	config parser with memory input of main file
+*/
+static void ParseJobsStart(ConfigParser * parser)
+{
+    ParseJobs *jobs;
+    char **names;
+    int n;
+    int i;
+
+    if (!(n = DescentIncludes(parser, &names))) {
+	return;
+    }
+    jobs = calloc(1, sizeof(*jobs));
+    jobs->Name = strdup(parser->Name);
+#ifdef USE_CORE_RC_RELOAD
+    jobs->Track = parser->Track;
+#endif
+    jobs->Strings = parser->Strings;
+    jobs->Jobs = calloc(n, sizeof(*jobs->Jobs));
+    for (i = 0; i < n; ++i) {
+	jobs->Jobs[i].Name = names[i];
+    }
+    free(names);
+    jobs->JobN = n;
+    pthread_mutex_init(&jobs->Lock, NULL);
+    pthread_cond_init(&jobs->Cond, NULL);
+
+    n = parser->Threads < n ? parser->Threads : n;
+    jobs->Threads = malloc(n * sizeof(*jobs->Threads));
+    for (i = 0; i < n; ++i) {
+	if (pthread_create(jobs->Threads + i, NULL, ParseJobsWorker, jobs)) {
+	    break;
+	}
+    }
+    jobs->ThreadN = i;
+    parser->Jobs = jobs;
+    if (!i) {				// no threads, parse all in order
+	jobs->Next = jobs->JobN;
+    }
+}
+
+/**
+**	Stop worker threads and release include files not replayed.
+**
+**	@param parser	config parser of main file
+*/
+static void ParseJobsStop(ConfigParser * parser)
+{
+    ParseJobs *jobs;
+    int i;
+
+    if (!(jobs = parser->Jobs)) {
+	return;
+    }
+    // no more jobs for the workers
+    __atomic_store_n(&jobs->Taken, jobs->JobN, __ATOMIC_RELAXED);
+    for (i = 0; i < jobs->ThreadN; ++i) {
+	pthread_join(jobs->Threads[i], NULL);
+    }
+    for (i = 0; i < jobs->JobN; ++i) {
+	ParseJobFree(jobs->Jobs + i);
+    }
+    pthread_cond_destroy(&jobs->Cond);
+    pthread_mutex_destroy(&jobs->Lock);
+    free(jobs->Threads);
+    free(jobs->Jobs);
+    free(jobs->Name);
+    free(jobs);
+
+    parser->Jobs = NULL;
+}
+
+/**
+**	Replay assign log of include file parsed by worker.
+**
+**	@param parser	config parser of main file
+**	@param job	include file parsed by worker
+*/
+static void ParseJobReplay(ConfigParser * parser, ParseJob * job)
+{
+    size_t i;
+    size_t n;
+
+#ifdef USE_CORE_RC_RELOAD
+    ConfigArena *arena;
+    ConfigFragment *fragment;
+#endif
+
+#ifdef USE_CORE_RC_RELOAD
+    arena = parser->Arena;
+    fragment = parser->Fragment;
+    if (job->Root->FragmentN) {		// include file is a fragment
+	parser->Fragment = job->Root->Fragments[0];
+	parser->Arena = parser->Fragment->Arena;
+    }
+#endif
+    for (i = 0; i < job->LogN; i += n + 2) {
+	const ConfigObject **log;
+	size_t k;
+
+	// number of keys, keys, value
+	log = job->Log + i;
+	n = ConfigInteger(log[0]);
+	ParseLvalue(parser);
+	for (k = 1; k < n; ++k) {
+	    ParseDot(parser, log[k], log[k + 1]);
+	    ParsePop(parser);
+	}
+	ParseAssign(parser, log[n], log[n + 1]);
+    }
+#ifdef USE_CORE_RC_RELOAD
+    parser->Arena = arena;
+    parser->Fragment = fragment;
+#endif
+
+    ArenaMerge(parser->Root, job->Root);
+    job->Root = NULL;
+}
+
+/**
+**	Parse include file of main file.
+**
+**	Include files of the main file are taken from the workers in source
+**	order, all others are parsed in order.
+**
+**	@param parser	config parser of main file
+**	@param filename	config include file name
+*/
+static void ParseJobsInclude(ConfigParser * parser, const char *filename)
+{
+    ParseJobs *jobs;
+    ParseJob *job;
+
+    jobs = parser->Jobs;
+    if (!jobs->Nested && jobs->Next < jobs->JobN
+	&& !strcmp(jobs->Jobs[jobs->Next].Name, filename)) {
+	job = jobs->Jobs + jobs->Next++;
+
+	pthread_mutex_lock(&jobs->Lock);
+	while (!job->Done) {
+	    pthread_cond_wait(&jobs->Cond, &jobs->Lock);
+	}
+	pthread_mutex_unlock(&jobs->Lock);
+
+	if (!job->Fallback) {
+	    ParseJobReplay(parser, job);
+	    return;
+	}
+    }
+    ++jobs->Nested;
+    ParseRecursive(parser, filename);
+    --jobs->Nested;
+}
+
+#endif
+
+/**
+**	Create a new config parser.
+**
+**	The strings of configs read with this parser are collected in a
+**	private string pool and merged into the global string pool, after
+**	the config is parsed.  Each thread can use its own parser.
+**
+**	@returns new config parser.
+*/
+ConfigParser *ConfigParserNew(void)
+{
+    ConfigParser *parser;
+
+    parser = calloc(1, sizeof(*parser));
+    parser->Yy = calloc(1, sizeof(yycontext));
+    parser->Yy->Parser = parser;
+    parser->PrivateStrings = 1;
+#ifdef USE_CORE_RC_DESCENT
+    parser->Descent = 1;
+    pthread_once(&ScanOnce, ScanInit);
+#endif
+
+    return parser;
+}
+
+/**
+**	Delete a config parser.
+**
+**	@param parser	config parser
+*/
+void ConfigParserDel(ConfigParser * parser)
+{
+    yyrelease(parser->Yy);
+    free(parser->Yy);
+#ifdef USE_CORE_RC_DESCENT
+    free(parser->Text);
+#endif
+#ifdef USE_CORE_RC_PARALLEL
+    free(parser->Log);
+#endif
+    free(parser);
+}
+
+#ifdef USE_CORE_RC_PARALLEL
+
+/**
+**	Set number of threads parsing the include files of the main file.
+**
+**	The include files are merged in source order, the config is the
+**	same as parsed by one thread.  Only mapped or memory input is
+**	parsed with threads.
+**
+**	@param parser	config parser
+**	@param threads	number of threads, 0 parses all files in order
+*/
+void ConfigParserSetThreads(ConfigParser * parser, int threads)
+{
+    parser->Threads = threads;
+}
+
+#endif
+
+/**
+**	Read configuration from file stream with parser.
+**
+**	@param parser	config parser
+**	@param import	import another config (freed)
+**	@param file	configuration file stream, NULL is used internal for
+**			memory input
+**
+**	@returns configuration as dictionary.
+*/
+Config *ConfigParserRead(ConfigParser * parser, Config * import, FILE * file)
+{
+    Config *config;
+    Array *remap;
+    int imported;
+
+    parser->File = file;
+    parser->LineNr = 1;
+
+    ParseStart(parser);
+
+    if (!ConfigIsArray(ConfigDict(import))
+	|| ConfigArrayKind(ConfigDict(import)) != CONFIG_ARRAY_CORE) {
+	if (import) {			// mapped or persistent config
+	    fprintf(stderr, "core-rc: import is no modifiable array\n");
+	    ConfigFreeMem(import);
+	}
+	parser->CurrentArray = ArrayNew();
+	parser->Arena = ArenaNew();
+	imported = 0;
+    } else {
+	parser->CurrentArray = ConfigArray(ConfigDict(import));
+	parser->Arena = import->Arena;
+	free(import);
+	imported = 1;
+    }
+
+    parser->GlobalArray = parser->CurrentArray;
+    parser->CurrentIndex = 0;
+    parser->Root = parser->Arena;
+
+    if (parser->Name && file && file != stdin) {
+	ArenaAddFile(parser->Root, parser->Name);
+#ifdef USE_CORE_RC_RELOAD
+	// imported values can't be reparsed
+	if (!imported) {
+	    parser->Track = 1;
+	    parser->Depth = 0;
+	    parser->Fragment = FragmentNew();
+	    ArenaAddFragment(parser->Root, parser->Fragment);
+	    parser->Arena = parser->Fragment->Arena;
+	    FragmentAddFile(parser->Fragment, parser->Name, file);
+	    parser->Hash = FILE_HASH_BASIS;
+	}
+#endif
+    }
+
+#ifdef USE_CORE_RC_PARALLEL
+    if (parser->Threads > 0 && parser->Input && parser->Descent) {
+	ParseJobsStart(parser);
+    }
+#endif
+    ParseFile(parser);
+#ifdef USE_CORE_RC_PARALLEL
+    ParseJobsStop(parser);
+#endif
+
+#ifdef never_DEBUG_CORE_RC
+    if (0) {
+	printf("Strings:\n");
+	StringPoolDump(parser->Strings, 0);
+    }
+    if (0) {
+	printf("Final %d ConfigArray:\n", parser->CurrentIndex);
+	ParseDump(parser->CurrentArray, 0);
+    }
+#endif
+
+    yyrelease(parser->Yy);
+
+#ifdef USE_CORE_RC_RELOAD
+    if (parser->Track) {
+	parser->Fragment->Files[0].Hash = parser->Hash;
+	parser->Fragment = NULL;
+	parser->Track = 0;
+    }
+#endif
+
+    config = malloc(sizeof(*config));
+    config->Pointer = parser->CurrentArray;
+    config->Arena = parser->Root;
+    config->Generation = ConfigNextGeneration();
+    parser->Arena = NULL;
+    parser->Root = NULL;
+
+    if ((remap = ParseStop(parser))) {
+	ParseRemap(config, remap);
+	ArrayFree(remap);
+    }
+    parser->Name = NULL;
+    if (imported) {			// reference moved to new config
+	ConfigStringsUnref();
+    }
+
+    return config;
+}
+
+/**
+**	Read configuration from file with parser.
+**
+**	@param parser	config parser
+**	@param import	import another config (freed)
+**	@param filename	configuration file name, use "-" for stdin.
+*/
+Config *ConfigParserReadFile(ConfigParser * parser, Config * import,
+    const char *filename)
+{
+    FILE *file;
+    Config *config;
+    char *addr;
+
+    // open configuration file
+    if (filename && strcmp(filename, "-")) {
+	file = fopen(filename, "rb");
+    } else {
+	file = stdin;
+    }
+    if (!file) {
+	fprintf(stderr, "can't open configuration file '%s'\n", filename);
+	return NULL;
+    }
+    // read configuration file, regular files are mapped
+    parser->Name = filename;
+    addr = file != stdin ? ParseMap(parser, file) : NULL;
+    config = ConfigParserRead(parser, import, file);
+    ParseUnmap(parser, addr);
+
+    // close config file
+    if (file != stdin) {
+	fclose(file);
+    }
+    return config;
+}
+
+/**
+**	Read configuration from memory with parser.
+**
+**	@param parser	config parser
+**	@param import	import another config (freed)
+**	@param buf	configuration text, needs no terminating zero
+**	@param len	length of configuration text
+**	@param name	name of configuration, used for messages and as
+**			base of relative include files, can be NULL
+**
+**	@returns configuration as dictionary.
+*/
+Config *ConfigParserReadMemory(ConfigParser * parser, Config * import,
+    const char *buf, size_t len, const char *name)
+{
+    Config *config;
+
+    parser->Name = name ? name : "-";
+    parser->Input = buf;
+    parser->InputEnd = buf + len;
+    config = ConfigParserRead(parser, import, NULL);
+    ParseUnmap(parser, NULL);
+
+    return config;
+}
+
+/**
+**	Read configuration from file stream.
+**
+**	Uses a temporary #ConfigParser, its strings are merged into the
+**	global string pool after the parse.
+**
+**	@param import	import another config (freed)
+**	@param file	configuration file stream
+**
+**	@returns configuration as dictionary.
+**
+**	@code
+**	    //
+**	    //	export constants
+**	    //
+**	    config = ConfigNewConfig(NULL);
+**	    for (i = 0; i < n; ++i) {
+**		ConfigDefine(config, ConfigNewString(import[i].Index),
+**		    ConfigNewString(import[i].Value));
+**	    }
+**	@endcode
+*/
+Config *ConfigRead2(Config * import, FILE * file)
+{
+    ConfigParser *parser;
+    Config *config;
+
+    parser = ConfigParserNew();
+    config = ConfigParserRead(parser, import, file);
+    ConfigParserDel(parser);
+
+    return config;
+}
+
+/**
+**	Read configuration from memory.
+**
+**	Configs embedded into the program or received over the network are
+**	parsed without temporary file.	The configuration can't be reloaded.
+**
+**	@param import	import another config (freed)
+**	@param buf	configuration text, needs no terminating zero
+**	@param len	length of configuration text
+**	@param name	name of configuration, used for messages and as
+**			base of relative include files, can be NULL
+**
+**	@returns configuration as dictionary.
+*/
+Config *ConfigReadMemory(Config * import, const char *buf, size_t len,
+    const char *name)
+{
+    ConfigParser *parser;
+    Config *config;
+
+    parser = ConfigParserNew();
+    config = ConfigParserReadMemory(parser, import, buf, len, name);
+    ConfigParserDel(parser);
+
+    return config;
+}
+
+/**
+**	Read configuration from file.
+**
+**	Regular files are mapped into memory and parsed without stdio.
+**
+**	@param import	import another config (freed)
+**	@param filename	configuration file name, use "-" for stdin.
+*/
+Config *ConfigReadFile2(Config * import, const char *filename)
+{
+    ConfigParser *parser;
+    Config *config;
+
+    parser = ConfigParserNew();
+    config = ConfigParserReadFile(parser, import, filename);
+    ConfigParserDel(parser);
+
+    return config;
+}
+
+#ifdef USE_CORE_RC_RELOAD
+
+/**
+**	Check if a changed fragment can be replaced.
+**
+**	A fragment reading variables depends on the other fragments.
+**	Top-level keys written also by other fragments depend on the
+**	order of the statements.  Fragments reading keys of the changed
+**	fragment share its values.
+**
+**	@param fragments	all fragments of the config
+**	@param n		number of fragments
+**	@param i		index of changed fragment
+**	@param fragment		old or reparsed changed fragment
+**
+**	@returns true if the fragment is independent.
+*/
+static int ConfigReloadIndependent(ConfigFragment * const *fragments, int n,
+    int i, const ConfigFragment * fragment)
+{
+    size_t index;
+    int j;
+
+    index = 0;
+    if (ArrayFirst(fragment->Reads, &index)) {
+	return 0;
+    }
+    for (j = 0; j < n; ++j) {
+	if (j != i && (FragmentKeysIntersect(fragment->Keys, fragments[j]->Keys)
+		|| FragmentKeysIntersect(fragment->Keys,
+		    fragments[j]->Reads))) {
+	    return 0;
+	}
+    }
+    return 1;
+}
+
+/**
+**	Reload a config, reparse only the changed include files.
+**
+**	The files included by the main file are fragments of the config.
+**	Only changed fragments are reparsed and their top-level keys
+**	spliced into a copy of the top-level array.  The values of the
+**	unchanged fragments are shared with the old config.  If the main
+**	file has changed or a changed fragment depends on the other
+**	fragments, the config is parsed again completely.
+**
+**	@param config	config read by ConfigReadFile2() or
+**			ConfigParserReadFile() without import, stays valid
+**
+**	@returns reloaded config, NULL if the config can't be reloaded.
+**
+**	@note values added by ConfigDefine() force a complete parse and
+**	aren't included in the reloaded config.
+*/
+Config *ConfigReload(const Config * config)
+{
+    const ConfigArena *root;
+    ConfigFragment **fragments;
+    ConfigParser *parser;
+    Config *reloaded;
+    Array **tops;
+    Array *remap;
+    char *changed;
+    int n;
+    int i;
+    int j;
+
+    root = config->Arena;
+    if (!(n = root->FragmentN)) {
+	fprintf(stderr, "core-rc: config can't be reloaded\n");
+	return NULL;
+    }
+    if (root->Modified || FragmentChanged(root->Fragments[0])) {
+	goto full;
+    }
+
+    changed = calloc(n, sizeof(*changed));
+    for (i = 1; i < n; ++i) {
+	if ((changed[i] = FragmentChanged(root->Fragments[i]))
+	    && !ConfigReloadIndependent(root->Fragments, n, i,
+		root->Fragments[i])) {
+	    free(changed);
+	    goto full;
+	}
+    }
+
+    //
+    //	reparse changed fragments, each into its own top-level array
+    //
+    parser = ConfigParserNew();
+    ParseStart(parser);
+    parser->Root = ArenaNew();
+    parser->Arena = parser->Root;
+    parser->Name = root->Files[0];
+    parser->Track = 1;
+
+    fragments = malloc(n * sizeof(*fragments));
+    tops = calloc(n, sizeof(*tops));
+    for (i = 0; i < n; ++i) {
+	fragments[i] = root->Fragments[i];
+	if (changed[i]) {
+	    parser->CurrentArray = ArrayNew();
+	    parser->GlobalArray = parser->CurrentArray;
+	    parser->CurrentIndex = 0;
+	    ParseRecursive(parser, fragments[i]->Files[0].Name);
+	    tops[i] = parser->GlobalArray;
+	    fragments[i] =
+		parser->Root->Fragments[parser->Root->FragmentN - 1];
+	}
+    }
+    if ((remap = ParseStop(parser))) {
+	for (i = 0; i < n; ++i) {
+	    if (changed[i]) {
+		ParseRemapArray(&tops[i], remap);
+	    }
+	}
+	ParseRemapArena(parser->Root, remap);
+	ArrayFree(remap);
+    }
+
+    // reparsed fragments may have new dependencies
+    for (i = 0; i < n; ++i) {
+	if (changed[i] && !ConfigReloadIndependent(fragments, n, i,
+		fragments[i])) {
+	    break;
+	}
+    }
+    if (i < n) {
+	for (i = 0; i < n; ++i) {
+	    ArrayFree(tops[i]);
+	}
+	ArenaDel(parser->Root);
+	ConfigParserDel(parser);
+	free(tops);
+	free(fragments);
+	free(changed);
+	ConfigStringsUnref();
+	goto full;
+    }
+
+    //
+    //	splice the top-level keys of all fragments
+    //
+    reloaded = malloc(sizeof(*reloaded));
+    reloaded->Pointer = ArrayNew();
+    reloaded->Arena = ArenaNew();
+    reloaded->Generation = ConfigNextGeneration();
+    for (i = 0; i < n; ++i) {
+	size_t index;
+	size_t *value;
+
+	if (changed[i]) {		// reference moves from parser
+	    index = 0;
+	    value = ArrayFirst(tops[i], &index);
+	    while (value) {
+		ArrayIns((Array **) & reloaded->Pointer, index, *value);
+		value = ArrayNext(tops[i], &index);
+	    }
+	    ArrayFree(tops[i]);
+#ifdef USE_CORE_RC_STATISTICS
+	    ++ObjectPoolStat.Fragments;
+#endif
+	} else {
+	    FragmentRef(fragments[i]);
+	    index = 0;
+	    value = ArrayFirst(fragments[i]->Keys, &index);
+	    while (value) {
+		size_t v;
+
+		if ((v = ArrayGet(config->Pointer, index))) {
+		    ArrayIns((Array **) & reloaded->Pointer, index, v);
+		}
+		value = ArrayNext(fragments[i]->Keys, &index);
+	    }
+	}
+	ArenaAddFragment(reloaded->Arena, fragments[i]);
+	for (j = 0; j < fragments[i]->FileN; ++j) {
+	    ArenaAddFile(reloaded->Arena, fragments[i]->Files[j].Name);
+	}
+    }
+    parser->Root->FragmentN = 0;	// fragments moved to reloaded config
+    ArenaDel(parser->Root);
+    ConfigParserDel(parser);
+    free(tops);
+    free(fragments);
+    free(changed);
+
+#ifdef USE_CORE_RC_STATISTICS
+    ++ObjectPoolStat.Reloads;
+#endif
+    return reloaded;
+
+  full:
+#ifdef USE_CORE_RC_STATISTICS
+    ++ObjectPoolStat.FullReloads;
+#endif
+    parser = ConfigParserNew();
+    reloaded = ConfigParserReadFile(parser, NULL, root->Files[0]);
+    ConfigParserDel(parser);
+
+    return reloaded;
+}
+
+#endif
+
+/**
+**	Get the files read into config.
+**
+**	The main file and all included files, also missing include files.
+**
+**	@param config	config dictionary
+**	@param[out] n	number of files
+**
+**	@returns array of file names, valid until the config is freed.
+*/
+const char *const *ConfigFiles(const Config * config, int *n)
+{
+    *n = config->Arena->FileN;
+    return (const char *const *)config->Arena->Files;
+}
+
+#ifndef USE_CORE_RC_READ2
+
+/**
+**	Read configuration from file stream.
+**
+**	@param ni	number of import contants
+**	@param import	import constants
+**	@param file	configuration file stream
+**
+**	@todo constants and predefined values must be imported
+*/
+Config *ConfigRead(int ni, const ConfigImport * import, FILE * file)
+{
+    int i;
+    Array *array;
+    Config *config;
+
+#if defined(DEBUG_CORE_RC) || defined(DEBUG)
+    if (ConfigStrings) {
+	fprintf(stderr, "new core-rc reuses string pool\n");
+    }
+#endif
+    config = ConfigNewConfig(NULL);
+
+    //
+    //	export constants
+    //
+    array = ArrayNew();
+    for (i = 0; i < ni; ++i) {
+	size_t *vp;
+	size_t v;
+
+	v = (size_t)ConfigNewString(import[i].Value);
+	vp = ArrayIns(&array, (size_t)ConfigNewString(import[i].Index), v);
+	if (*vp != v) {
+	    fprintf(stderr, "overwrite old value\n");
+	    *vp = v;
+	}
+    }
+    config->Pointer = array;
+
+    return ConfigRead2(config, file);
+}
+
+/**
+**	Read configuration from file.
+**
+**	@param ni	number of import contants
+**	@param import	import constants
+**	@param filename	configuration file name, use "-" for stdin.
+*/
+Config *ConfigReadFile(int ni, const ConfigImport * import,
+    const char *filename)
+{
+    int i;
+    Array *array;
+    Config *config;
+
+#if defined(DEBUG_CORE_RC) || defined(DEBUG)
+    if (ConfigStrings) {
+	fprintf(stderr, "new core-rc reuses string pool\n");
+    }
+#endif
+    config = ConfigNewConfig(NULL);
+
+    //
+    //	export constants
+    //
+    array = ArrayNew();
+    for (i = 0; i < ni; ++i) {
+	size_t *vp;
+	size_t v;
+
+	v = (size_t)ConfigNewString(import[i].Value);
+	vp = ArrayIns(&array, (size_t)ConfigNewString(import[i].Index), v);
+	if (*vp != v) {
+	    fprintf(stderr, "overwrite old value\n");
+	    *vp = v;
+	}
+    }
+    config->Pointer = array;
+
+    return ConfigReadFile2(config, filename);
+}
+
+#endif
+
+#ifdef USE_CORE_RC_WRITE
+
+/**
+**	Write configuration to file stream.
+**
+**	@param config	config dictionary
+**	@param out	output stream
+**
+**	@returns false if no failures, true otherwise.
+**
+**	@todo not correct, must handle top level special.
+*/
+int ConfigWrite(const Config * config, FILE * stream)
+{
+    ConfigPrint(ConfigDict(config), 0, stream);
+    fprintf(stream, "\n");
+
+    return 0;
+}
+
+/**
+**	Write configuration to file name.
+**
+**	@param config	config dictionary
+**	@param filename	output filename
+**
+**	@returns false if no failures, true otherwise.
+*/
+int ConfigWriteFile(const Config * config, const char *filename)
+{
+    FILE *file;
+    int err;
+
+    // open configuration file
+    if (filename && strcmp(filename, "-")) {
+	file = fopen(filename, "wb");
+    } else {
+	file = stdout;
+    }
+    if (!file) {
+	fprintf(stderr, "can't open configuration file '%s'\n", filename);
+	return -1;
+    }
+    // write configuration file
+    fprintf(file, "; %s\n", filename);
+    err = ConfigWrite(config, file);
+
+    // close configuration file
+    if (file != stdout) {
+	fclose(file);
+    }
+    return err;
+}
+#endif
+
+#ifdef USE_CORE_RC_BINARY
+
+// ------------------------------------------------------------------------ //
+// Binary snapshot
+// ------------------------------------------------------------------------ //
+
+///
+///	@defgroup binary The binary snapshot module.
+///
+///	A config can be written as binary snapshot with ConfigWriteBinary()
+///	and mapped read-only with ConfigMapBinary().  The mapped config is
+///	used without parsing and without allocating objects; the normal get
+///	functions work on it.
+///
+///	All arrays of the snapshot are frozen arrays (#CONFIG_ARRAY_FROZEN)
+///	or vector arrays (#CONFIG_ARRAY_VECTOR) and its pointers are stored
+///	for a preferred address.  If the file
+///	can be mapped there, its pages are shared by all processes mapping
+///	it.  Otherwise a private copy is relocated with the relocation
+///	table of the file.
+///
+///	@note a snapshot can only be mapped on the same architecture.
+///
+/// @{
+
+#define CONFIG_BINARY_MAGIC "CORE-RC"	///< magic of binary snapshot
+#if defined(USE_CORE_RC_NAN_BOX) && defined(USE_CORE_RC_SHORT_STRING)
+#define CONFIG_BINARY_VERSION 0x303	///< version, NaN-boxed, short strings
+#elif defined(USE_CORE_RC_NAN_BOX)
+#define CONFIG_BINARY_VERSION 0x103	///< version, NaN-boxed values
+#elif defined(USE_CORE_RC_SHORT_STRING)
+#define CONFIG_BINARY_VERSION 0x203	///< version, short strings
+#else
+#define CONFIG_BINARY_VERSION 3		///< version of binary snapshot
+#endif
+
+#if SIZE_MAX == (18446744073709551615UL)
+#define CONFIG_BINARY_BASE 0x7a0000000000UL	///< preferred map address
+#else
+#define CONFIG_BINARY_BASE 0x60000000UL	///< preferred map address
+#endif
+
+/**
+**	Binary snapshot file header.
+*/
+typedef struct _config_binary_header_
+{
+    char Magic[8];			///< #CONFIG_BINARY_MAGIC
+    unsigned Version;			///< #CONFIG_BINARY_VERSION
+    unsigned PointerSize;		///< size of pointers in file
+    size_t Base;			///< address pointers are stored for
+    size_t Size;			///< size of file
+    size_t Root;			///< offset of top-level frozen array
+    size_t Relocs;			///< offset of relocation table
+    size_t RelocN;			///< entries in relocation table
+} ConfigBinaryHeader;
+
+/**
+**	Binary snapshot writer.
+*/
+typedef struct _binary_writer_
+{
+    char *Data;				///< snapshot in memory
+    size_t Size;			///< used bytes of data
+    size_t Max;				///< allocated bytes of data
+    size_t *Relocs;			///< offsets of pointers in data
+    size_t RelocN;			///< number of relocations
+    size_t RelocMax;			///< allocated relocations
+    Array *Memo;			///< written objects to stored value
+} BinaryWriter;
+
+/**
+**	Binary snapshot array item, used for sorting.
+*/
+typedef struct _binary_item_
+{
+    size_t Original;			///< key object in memory
+    size_t Key;				///< key as stored in snapshot
+    size_t Value;			///< value as stored in snapshot
+} BinaryItem;
+
+/**
+**	Allocate zeroed space in binary snapshot.
+**
+**	@param writer	binary snapshot writer
+**	@param size	number of bytes needed
+**
+**	@returns offset of the 8-byte aligned space.
+*/
+static size_t BinaryAlloc(BinaryWriter * writer, size_t size)
+{
+    size_t offset;
+
+    offset = writer->Size;
+    size = (size + 7) & ~7;
+    if (offset + size > writer->Max) {
+	while (offset + size > writer->Max) {
+	    writer->Max = writer->Max ? writer->Max * 2 : 4096;
+	}
+	writer->Data = realloc(writer->Data, writer->Max);
+    }
+    memset(writer->Data + offset, 0, size);
+    writer->Size += size;
+
+    return offset;
+}
+
+/**
+**	Store a word in binary snapshot.
+**
+**	@param writer	binary snapshot writer
+**	@param offset	offset of word
+**	@param value	value to store
+**	@param pointer	true if value is an address, which needs relocation
+*/
+static void BinaryStore(BinaryWriter * writer, size_t offset, size_t value,
+    int pointer)
+{
+    *(size_t *)(writer->Data + offset) = value;
+    if (!pointer) {
+	return;
+    }
+    if (writer->RelocN == writer->RelocMax) {
+	writer->RelocMax = writer->RelocMax ? writer->RelocMax * 2 : 256;
+	writer->Relocs =
+	    realloc(writer->Relocs, writer->RelocMax * sizeof(size_t));
+    }
+    writer->Relocs[writer->RelocN++] = offset;
+}
+
+/**
+**	Compare two items of binary snapshot array.
+**
+**	Words are compared by the strings in memory, the others by the
+**	stored values, which gives the order of FrozenCompare().
+*/
+static int BinaryItemCompare(const void *a, const void *b)
+{
+    const BinaryItem *x;
+    const BinaryItem *y;
+
+    x = a;
+    y = b;
+    if (ConfigIsWord((const ConfigObject *)x->Key)
+	&& ConfigIsWord((const ConfigObject *)y->Key)) {
+	return ConfigWordCompare((const ConfigObject *)x->Original,
+	    (const ConfigObject *)y->Original);
+    }
+    return FrozenCompare(x->Key, y->Key);
+}
+
+    /// write object into binary snapshot
+static size_t BinaryObject(BinaryWriter *, const ConfigObject *);
+
+/**
+**	Write frozen array into binary snapshot.
+**
+**	@param writer	binary snapshot writer
+**	@param object	array object of any kind
+**
+**	@returns offset of frozen array.
+*/
+static size_t BinaryArray(BinaryWriter * writer, const ConfigObject * object)
+{
+    BinaryItem *items;
+    size_t n;
+    size_t max;
+    size_t i;
+    size_t offset;
+    size_t index;
+    const size_t *value;
+
+    items = NULL;
+    n = 0;
+    max = 0;
+    index = 0;
+    value = ObjectArrayFirst(object, &index);
+    while (value) {
+	if (n == max) {
+	    max = max ? max * 2 : 16;
+	    items = realloc(items, max * sizeof(*items));
+	}
+	items[n].Original = index;
+	items[n].Key = BinaryObject(writer, (const ConfigObject *)index);
+	items[n].Value = BinaryObject(writer, (const ConfigObject *)*value);
+	++n;
+	value = ObjectArrayNext(object, &index);
+    }
+    if (n > 1) {
+	qsort(items, n, sizeof(*items), BinaryItemCompare);
+    }
+
+    offset = BinaryAlloc(writer, sizeof(FrozenArray) + n * sizeof(FrozenItem));
+    BinaryStore(writer, offset + offsetof(FrozenArray, N), n, 0);
+    for (i = 0; i < n; ++i) {
+	size_t item;
+
+	item = offset + sizeof(FrozenArray) + i * sizeof(FrozenItem);
+	BinaryStore(writer, item + offsetof(FrozenItem, Key), items[i].Key,
+	    ConfigIsObject((const ConfigObject *)items[i].Key));
+	BinaryStore(writer, item + offsetof(FrozenItem, Value), items[i].Value,
+	    ConfigIsObject((const ConfigObject *)items[i].Value));
+    }
+    free(items);
+
+    return offset;
+}
+
+/**
+**	Write vector array into binary snapshot.
+**
+**	@param writer	binary snapshot writer
+**	@param object	array object of kind #CONFIG_ARRAY_VECTOR
+**
+**	@returns offset of vector array.
+*/
+static size_t BinaryVector(BinaryWriter * writer, const ConfigObject * object)
+{
+    const VectorArray *vector;
+    size_t offset;
+    size_t i;
+
+    vector = ConfigVector(object);
+    offset = BinaryAlloc(writer,
+	sizeof(VectorArray) + vector->N * sizeof(*vector->Values));
+    BinaryStore(writer, offset + offsetof(VectorArray, N), vector->N, 0);
+    for (i = 0; i < vector->N; ++i) {
+	size_t value;
+
+	value = BinaryObject(writer, (const ConfigObject *)vector->Values[i]);
+	BinaryStore(writer,
+	    offset + sizeof(VectorArray) + i * sizeof(*vector->Values), value,
+	    ConfigIsObject((const ConfigObject *)value));
+    }
+
+    return offset;
+}
+
+/**
+**	Write object into binary snapshot.
+**
+**	Objects reachable more than once are written only once.
+**
+**	@param writer	binary snapshot writer
+**	@param object	tagged object pointer
+**
+**	@returns tagged object as stored in snapshot.
+*/
+static size_t BinaryObject(BinaryWriter * writer, const ConfigObject * object)
+{
+    size_t offset;
+    size_t value;
+
+    if (!ConfigIsObject(object)) {	// numbers and short strings
+	return (size_t)object;
+    }
+    if ((value = ArrayGet(writer->Memo, (size_t)object))) {
+	return value;
+    }
+    if (ConfigIsWord(object)) {
+	const char *string;
+	size_t length;
+	size_t bytes;
+
+	// string with its header, as in string pools
+	string = ConfigString(object, NULL);
+	length = StringPoolHeader(string)->Length + 1;
+	bytes = BinaryAlloc(writer, sizeof(StringHeader) + length);
+	memcpy(writer->Data + bytes, string - sizeof(StringHeader),
+	    sizeof(StringHeader) + length);
+
+	offset = BinaryAlloc(writer, sizeof(ConfigObject));
+	BinaryStore(writer, offset,
+	    CONFIG_BINARY_BASE + bytes + sizeof(StringHeader), 1);
+	value = CONFIG_BINARY_BASE + offset + 4;
+	ArrayIns(&writer->Memo, (size_t)object, value);
+	return value;
+    }
+    // array: remember the object before its items, arrays can be cyclic
+    offset = BinaryAlloc(writer, sizeof(ConfigObject));
+    value = CONFIG_BINARY_BASE + offset;
+    ArrayIns(&writer->Memo, (size_t)object, value);
+    if (ConfigArrayKind(object) == CONFIG_ARRAY_VECTOR) {
+	BinaryStore(writer, offset, CONFIG_BINARY_BASE
+	    + BinaryVector(writer, object) + CONFIG_ARRAY_VECTOR, 1);
+	return value;
+    }
+    BinaryStore(writer, offset,
+	CONFIG_BINARY_BASE + BinaryArray(writer, object) + CONFIG_ARRAY_FROZEN,
+	1);
+
+    return value;
+}
+
+/**
+**	Write configuration as binary snapshot.
+**
+**	The snapshot is written to a temporary file, which is renamed to
+**	@a filename.  Processes which have mapped the old file keep it.
+**
+**	@param config	config dictionary
+**	@param filename	output filename
+**
+**	@returns false if no failures, true otherwise.
+*/
+int ConfigWriteBinary(const Config * config, const char *filename)
+{
+    BinaryWriter writer;
+    ConfigBinaryHeader *header;
+    size_t root;
+    size_t relocs;
+    char *tmp;
+    FILE *file;
+    int err;
+
+    memset(&writer, 0, sizeof(writer));
+    writer.Memo = ArrayNew();
+
+    BinaryAlloc(&writer, sizeof(*header));
+    root = BinaryArray(&writer, ConfigDict(config));
+    relocs = BinaryAlloc(&writer, writer.RelocN * sizeof(size_t));
+    if (writer.RelocN) {
+	memcpy(writer.Data + relocs, writer.Relocs,
+	    writer.RelocN * sizeof(size_t));
+    }
+
+    header = (ConfigBinaryHeader *) writer.Data;
+    memcpy(header->Magic, CONFIG_BINARY_MAGIC, sizeof(header->Magic));
+    header->Version = CONFIG_BINARY_VERSION;
+    header->PointerSize = sizeof(size_t);
+    header->Base = CONFIG_BINARY_BASE;
+    header->Size = writer.Size;
+    header->Root = root;
+    header->Relocs = relocs;
+    header->RelocN = writer.RelocN;
+
+    ArrayFree(writer.Memo);
+    free(writer.Relocs);
+
+    // write binary snapshot file
+    tmp = malloc(strlen(filename) + 5);
+    stpcpy(stpcpy(tmp, filename), ".tmp");
+    if (!(file = fopen(tmp, "wb"))) {
+	fprintf(stderr, "can't open binary file '%s'\n", tmp);
+	free(writer.Data);
+	free(tmp);
+	return -1;
+    }
+    err = fwrite(writer.Data, 1, writer.Size, file) != writer.Size;
+    err |= fclose(file) != 0;
+    if (!err && rename(tmp, filename)) {
+	fprintf(stderr, "can't rename binary file '%s'\n", tmp);
+	err = 1;
+    }
+    if (err) {
+	unlink(tmp);
+    }
+    free(writer.Data);
+    free(tmp);
+
+    return err;
+}
+
+/**
+**	Map binary snapshot of configuration.
+**
+**	@param filename	binary snapshot file written by ConfigWriteBinary()
+**
+**	@returns the mapped config, NULL if failures.  The config must be
+**	released with ConfigFreeMem() and can't be modified.
+*/
+Config *ConfigMapBinary(const char *filename)
+{
+    ConfigBinaryHeader header;
+    struct stat info;
+    Config *config;
+    char *addr;
+    int fd;
+
+    if ((fd = open(filename, O_RDONLY)) < 0) {
+	fprintf(stderr, "can't open binary file '%s'\n", filename);
+	return NULL;
+    }
+    if (fstat(fd, &info)
+	|| pread(fd, &header, sizeof(header), 0) != sizeof(header)
+	|| memcmp(header.Magic, CONFIG_BINARY_MAGIC, sizeof(header.Magic))
+	|| header.Version != CONFIG_BINARY_VERSION
+	|| header.PointerSize != sizeof(size_t) || (header.Base & 4095)
+	|| header.Size != (size_t)info.st_size
+	|| header.Root + sizeof(FrozenArray) > header.Size
+	|| header.RelocN > header.Size / sizeof(size_t)
+	|| header.Relocs + header.RelocN * sizeof(size_t) > header.Size) {
+	fprintf(stderr, "core-rc: '%s' is no binary config\n", filename);
+	close(fd);
+	return NULL;
+    }
+
+    addr = mmap((void *)header.Base, header.Size, PROT_READ, MAP_SHARED, fd,
+	0);
+    if (addr != MAP_FAILED && (size_t)addr != header.Base) {
+	// preferred address is used: relocate a private copy
+	munmap(addr, header.Size);
+	addr = mmap(NULL, header.Size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+	    0);
+	if (addr != MAP_FAILED) {
+	    const size_t *relocs;
+	    size_t delta;
+	    size_t i;
+
+	    relocs = (const size_t *)(addr + header.Relocs);
+	    delta = (size_t)addr - header.Base;
+	    for (i = 0; i < header.RelocN; ++i) {
+		if (relocs[i] > header.Size - sizeof(size_t)
+		    || (relocs[i] & 7)) {
+		    fprintf(stderr, "core-rc: '%s' bad relocation\n",
+			filename);
+		    munmap(addr, header.Size);
+		    close(fd);
+		    return NULL;
+		}
+		*(size_t *)(addr + relocs[i]) += delta;
+	    }
+	    mprotect(addr, header.Size, PROT_READ);
+	}
+    }
+    close(fd);
+    if (addr == MAP_FAILED) {
+	fprintf(stderr, "can't map binary file '%s'\n", filename);
+	return NULL;
+    }
+
+    config = malloc(sizeof(*config));
+    config->Pointer = addr + header.Root + CONFIG_ARRAY_FROZEN;
+    config->Arena = ArenaNew();
+    config->Generation = ConfigNextGeneration();
+    config->Arena->Map = addr;
+    config->Arena->MapSize = header.Size;
+
+    // lookups by name intern into the global string pool
+    pthread_mutex_lock(&ConfigStringsLock);
+    ConfigStringsRef();
+    pthread_mutex_unlock(&ConfigStringsLock);
+
+    return config;
+}
+
+/// @}
+
+#endif
+
+#ifdef USE_CORE_RC_PERSISTENT
+
+// ----------------------------------------------------------------------------
+// Persistent configs
+// ------------------------------------------------------------------------ //
+
+///
+///	@defgroup persistent The persistent config module.
+///
+///	A persistent config stores all its arrays as persistent arrays
+///	(#CONFIG_ARRAY_HAMT).  ConfigUpdate() copies only the nodes on the
+///	path to the changed key, the new version shares all other nodes
+///	with the old version.  A snapshot of a persistent config is a new
+///	reference of its root.  Each version is an own config, which is
+///	released with ConfigFreeMem(), the shared nodes are reference
+///	counted.  The versions are never modified and can be read by
+///	concurrent threads, together with #ConfigHandle an update is
+///	published without copying the config.
+///
+///	The keys of persistent arrays are iterated in the order of their
+///	hash, not sorted.  Cyclic arrays can't be converted.
+///
+/// @{
+
+static size_t HamtImport(size_t, Array **);
+
+/**
+**	Compare hashes of persistent array slots for qsort.
+**
+**	@param a	first slot
+**	@param b	second slot
+*/
+static int HamtSlotCompare(const void *a, const void *b)
+{
+    size_t ha;
+    size_t hb;
+
+    ha = HamtHash(((const HamtSlot *)a)->Key);
+    hb = HamtHash(((const HamtSlot *)b)->Key);
+    return ha < hb ? -1 : ha > hb;
+}
+
+/**
+**	Build persistent array node from leaves.
+**
+**	@param leaves	leaves sorted by hash, their references are moved
+**	@param n	number of leaves, at least one
+**	@param level	trie level of node
+**
+**	@returns node with one reference.
+*/
+static HamtNode *HamtBuild(const HamtSlot * leaves, size_t n, int level)
+{
+    HamtNode *node;
+    uint32_t bitmap;
+    unsigned index;
+    size_t i;
+    size_t j;
+    int used;
+
+    bitmap = 0;
+    for (i = 0; i < n; ++i) {
+	bitmap |= 1U << HamtIndex(HamtHash(leaves[i].Key), level);
+    }
+    node = HamtAlloc(__builtin_popcount(bitmap));
+    node->N = n;
+    node->Bitmap = bitmap;
+
+    used = 0;
+    for (i = 0; i < n; i = j) {
+	index = HamtIndex(HamtHash(leaves[i].Key), level);
+	for (j = i + 1;
+	    j < n && HamtIndex(HamtHash(leaves[j].Key), level) == index;
+	    ++j) {
+	}
+	if (j - i == 1) {
+	    node->Slots[used++] = leaves[i];
+	} else {
+	    node->Slots[used].Key = 0;
+	    node->Slots[used++].Value =
+		(size_t)HamtBuild(leaves + i, j - i, level + 1);
+	}
+    }
+
+    return node;
+}
+
+/**
+**	Convert array object into persistent array.
+**
+**	@param object		array object of any other kind
+**	@param[in,out] memo	converted arrays
+**
+**	@returns root node with one reference.
+*/
+static HamtNode *HamtFromArray(const ConfigObject * object, Array ** memo)
+{
+    HamtSlot *leaves;
+    HamtNode *node;
+    const size_t *value;
+    size_t index;
+    size_t n;
+
+    leaves = malloc((ConfigArrayLength(object) + 1) * sizeof(*leaves));
+    n = 0;
+    index = 0;
+    value = ObjectArrayFirst(object, &index);
+    while (value) {
+	leaves[n].Key = HamtImport(index, memo);
+	leaves[n].Value = HamtImport(*value, memo);
+	if (leaves[n].Key && leaves[n].Value) {
+	    ++n;
+	} else {			// cyclic array dropped
+	    HamtReleaseValue(leaves[n].Key);
+	    HamtReleaseValue(leaves[n].Value);
+	}
+	value = ObjectArrayNext(object, &index);
+    }
+    if (n > 1) {
+	qsort(leaves, n, sizeof(*leaves), HamtSlotCompare);
+    }
+    if (n) {
+	node = HamtBuild(leaves, n, 0);
+    } else {
+	node = HamtAlloc(0);
+    }
+    free(leaves);
+
+    return node;
+}
+
+/**
+**	Convert value into value of persistent array.
+**
+**	The words are interned into the global string pool, the words of
+**	mapped configs aren't stored there.  Arrays are converted once,
+**	persistent arrays are shared.
+**
+**	@param value		tagged value
+**	@param[in,out] memo	converted arrays
+**
+**	@returns tagged value with one reference, 0 for a cyclic array.
+**
+**	@note the caller must hold #ConfigStringsLock
+*/
+static size_t HamtImport(size_t value, Array ** memo)
+{
+    const ConfigObject *object;
+    const char *string;
+    HamtNode *node;
+    size_t *done;
+    size_t len;
+
+    object = (const ConfigObject *)value;
+    if (!ConfigIsObject(object)) {	// numbers and short strings
+	return value;
+    }
+    if (ConfigIsWord(object)) {
+	string = ConfigString(object, NULL);
+	len = ConfigStringLength(object);
+	return (size_t)StringPoolInsertHash(ConfigStrings, string, len,
+	    StringHash(string, len), NULL);
+    }
+    if (ConfigArrayKind(object) == CONFIG_ARRAY_HAMT) {
+	return (size_t)HamtShare(ConfigHamt(object));
+    }
+    done = ArrayIns(memo, value, 0);
+    if (*done == 1) {
+	fprintf(stderr, "core-rc: cyclic array can't be persistent\n");
+	return 0;
+    }
+    if (*done) {
+	return (size_t)HamtShare((HamtNode *) * done);
+    }
+    *done = 1;				// in progress
+    node = HamtFromArray(object, memo);
+    *ArrayIns(memo, value, 0) = (size_t)node;
+
+    return (size_t)node;
+}
+
+/**
+**	Create config of persistent array.
+**
+**	@param root	root node, its reference is moved into the config
+**
+**	@returns new config.
+**
+**	@note the caller must hold #ConfigStringsLock
+*/
+static Config *HamtConfig(HamtNode * root)
+{
+    Config *config;
+
+    ConfigStringsRef();
+    config = malloc(sizeof(*config));
+    config->Pointer = root->Pointer;
+    config->Arena = ArenaNew();
+    config->Generation = ConfigNextGeneration();
+
+    return config;
+}
+
+/**
+**	Set value at path of persistent array.
+**
+**	Missing arrays on the path are created.
+**
+**	@param node	root node, unchanged
+**	@param keys	keys of path
+**	@param n	number of keys
+**	@param value	tagged value, 0 removes the key
+**
+**	@returns new root node with one reference, NULL if a key on the path
+**	has no array value.
+*/
+static HamtNode *HamtUpdatePath(const HamtNode * node,
+    const ConfigObject ** keys, int n, size_t value)
+{
+    HamtNode *child;
+    HamtNode *copy;
+    HamtNode *root;
+    size_t old;
+
+    if (n == 1) {
+	return HamtUpdate(node, (size_t)keys[0], value);
+    }
+    old = HamtGet(node, (size_t)keys[0]);
+    if (!old) {
+	if (!value) {			// nothing to remove
+	    return HamtShare(node);
+	}
+	child = HamtAlloc(0);
+    } else if (ConfigIsArray((const ConfigObject *)old)) {
+	child = HamtShare(ConfigHamt((const ConfigObject *)old));
+    } else {
+	return NULL;
+    }
+    copy = HamtUpdatePath(child, keys + 1, n - 1, value);
+    HamtRelease(child);
+    if (!copy) {
+	return NULL;
+    }
+    root = HamtUpdate(node, (size_t)keys[0], (size_t)copy);
+    HamtRelease(copy);
+
+    return root;
+}
+
+/**
+**	Get persistent snapshot of configuration.
+**
+**	A config loaded by the parser or mapped from a binary snapshot is
+**	converted once into persistent arrays, O(n).  The snapshot of a
+**	persistent config shares its root, O(1).
+**
+**	@param config	config dictionary
+**
+**	@returns persistent config, which must be released with
+**	ConfigFreeMem(), NULL if failures.
+*/
+Config *ConfigSnapshot(const Config * config)
+{
+    Config *snapshot;
+    Array *memo;
+
+    if (!config || !ConfigIsArray(ConfigDict(config))) {
+	fprintf(stderr, "no config array\n");
+	return NULL;
+    }
+    memo = NULL;
+    pthread_mutex_lock(&ConfigStringsLock);
+    snapshot = HamtConfig((HamtNode *) HamtImport((size_t)ConfigDict(config),
+	    &memo));
+    pthread_mutex_unlock(&ConfigStringsLock);
+    ArrayFree(memo);
+
+    return snapshot;
+}
+
+/**
+**	Get new version of configuration with one path changed.
+**
+**	The path has the syntax of ConfigPathCompile(), missing arrays on
+**	the path are created.  Only the arrays on the path are copied, the
+**	new version shares all other arrays with @a config, which is
+**	unchanged and still valid.
+**
+**	@param config	config dictionary, other configs are converted first
+**	@param path	config path to change
+**	@param value	new value, NULL removes the key
+**
+**	@returns new persistent config, which must be released with
+**	ConfigFreeMem(), NULL if failures.
+*/
+Config *ConfigUpdate(const Config * config, const char *path,
+    const ConfigObject * value)
+{
+    const ConfigObject **keys;
+    Config *update;
+    HamtNode *root;
+    HamtNode *node;
+    Array *memo;
+    size_t item;
+    int n;
+
+    if (!config || !ConfigIsArray(ConfigDict(config))) {
+	fprintf(stderr, "no config array\n");
+	return NULL;
+    }
+    // enough for all keys, each key has at least one character
+    keys = malloc((strlen(path) + 1) * sizeof(*keys));
+    memo = NULL;
+    update = NULL;
+
+    pthread_mutex_lock(&ConfigStringsLock);
+    n = ConfigPathParse(path, path, keys, 0, NULL, NULL);
+    if (!n) {
+	fprintf(stderr, "core-rc: empty config path\n");
+    }
+    if (n > 0) {
+	root = (HamtNode *) HamtImport((size_t)ConfigDict(config), &memo);
+	item = HamtImport((size_t)value, &memo);
+	if (value && !item) {
+	    node = NULL;
+	} else if (!(node = HamtUpdatePath(root, keys, n, item))) {
+	    fprintf(stderr, "core-rc: config path '%s' has no array\n",
+		path);
+	}
+	HamtReleaseValue(item);
+	HamtRelease(root);
+	if (node) {
+	    update = HamtConfig(node);
+	}
+    }
+    pthread_mutex_unlock(&ConfigStringsLock);
+    ArrayFree(memo);
+    free(keys);
+
+    return update;
+}
+
+/// @}
+
+#endif
+
+/**
+**	Release all memory used by config module.
+**
+**	The arena of the config is released, the config tree isn't walked.
+**	A persistent config releases its root, the nodes shared with other
+**	versions are kept.  The string pool is released with the last
+**	config.
+**
+**	@param config	config dictionary
+*/
+void ConfigFreeMem(Config * config)
+{
+    if (!config || !ConfigIsArray(ConfigDict(config))) {
+	fprintf(stderr, "no config array\n");
+	return;
+    }
+#ifdef DEBUG_CORE_RC
+    ConfigPrint(ConfigDict(config), 0, stdout);
+#endif
+    if (ConfigArrayKind(ConfigDict(config)) == CONFIG_ARRAY_CORE) {
+	ArrayFree(config->Pointer);
+    }
+#ifdef USE_CORE_RC_PERSISTENT
+    if (ConfigArrayKind(ConfigDict(config)) == CONFIG_ARRAY_HAMT) {
+	HamtRelease(ConfigHamt(ConfigDict(config)));
+    }
+#endif
+    ArenaDel(config->Arena);
+    free(config);
+
+    ConfigStringsUnref();
+
+    pthread_mutex_lock(&ConfigObjectLock);
+    ObjectPoolRelease(&ConfigObjectPool);
+    pthread_mutex_unlock(&ConfigObjectLock);
+}
+
+#ifdef USE_CORE_RC_HANDLE
+
+// ----------------------------------------------------------------------------
+// Handle
+// ------------------------------------------------------------------------ //
+
+/**
+**	Retired config typedef.
+*/
+typedef struct _config_retired_ ConfigRetired;
+
+/**
+**	Retired config, waiting for the readers to leave.
+*/
+struct _config_retired_
+{
+    ConfigRetired *Next;		///< next retired config
+    Config *Config;			///< replaced config
+    unsigned long Epoch;		///< epoch of replacement
+};
+
+/**
+**	Config reader.
+**
+**	Each reader has its own cache line, enter and leave don't share
+**	written memory with other readers.
+*/
+struct _config_reader_
+{
+    unsigned long Epoch;		///< epoch entered, 0 outside
+    ConfigHandle *Handle;		///< handle of reader
+    ConfigReader *Next;			///< next reader of handle
+    int Used;				///< reader slot used
+} __attribute__ ((aligned(64)));
+
+/**
+**	Config handle.
+**
+**	Readers store the current epoch before loading the config, a
+**	replaced config is freed, when all readers have entered a newer
+**	epoch or left.
+*/
+struct _config_handle_
+{
+    Config *Current;			///< published config
+    unsigned long Epoch;		///< current epoch, starts with 1
+    pthread_mutex_t Lock;		///< lock for writers
+    ConfigReader *Readers;		///< readers of handle
+    ConfigRetired *Retired;		///< replaced configs not yet freed
+};
+
+/**
+**	Create a new config handle.
+**
+**	@param config	initial config (owned by handle), can be NULL
+**
+**	@returns new config handle.
+*/
+ConfigHandle *ConfigHandleNew(Config * config)
+{
+    ConfigHandle *handle;
+
+    handle = calloc(1, sizeof(*handle));
+    handle->Current = config;
+    handle->Epoch = 1;
+    pthread_mutex_init(&handle->Lock, NULL);
+
+    return handle;
+}
+
+/**
+**	Delete a config handle.
+**
+**	The published and all retired configs are freed.  No reader may be
+**	inside the handle.
+**
+**	@param handle	config handle
+*/
+void ConfigHandleDel(ConfigHandle * handle)
+{
+    ConfigReader *reader;
+    ConfigRetired *retired;
+
+    while ((retired = handle->Retired)) {
+	handle->Retired = retired->Next;
+	ConfigFreeMem(retired->Config);
+	free(retired);
+    }
+    while ((reader = handle->Readers)) {
+	handle->Readers = reader->Next;
+	free(reader);
+    }
+    if (handle->Current) {
+	ConfigFreeMem(handle->Current);
+    }
+    pthread_mutex_destroy(&handle->Lock);
+    free(handle);
+}
+
+/**
+**	Register a reader of config handle.
+**
+**	Each reader thread needs its own reader.
+**
+**	@param handle	config handle
+**
+**	@returns reader for ConfigHandleEnter() and ConfigHandleLeave().
+*/
+ConfigReader *ConfigHandleReaderNew(ConfigHandle * handle)
+{
+    ConfigReader *reader;
+
+    pthread_mutex_lock(&handle->Lock);
+    for (reader = handle->Readers; reader; reader = reader->Next) {
+	if (!reader->Used) {
+	    break;
+	}
+    }
+    if (!reader) {
+	if (posix_memalign((void **)&reader, sizeof(*reader),
+		sizeof(*reader))) {
+	    pthread_mutex_unlock(&handle->Lock);
+	    fprintf(stderr, "core-rc: out of memory\n");
+	    return NULL;
+	}
+	memset(reader, 0, sizeof(*reader));
+	reader->Handle = handle;
+	reader->Next = handle->Readers;
+	handle->Readers = reader;
+    }
+    reader->Used = 1;
+    pthread_mutex_unlock(&handle->Lock);
+
+    return reader;
+}
+
+/**
+**	Unregister a reader of config handle.
+**
+**	@param reader	reader not inside the handle
+*/
+void ConfigHandleReaderDel(ConfigReader * reader)
+{
+    ConfigHandle *handle;
+
+    handle = reader->Handle;
+    pthread_mutex_lock(&handle->Lock);
+    __atomic_store_n(&reader->Epoch, 0, __ATOMIC_RELEASE);
+    reader->Used = 0;
+    pthread_mutex_unlock(&handle->Lock);
+}
+
+/**
+**	Enter config handle and get the published config.
+**
+**	The config stays valid until ConfigHandleLeave().  Enter doesn't nest.
+**
+**	@param reader	reader of config handle
+**
+**	@returns published config.
+*/
+const Config *ConfigHandleEnter(ConfigReader * reader)
+{
+    ConfigHandle *handle;
+
+    handle = reader->Handle;
+    __atomic_store_n(&reader->Epoch, __atomic_load_n(&handle->Epoch,
+	    __ATOMIC_SEQ_CST), __ATOMIC_SEQ_CST);
+    return __atomic_load_n(&handle->Current, __ATOMIC_SEQ_CST);
+}
+
+/**
+**	Leave config handle.
+**
+**	@param reader	reader of config handle
+*/
+void ConfigHandleLeave(ConfigReader * reader)
+{
+    __atomic_store_n(&reader->Epoch, 0, __ATOMIC_RELEASE);
+}
+
+/**
+**	Free retired configs, which no reader can see.
+**
+**	@param handle	config handle, lock must be hold
+**
+**	@returns number of retired configs still used by readers.
+*/
+static int ConfigHandleReclaim0(ConfigHandle * handle)
+{
+    const ConfigReader *reader;
+    ConfigRetired **prev;
+    ConfigRetired *retired;
+    unsigned long oldest;
+    int n;
+
+    // oldest epoch a reader is inside
+    oldest = -1UL;
+    for (reader = handle->Readers; reader; reader = reader->Next) {
+	unsigned long epoch;
+
+	epoch = __atomic_load_n(&reader->Epoch, __ATOMIC_SEQ_CST);
+	if (epoch && epoch < oldest) {
+	    oldest = epoch;
+	}
+    }
+
+    n = 0;
+    prev = &handle->Retired;
+    while ((retired = *prev)) {
+	if (retired->Epoch <= oldest) {
+	    *prev = retired->Next;
+	    ConfigFreeMem(retired->Config);
+	    free(retired);
+	    continue;
+	}
+	prev = &retired->Next;
+	++n;
+    }
+
+    return n;
+}
+
+/**
+**	Free retired configs, which no reader can see.
+**
+**	Called by ConfigHandlePublish(), call it to free the configs earlier.
+**
+**	@param handle	config handle
+**
+**	@returns number of retired configs still used by readers.
+*/
+int ConfigHandleReclaim(ConfigHandle * handle)
+{
+    int n;
+
+    pthread_mutex_lock(&handle->Lock);
+    n = ConfigHandleReclaim0(handle);
+    pthread_mutex_unlock(&handle->Lock);
+
+    return n;
+}
+
+/**
+**	Publish a new config.
+**
+**	The config is replaced with one atomic store, readers never block.
+**	The old config is freed, after all readers have left it.
+**
+**	@param handle	config handle
+**	@param config	new config (owned by handle)
+**
+**	@returns number of retired configs still used by readers.
+**
+**	@code
+**	    config = ConfigReadFile2(NULL, filename);
+**	    if (config) {
+**		ConfigHandlePublish(handle, config);
+**	    }
+**	@endcode
+*/
+int ConfigHandlePublish(ConfigHandle * handle, Config * config)
+{
+    Config *old;
+    int n;
+
+    old = __atomic_exchange_n(&handle->Current, config, __ATOMIC_SEQ_CST);
+
+    pthread_mutex_lock(&handle->Lock);
+    if (old) {
+	ConfigRetired *retired;
+
+	retired = malloc(sizeof(*retired));
+	retired->Config = old;
+	// readers entered with this epoch see the new config
+	retired->Epoch = __atomic_add_fetch(&handle->Epoch, 1, __ATOMIC_SEQ_CST);
+	retired->Next = handle->Retired;
+	handle->Retired = retired;
+    }
+    n = ConfigHandleReclaim0(handle);
+    pthread_mutex_unlock(&handle->Lock);
+
+    return n;
+}
+
+#endif
+
+#ifdef USE_CORE_RC_WATCH
+
+// ----------------------------------------------------------------------------
+// Watch
+// ------------------------------------------------------------------------ //
 
 /**
-**	Parse include statement.
+**	Watched file.
 **
-**	@param file	include file name
+**	Editors often replace files by rename, the directories are watched
+**	and the events filtered by file name.
 */
-static void ParseInclude(const ConfigObject * file)
+typedef struct _config_watch_file_
 {
-#ifdef DEBUG_CORE_RC
-    printf("Must include '%s'\n", ConfigString(file));
-#endif
-    ParseRecursive(ConfigString(file));
+    int Wd;				///< inotify watch of directory
+    char *Name;				///< file name in directory
+} ConfigWatchFile;
+
+/**
+**	Config file watch.
+*/
+struct _config_watch_
+{
+    int Fd;				///< epoll fd returned to user
+    int Inotify;			///< inotify fd
+    int Timer;				///< debounce timer fd
+    int Delay;				///< debounce delay in ms
+    ConfigWatchFile *Files;		///< watched files
+    int FileN;				///< number of watched files
+};
+
+/**
+**	Add watches for the files of a config.
+**
+**	@param watch	config watch
+**	@param config	config dictionary
+*/
+static void ConfigWatchAdd(ConfigWatch * watch, const Config * config)
+{
+    const char *const *files;
+    int n;
+    int i;
+
+    files = ConfigFiles(config, &n);
+    watch->Files = realloc(watch->Files, n * sizeof(*watch->Files));
+    for (i = 0; i < n; ++i) {
+	const char *name;
+	char *dir;
+	int wd;
+
+	if ((name = strrchr(files[i], '/'))) {
+	    dir = strndup(files[i], name - files[i] + 1);
+	    ++name;
+	} else {
+	    dir = strdup(".");
+	    name = files[i];
+	}
+	wd = inotify_add_watch(watch->Inotify, dir,
+	    IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE);
+	if (wd < 0) {
+	    fprintf(stderr, "core-rc: can't watch '%s': %s\n", dir,
+		strerror(errno));
+	}
+	free(dir);
+
+	watch->Files[watch->FileN].Wd = wd;
+	watch->Files[watch->FileN].Name = strdup(name);
+	++watch->FileN;
+    }
 }
 
 /**
-**	Generate store into array.
+**	Remove all watches.
 **
-**	@param index	index key into array
-**	@param value	value stored into array
+**	@param watch	config watch
 */
-static void ParseArrayAddItem(const ConfigObject * index,
-    const ConfigObject * value)
+static void ConfigWatchRemove(ConfigWatch * watch)
 {
-#ifdef never_DEBUG_CORE_RC
-    printf("add %p:", index);
-    ParseDebug(index);
-    printf("=%p:", value);
-    ParseDebug(value);
-    printf("\n");
-#endif
-    if (ConfigIsFixed(index)) {
-	ParseCurrentIndex = ConfigInteger(index) + 1;
+    int i;
 
+    for (i = 0; i < watch->FileN; ++i) {
+	if (watch->Files[i].Wd >= 0) {
+	    // same directory gives same wd, errors are expected
+	    inotify_rm_watch(watch->Inotify, watch->Files[i].Wd);
+	}
+	free(watch->Files[i].Name);
     }
-#ifdef DEBUG_CORE_RC
-    if (*ArrayIns(&ParseCurrentArray, (size_t)index, (size_t)value)
-	!= (size_t)value) {
-	fprintf(stderr, "assign error\n");
+    watch->FileN = 0;
+}
+
+/**
+**	Create a watch of all files of a config.
+**
+**	@param config	config dictionary
+**	@param delay	debounce delay in ms, events within the delay are
+**			combined into one reload
+**
+**	@returns new config watch, NULL if failure.
+*/
+ConfigWatch *ConfigWatchNew(const Config * config, int delay)
+{
+    ConfigWatch *watch;
+    struct epoll_event event;
+
+    watch = calloc(1, sizeof(*watch));
+    watch->Delay = delay;
+    watch->Fd = epoll_create1(EPOLL_CLOEXEC);
+    watch->Inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    watch->Timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (watch->Fd < 0 || watch->Inotify < 0 || watch->Timer < 0) {
+	fprintf(stderr, "core-rc: can't create watch: %s\n",
+	    strerror(errno));
+	ConfigWatchDel(watch);
+	return NULL;
     }
-#else
-    ArrayIns(&ParseCurrentArray, (size_t)index, (size_t)value);
-#endif
+
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = watch->Inotify;
+    epoll_ctl(watch->Fd, EPOLL_CTL_ADD, watch->Inotify, &event);
+    event.data.fd = watch->Timer;
+    epoll_ctl(watch->Fd, EPOLL_CTL_ADD, watch->Timer, &event);
+
+    ConfigWatchAdd(watch, config);
+
+    return watch;
 }
 
 /**
-**	Generate store into next index of array.
+**	Delete a config watch.
 **
-**	@param value	value stored into array
+**	@param watch	config watch
+*/
+void ConfigWatchDel(ConfigWatch * watch)
+{
+    ConfigWatchRemove(watch);
+    free(watch->Files);
+    if (watch->Timer >= 0) {
+	close(watch->Timer);
+    }
+    if (watch->Inotify >= 0) {
+	close(watch->Inotify);
+    }
+    if (watch->Fd >= 0) {
+	close(watch->Fd);
+    }
+    free(watch);
+}
+
+/**
+**	Update the watched files after a reload.
 **
-**	@note ParseCurrentIndex is incremented in ParseArrayAddItem.
+**	A reloaded config can include other files.
+**
+**	@param watch	config watch
+**	@param config	reloaded config dictionary
 */
-static void ParseArrayNextItem(const ConfigObject * value)
+void ConfigWatchUpdate(ConfigWatch * watch, const Config * config)
 {
-    ParseArrayAddItem(ConfigNewInteger(ParseCurrentIndex), value);
+    ConfigWatchRemove(watch);
+    ConfigWatchAdd(watch, config);
 }
 
 /**
-**	Prepare new array.
+**	Get pollable file descriptor of config watch.
+**
+**	The descriptor becomes readable, if ConfigWatchCheck() must be
+**	called.
+**
+**	@param watch	config watch
+**
+**	@returns file descriptor for poll, select or epoll.
+*/
+int ConfigWatchFd(const ConfigWatch * watch)
+{
+    return watch->Fd;
+}
+
+/**
+**	Handle the inotify events.
+**
+**	@param watch	config watch
+**
+**	@returns true if a watched file has changed.
 */
-void ParseArrayStart(void)
+static int ConfigWatchEvents(ConfigWatch * watch)
 {
-    ParsePushA(ParseCurrentArray);
-    ParsePushI(ParseCurrentIndex);
+    char buf[4096] __attribute__ ((aligned(__alignof__(struct
+		    inotify_event))));
+    ssize_t len;
+    int changed;
+
+    changed = 0;
+    while ((len = read(watch->Inotify, buf, sizeof(buf))) > 0) {
+	const char *p;
+
+	for (p = buf; p < buf + len;) {
+	    const struct inotify_event *event;
+	    int i;
+
+	    event = (const struct inotify_event *)p;
+	    for (i = 0; i < watch->FileN; ++i) {
+		if (watch->Files[i].Wd == event->wd && event->len
+		    && !strcmp(watch->Files[i].Name, event->name)) {
+		    changed = 1;
+		    break;
+		}
+	    }
+	    p += sizeof(struct inotify_event) + event->len;
+	}
+    }
 
-    ParseCurrentArray = ArrayNew();
-    ParseCurrentIndex = 0;
+    return changed;
 }
 
 /**
-**	Finish array.
+**	Check config watch, after its file descriptor became readable.
+**
+**	Changes of the watched files restart the debounce timer, the config
+**	must be reloaded after the timer expired.
+**
+**	@param watch	config watch
+**
+**	@returns true if the config must be reloaded.
+**
+**	@code
+**	    if (ConfigWatchCheck(watch)) {
+**		config = ConfigReadFile2(NULL, filename);
+**		ConfigWatchUpdate(watch, config);
+**		ConfigHandlePublish(handle, config);
+**	    }
+**	@endcode
 */
-void ParseArrayFinal(void)
+int ConfigWatchCheck(ConfigWatch * watch)
 {
-    ConfigObject *object;
-    Array *array;
+    uint64_t expired;
 
-    object = ParsePop();
-    if (!object || !ConfigIsFixed(object)) {
-	fprintf(stderr, "internal error\n");
-	exit(-1);
+    if (ConfigWatchEvents(watch)) {
+	struct itimerspec its;
+
+	memset(&its, 0, sizeof(its));
+	its.it_value.tv_sec = watch->Delay / 1000;
+	its.it_value.tv_nsec = (watch->Delay % 1000) * 1000000 + 1;
+	timerfd_settime(watch->Timer, 0, &its, NULL);
+    }
+    if (read(watch->Timer, &expired, sizeof(expired)) == sizeof(expired)) {
+	return 1;
     }
-    ParseCurrentIndex = ConfigInteger(object);
 
-    object = ParsePop();
-    if (!object || !ConfigIsArray(object)) {
-	fprintf(stderr, "internal error\n");
-	exit(-1);
+    return 0;
+}
+
+#endif
+
+#ifdef USE_CORE_RC_STATISTICS
+
+/**
+**	Print memory usage counters of config module.
+**
+**	@param out	output stream
+*/
+void ConfigPrintStatistics(FILE * out)
+{
+    const struct _object_pool_stat_ *stat;
+
+    stat = &ObjectPoolStat;
+    fprintf(out, "objects: %zu allocated, %zu reused, %zu freed\n",
+	stat->Allocs, stat->Reuses, stat->Frees);
+    fprintf(out, "objects: %zu chunks with %zu bytes, %zu malloc calls saved\n",
+	stat->ChunkAllocs, stat->ChunkBytes,
+	stat->Allocs - stat->Reuses - stat->ChunkAllocs);
+    fprintf(out, "arenas: %zu released, %zu chunks and %zu arrays freed\n",
+	stat->Arenas, stat->ChunkFrees, stat->Arrays);
+    pthread_mutex_lock(&ConfigStringsLock);
+    if (ConfigStrings) {
+	StringPoolPrintStatistics(ConfigStrings, out);
     }
-    array = ConfigArray(object);
-    ConfigObjectDel(object);
+    pthread_mutex_unlock(&ConfigStringsLock);
+#ifdef USE_CORE_RC_RELOAD
+    fprintf(out, "reload: %zu incremental, %zu full, %zu fragments reparsed\n",
+	stat->Reloads, stat->FullReloads, stat->Fragments);
+#endif
+#ifdef USE_CORE_RC_PERSISTENT
+    fprintf(out, "persistent: %zu nodes allocated, %zu freed\n",
+	stat->Nodes, stat->NodeFrees);
+#endif
+}
+
+#endif
+
+#ifdef CORE_RC_TEST			// {
+
+#include <getopt.h>
+#include <time.h>
+#include <poll.h>
+
+static int Debug;			/// show additional debug informations
 
-    ParsePushA(ParseCurrentArray);
+/**
+**	Get monotonic time in micro seconds.
+*/
+static uint64_t GetUsTicks(void)
+{
+    struct timespec ts;
 
-    ParseCurrentArray = array;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
 }
 
 /**
-**	Generate start of lvalue.
+**	Write a large synthetic config.
+**
+**	@param out	output stream
+**	@param n	number of entries to generate
 */
-static void ParseLvalue(void)
+static void BenchWriteSynthetic(FILE * out, int n)
 {
-    ParseCurrentLvalue = &ParseCurrentArray;
+    int i;
+
+    fprintf(out, "; synthetic config with %d entries\n", n);
+    for (i = 0; i < n; ++i) {
+	fprintf(out, "service.s%d = [ name = \"service-%d\" port = %d\n"
+	    "\tweight = %d.5 enabled = true\n"
+	    "\tlist = [ %d %d %d ] ]\n", i, i, 1024 + i % 60000, i % 100,
+	    i, i + 1, i + 2);
+    }
 }
 
+#ifdef USE_CORE_RC_PATH
+
+#ifdef USE_CORE_RC_CACHE
+
+    /// read port of service with call site cache
+#define BENCH_CACHED(i) \
+    if (ConfigCheckInteger(ConfigCached(config, "service.s" #i ".port"), \
+	    &value)) { \
+	sum += value; \
+    }
+
 /**
-**	Generate assign operator
+**	Read 40 settings with call site caches.
 **
-**	@param index	lvalue
-**	@param value	value associated with index
+**	@param config	synthetic config
+**
+**	@returns sum of the read ports.
 */
-static void ParseAssign(const ConfigObject * index, const ConfigObject * value)
+static ssize_t BenchCached(const Config * config)
 {
-    const ConfigObject **vp;
+    ssize_t value;
+    ssize_t sum;
+
+    sum = 0;
+    BENCH_CACHED(0) BENCH_CACHED(1) BENCH_CACHED(2) BENCH_CACHED(3)
+    BENCH_CACHED(4) BENCH_CACHED(5) BENCH_CACHED(6) BENCH_CACHED(7)
+    BENCH_CACHED(8) BENCH_CACHED(9) BENCH_CACHED(10) BENCH_CACHED(11)
+    BENCH_CACHED(12) BENCH_CACHED(13) BENCH_CACHED(14) BENCH_CACHED(15)
+    BENCH_CACHED(16) BENCH_CACHED(17) BENCH_CACHED(18) BENCH_CACHED(19)
+    BENCH_CACHED(20) BENCH_CACHED(21) BENCH_CACHED(22) BENCH_CACHED(23)
+    BENCH_CACHED(24) BENCH_CACHED(25) BENCH_CACHED(26) BENCH_CACHED(27)
+    BENCH_CACHED(28) BENCH_CACHED(29) BENCH_CACHED(30) BENCH_CACHED(31)
+    BENCH_CACHED(32) BENCH_CACHED(33) BENCH_CACHED(34) BENCH_CACHED(35)
+    BENCH_CACHED(36) BENCH_CACHED(37) BENCH_CACHED(38) BENCH_CACHED(39)
+    return sum;
+}
 
-#ifdef never_DEBUG_CORE_RC
-    printf("assign %p:", index);
-    ParseDebug(index);
-    printf("=%p:", value);
-    ParseDebug(value);
-    printf("\n");
 #endif
-    if (*ParseCurrentLvalue == ParseGlobalArray) {
-	vp = (const ConfigObject **)ArrayIns(ParseCurrentLvalue, (size_t)index,
-	    (size_t)value);
-	ParseGlobalArray = *ParseCurrentLvalue;
-    } else {
-	vp = (const ConfigObject **)ArrayIns(ParseCurrentLvalue, (size_t)index,
-	    (size_t)value);
+
+/**
+**	Benchmark 40 reads with string paths, compiled paths and call site
+**	caches.  Alternating two configs, each cached read must resolve its
+**	path again.
+**
+**	@param config	synthetic config
+**	@param other	same synthetic config loaded again
+**	@param n	number of entries in config
+*/
+static void BenchPath(const Config * config, const Config * other, int n)
+{
+    ConfigPath *paths[40];
+    char names[40][32];
+    uint64_t tick[5];
+    ssize_t sum[4];
+    ssize_t value;
+    int rounds;
+    int i;
+    int j;
+
+    for (i = 0; i < 40; ++i) {
+	char buf[64];
+	int k;
+
+	k = i % n;
+	snprintf(names[i], sizeof(names[i]), "s%d", k);
+	snprintf(buf, sizeof(buf), "service.s%d.port", k);
+	paths[i] = ConfigPathCompile(buf);
     }
-    if (*vp != value) {
-	// FIXME: value already set, loose memory! cycles!
-	printf("need to overwrite old value\n");
-	*vp = value;
+    rounds = 20000;
+    sum[0] = sum[1] = sum[2] = sum[3] = 0;
+
+    tick[0] = GetUsTicks();
+    for (j = 0; j < rounds; ++j) {
+	for (i = 0; i < 40; ++i) {
+	    if (ConfigStringsGetInteger(ConfigDict(config), &value, "service",
+		    names[i], "port", NULL)) {
+		sum[0] += value;
+	    }
+	}
+    }
+    tick[1] = GetUsTicks();
+    for (j = 0; j < rounds; ++j) {
+	for (i = 0; i < 40; ++i) {
+	    if (ConfigPathGetInteger(ConfigDict(config), &value, paths[i])) {
+		sum[1] += value;
+	    }
+	}
+    }
+    tick[2] = GetUsTicks();
+#ifdef USE_CORE_RC_CACHE
+    for (j = 0; j < rounds; ++j) {
+	sum[2] += BenchCached(config);
+    }
+    tick[3] = GetUsTicks();
+    for (j = 0; j < rounds; ++j) {
+	sum[3] += BenchCached(j & 1 ? other : config);
+    }
+#else
+    (void)other;
+    sum[3] = sum[2] = sum[1];
+    tick[3] = GetUsTicks();
+#endif
+    tick[4] = GetUsTicks();
+    printf("bench: 40 reads with strings %.0f ns, with paths %.0f ns, "
+	"cached %.0f ns, alternating %.0f ns%s\n",
+	(tick[1] - tick[0]) * 1000.0 / rounds,
+	(tick[2] - tick[1]) * 1000.0 / rounds,
+	(tick[3] - tick[2]) * 1000.0 / rounds,
+	(tick[4] - tick[3]) * 1000.0 / rounds, sum[0] == sum[1]
+	&& sum[1] == sum[2] && sum[2] == sum[3] ? "" : " DIFFERENT");
+
+    for (i = 0; i < 40; ++i) {
+	ConfigPathDel(paths[i]);
     }
 }
 
+#ifdef USE_CORE_RC_BIND
+
 /**
-**	Generate dot operator
+**	Settings of a synthetic service.
+*/
+typedef struct _bench_service_
+{
+    const char *Name;			///< name of service
+    ssize_t Port;			///< port of service
+    double Weight;			///< weight of service
+    int Enabled;			///< flag service enabled
+    const ConfigObject *List;		///< list of service
+} BenchService;
+
+/**
+**	Benchmark reading 200 settings of 40 services with get functions
+**	and with one ConfigBind().
 **
-**	@param global	lvalue
-**	@param index	select index of global lvalue
+**	@param config	synthetic config
+**	@param n	number of entries in config
 */
-static void ParseDot(const ConfigObject * global, const ConfigObject * index)
+static void BenchBind(const Config * config, int n)
 {
-    ConfigObject *value;
+    static const char *const fields[5] = {
+	"name", "port", "weight", "enabled", "list"
+    };
+    static const ConfigBindType types[5] = {
+	ConfigBindString, ConfigBindInteger, ConfigBindDouble,
+	ConfigBindBoolean, ConfigBindArray
+    };
+    static const size_t offsets[5] = {
+	offsetof(BenchService, Name), offsetof(BenchService, Port),
+	offsetof(BenchService, Weight), offsetof(BenchService, Enabled),
+	offsetof(BenchService, List)
+    };
+    BenchService get[40];
+    BenchService bind[40];
+    ConfigBinding table[40 * 5 + 1];
+    char paths[40 * 5][48];
+    char names[40][32];
+    uint64_t tick[3];
+    int errors;
+    int rounds;
+    int i;
+    int j;
+
+    for (i = 0; i < 40; ++i) {
+	snprintf(names[i], sizeof(names[i]), "s%d", i % n);
+	for (j = 0; j < 5; ++j) {
+	    snprintf(paths[i * 5 + j], sizeof(paths[0]), "service.s%d.%s",
+		i % n, fields[j]);
+	    table[i * 5 + j].Path = paths[i * 5 + j];
+	    table[i * 5 + j].Type = types[j];
+	    table[i * 5 + j].Offset = i * sizeof(BenchService) + offsets[j];
+	}
+    }
+    table[40 * 5].Path = NULL;
+    memset(get, 0, sizeof(get));
+    memset(bind, 0, sizeof(bind));
+    rounds = 2000;
+    errors = 0;
+
+    tick[0] = GetUsTicks();
+    for (j = 0; j < rounds; ++j) {
+	for (i = 0; i < 40; ++i) {
+	    errors += !ConfigStringsGetString(ConfigDict(config),
+		&get[i].Name, "service", names[i], "name", NULL);
+	    errors += !ConfigStringsGetInteger(ConfigDict(config),
+		&get[i].Port, "service", names[i], "port", NULL);
+	    errors += !ConfigStringsGetDouble(ConfigDict(config),
+		&get[i].Weight, "service", names[i], "weight", NULL);
+	    get[i].Enabled = ConfigStringsGetBoolean(ConfigDict(config),
+		"service", names[i], "enabled", NULL) > 0;
+	    errors += !ConfigStringsGetArray(ConfigDict(config),
+		&get[i].List, "service", names[i], "list", NULL);
+	}
+    }
+    tick[1] = GetUsTicks();
+    for (j = 0; j < rounds; ++j) {
+	errors += ConfigBind(ConfigDict(config), table, bind);
+    }
+    tick[2] = GetUsTicks();
+    printf("bench: 200 reads with strings %.0f ns, bind %.0f ns%s\n",
+	(tick[1] - tick[0]) * 1000.0 / rounds,
+	(tick[2] - tick[1]) * 1000.0 / rounds, !errors
+	&& !memcmp(get, bind, sizeof(get)) ? "" : " DIFFERENT");
+}
 
-#ifdef never_DEBUG_CORE_RC
-    printf("dot %p:", global);
-    ParseDebug(global);
+#endif
 
-    printf(",%p:", index);
-    ParseDebug(index);
-    printf("\n");
 #endif
 
-    value = (ConfigObject *) ArrayGet(*ParseCurrentLvalue, (size_t)global);
+#ifdef USE_CORE_RC_INDEX
 
-    if (!value) {
-	value = ConfigNewArray(ArrayNew());
-	if (*ParseCurrentLvalue == ParseGlobalArray) {
-	    ArrayIns(ParseCurrentLvalue, (size_t)global, (size_t)value);
+/**
+**	Benchmark 40 reads of 8 level deep paths with and without index.
+**
+**	@param n	number of entries in config
+**
+**	@returns true if all reads give the same values.
+*/
+static int BenchIndex(int n)
+{
+    Config *config;
+    ConfigPath *compiled[40];
+    char paths[40][96];
+    char *buf;
+    size_t len;
+    size_t size;
+    uint64_t tick[4];
+    ssize_t sum[3];
+    ssize_t value;
+    int rounds;
+    int i;
+    int j;
+
+    // region.dc.cluster.svc.pool.host.port.limit
+    size = (size_t)n * 96 + 1;
+    buf = malloc(size);
+    len = 0;
+    for (i = 0; i < n; ++i) {
+	len += snprintf(buf + len, size - len,
+	    "r%d.dc%d.c%d.svc%d.pool.host%d.port.limit = %d\n", i % 4,
+	    i / 4 % 4, i / 16 % 8, i / 128, i % 16, i);
+    }
+    config = ConfigReadMemory(NULL, buf, len, "index");
+    free(buf);
+    if (!config) {
+	return 0;
+    }
+    tick[0] = GetUsTicks();
+    ConfigBuildPathIndex(config);
+    printf("index: %d entries indexed in %llu us\n", n,
+	(unsigned long long)(GetUsTicks() - tick[0]));
+
+    for (i = 0; i < 40; ++i) {
+	j = i * 7919L % n;
+	snprintf(paths[i], sizeof(paths[i]),
+	    "r%d.dc%d.c%d.svc%d.pool.host%d.port.limit", j % 4, j / 4 % 4,
+	    j / 16 % 8, j / 128, j % 16);
+	compiled[i] = ConfigPathCompile(paths[i]);
+    }
+    rounds = 20000;
+    sum[0] = sum[1] = sum[2] = 0;
+
+    tick[0] = GetUsTicks();
+    for (j = 0; j < rounds; ++j) {
+	for (i = 0; i < 40; ++i) {
+	    if (ConfigPathGetInteger(ConfigDict(config), &value, compiled[i])) {
+		sum[0] += value;
+	    }
+	}
+    }
+    tick[1] = GetUsTicks();
+    for (j = 0; j < rounds; ++j) {
+	for (i = 0; i < 40; ++i) {
+	    if (ConfigCheckInteger(ConfigGetByPath(config, paths[i]), &value)) {
+		sum[1] += value;
+	    }
+	}
+    }
+    tick[2] = GetUsTicks();
+    printf("index: 40 reads with paths %.0f ns, with index %.0f ns%s\n",
+	(tick[1] - tick[0]) * 1000.0 / rounds,
+	(tick[2] - tick[1]) * 1000.0 / rounds,
+	sum[0] == sum[1] ? "" : " DIFFERENT");
+
+    for (i = 0; i < 40; ++i) {
+	ConfigPathDel(compiled[i]);
+    }
+    ConfigFreeMem(config);
+    return sum[0] == sum[1];
+}
+
+#endif
+
+/**
+**	Double value of the values benchmark.
+**
+**	@param i	number of value
+*/
+static double BenchDouble(int i)
+{
+    return i / 7.0 + 0.1;
+}
+
+/**
+**	Integer value of the values benchmark, most need more than 32 bit.
+**
+**	@param i	number of value
+*/
+static ssize_t BenchInteger(int i)
+{
+    ssize_t v;
+
+    v = (ssize_t) ((size_t)i * 2654435761UL % (1UL << 47));
+    return i & 1 ? -v : v;
+}
+
+/**
+**	Benchmark reading numbers and count the values changed by the value
+**	encoding.  Compare rc_test and rc_test_nan_box.
+**
+**	@param n	number of doubles and integers
+**
+**	@returns true if all numbers could be read.
+*/
+static int BenchValues(int n)
+{
+    const char *encoding;
+    Config *config;
+    const ConfigObject *doubles;
+    const ConfigObject *integers;
+    char *buf;
+    size_t len;
+    size_t size;
+    uint64_t tick[4];
+    double d;
+    double dsum;
+    ssize_t v;
+    ssize_t isum;
+    int inexact;
+    int truncated;
+    int rounds;
+    int i;
+    int j;
+
+#ifdef USE_CORE_RC_NAN_BOX
+    encoding = "nan-box";
+#else
+    encoding = "tagged";
+#endif
+    size = (size_t)n * 48 + 64;
+    buf = malloc(size);
+    len = snprintf(buf, size, "doubles = [");
+    for (i = 0; i < n; ++i) {
+	len += snprintf(buf + len, size - len, " %#.17g", BenchDouble(i));
+    }
+    len += snprintf(buf + len, size - len, " ]\nintegers = [");
+    for (i = 0; i < n; ++i) {
+	len += snprintf(buf + len, size - len, " %zd", BenchInteger(i));
+    }
+    len += snprintf(buf + len, size - len, " ]\n");
+    tick[0] = GetUsTicks();
+    config = ConfigReadMemory(NULL, buf, len, "values");
+    tick[1] = GetUsTicks();
+    free(buf);
+    if (!config
+	|| !ConfigStringsGetArray(ConfigDict(config), &doubles, "doubles",
+	    NULL)
+	|| !ConfigStringsGetArray(ConfigDict(config), &integers,
+	    "integers", NULL)) {
+	return 0;
+    }
 
-	    ParseGlobalArray = *ParseCurrentLvalue;
-	} else {
-	    ArrayIns(ParseCurrentLvalue, (size_t)global, (size_t)value);
+    inexact = 0;
+    truncated = 0;
+    for (i = 0; i < n; ++i) {
+	if (!ConfigCheckDouble(ConfigArrayAt(doubles, i), &d)
+	    || d != BenchDouble(i)) {
+	    ++inexact;
+	}
+	if (!ConfigCheckInteger(ConfigArrayAt(integers, i), &v)
+	    || v != BenchInteger(i)) {
+	    ++truncated;
 	}
-
-    } else if (!ConfigIsArray(value)) {
-	fprintf(stderr, "lvalue required\n");
-	ParsePush(index);
-	return;
     }
-    ParseCurrentLvalue = (Array **) & value->Pointer;
 
-    ParsePush(index);
+    rounds = 100;
+    dsum = 0.0;
+    isum = 0;
+    tick[1] -= tick[0];
+    tick[0] = GetUsTicks();
+    for (j = 0; j < rounds; ++j) {
+	for (i = 0; i < n; ++i) {
+	    if (ConfigCheckDouble(ConfigArrayAt(doubles, i), &d)) {
+		dsum += d;
+	    }
+	}
+    }
+    tick[2] = GetUsTicks();
+    for (j = 0; j < rounds; ++j) {
+	for (i = 0; i < n; ++i) {
+	    if (ConfigCheckInteger(ConfigArrayAt(integers, i), &v)) {
+		isum += v;
+	    }
+	}
+    }
+    tick[3] = GetUsTicks();
+    printf("values: %s, %d doubles and integers parsed in %llu us\n",
+	encoding, n, (unsigned long long)tick[1]);
+    printf("values: %s, read double %.2f ns, integer %.2f ns\n", encoding,
+	(tick[2] - tick[0]) * 1000.0 / rounds / n,
+	(tick[3] - tick[2]) * 1000.0 / rounds / n);
+    printf("values: %s, %d inexact doubles, %d truncated integers "
+	"(%g %zd)\n", encoding, inexact, truncated, dsum, isum);
+
+    ConfigFreeMem(config);
+    return 1;
 }
 
 /**
-**	Generate string .
+**	Benchmark iterating a list stored as vector and as core array, and
+**	the integer keys of a parts array.
 **
-**	Concat the strings.
+**	@param n	number of list items
 **
-**	@param o1	string object
-**	@param o2	strong object
+**	@returns true if all loops give the same sum.
 */
-static void ParseStringCat(const ConfigObject * o1, const ConfigObject * o2)
+static int BenchList(int n)
 {
-    const char *s1;
-    const char *s2;
+    static const char *const names[2] = { "vector", "core" };
+    Config *config;
+    const ConfigObject *list;
+    const ConfigObject *index;
+    const ConfigObject *value;
     char *buf;
+    size_t len;
+    size_t size;
+    uint64_t tick[3];
+    ssize_t sum[2];
+    ssize_t v;
+    int rounds;
+    int i;
+    int j;
+    int k;
+
+    // same items, lvalues keep core a core array
+    size = (size_t)n * 64 + 256;
+    buf = malloc(size);
+    len = snprintf(buf, size, "vector = [");
+    for (i = 0; i < n; ++i) {
+	len += snprintf(buf + len, size - len, " %d", i);
+    }
+    len += snprintf(buf + len, size - len, " ]\n");
+    for (i = 0; i < n; ++i) {
+	len += snprintf(buf + len, size - len, "core[%d] = %d\n", i, i);
+    }
+    // 16 integer keys among n string keys
+    len += snprintf(buf + len, size - len, "mixed = [");
+    for (i = 0; i < 16; ++i) {
+	len += snprintf(buf + len, size - len, " %d", i);
+    }
+    for (i = 0; i < n; ++i) {
+	len += snprintf(buf + len, size - len, " k%d = %d", i, i);
+    }
+    len += snprintf(buf + len, size - len, " ]\n");
+    config = ConfigReadMemory(NULL, buf, len, "list");
+    free(buf);
+    if (!config) {
+	return 0;
+    }
 
-    if (!ConfigIsWord(o1) || !ConfigIsWord(o2)) {
-	fprintf(stderr, "wrong types for string-cat operator\n");
-	ParsePushS("error");
-	return;
+    rounds = 100;
+    for (k = 0; k < 2; ++k) {
+	ConfigStringsGetArray(ConfigDict(config), &list, names[k], NULL);
+	sum[0] = sum[1] = 0;
+	tick[0] = GetUsTicks();
+	for (j = 0; j < rounds; ++j) {
+	    index = NULL;
+	    value = ConfigArrayFirst(list, &index);
+	    while (value) {
+		if (ConfigCheckInteger(value, &v)) {
+		    sum[0] += v;
+		}
+		value = ConfigArrayNext(list, &index);
+	    }
+	}
+	tick[1] = GetUsTicks();
+	for (j = 0; j < rounds; ++j) {
+	    for (i = 0; i < n; ++i) {
+		if (ConfigCheckInteger(ConfigArrayAt(list, i), &v)) {
+		    sum[1] += v;
+		}
+	    }
+	}
+	tick[2] = GetUsTicks();
+	printf("list: %zu items of %s, next %.2f ns, at %.2f ns%s\n",
+	    ConfigArrayLength(list), names[k],
+	    (tick[1] - tick[0]) * 1000.0 / rounds / n,
+	    (tick[2] - tick[1]) * 1000.0 / rounds / n,
+	    sum[0] == sum[1] ? "" : " DIFFERENT");
+	if (sum[0] != sum[1]) {
+	    ConfigFreeMem(config);
+	    return 0;
+	}
     }
-    s1 = ConfigString(o1);
-    s2 = ConfigString(o2);
 
-    buf = alloca(strlen(s1) + strlen(s2) + 1);
-    strcpy(stpcpy(buf, s1), s2);
-    ParsePushS(buf);
+    ConfigStringsGetArray(ConfigDict(config), &list, "mixed", NULL);
+    sum[0] = sum[1] = 0;
+    tick[0] = GetUsTicks();
+    for (j = 0; j < rounds; ++j) {
+	index = NULL;
+	value = ConfigArrayFirst(list, &index);
+	while (value) {
+	    if (ConfigIsFixed(index) && ConfigCheckInteger(value, &v)) {
+		sum[0] += v;
+	    }
+	    value = ConfigArrayNext(list, &index);
+	}
+    }
+    tick[1] = GetUsTicks();
+    for (j = 0; j < rounds; ++j) {
+	index = NULL;
+	value = ConfigArrayFirstFixedKey(list, &index);
+	while (value) {
+	    if (ConfigCheckInteger(value, &v)) {
+		sum[1] += v;
+	    }
+	    value = ConfigArrayNextFixedKey(list, &index);
+	}
+    }
+    tick[2] = GetUsTicks();
+    printf("list: 16 integer keys of %zu items, filtered %.2f us, "
+	"fixed key %.2f us%s\n", ConfigArrayLength(list),
+	(double)(tick[1] - tick[0]) / rounds,
+	(double)(tick[2] - tick[1]) / rounds,
+	sum[0] == sum[1] ? "" : " DIFFERENT");
+
+    ConfigFreeMem(config);
+    return sum[0] == sum[1];
 }
 
 /**
-**	Generate variable.
+**	Load a large synthetic config and print counters.
 **
-**	@param v	variable name
+**	@param n	number of entries to generate
 */
-static void ParseVariable(const ConfigObject * v)
+static void BenchSynthetic(int n)
 {
-    const ConfigObject *value;
+    FILE *file;
+    Config *config;
+    Config *other;
+    uint64_t tick;
+    char *buf;
+    size_t len;
 
-    value = (const ConfigObject *)ArrayGet(ParseGlobalArray, (size_t)v);
-    if (!value) {
-	fprintf(stderr, "core-rc: undefined `%s` used\n",
-	    ConfigIsWord(v) ? ConfigString(v) : "<expr>");
+    if (!(file = tmpfile())) {
+	perror("tmpfile");
+	return;
     }
-    ParsePush(value);
-}
-
-// ----------------------------------------------------------------------------
+    BenchWriteSynthetic(file, n);
+    len = ftell(file);
+    rewind(file);
+
+    tick = GetUsTicks();
+    other = ConfigRead2(NULL, file);
+    printf("bench: %d entries loaded in %llu us\n", n,
+	(unsigned long long)(GetUsTicks() - tick));
+
+    buf = malloc(len);
+    rewind(file);
+    if (fread(buf, 1, len, file) != len) {
+	perror("fread");
+    }
+    tick = GetUsTicks();
+    config = ConfigReadMemory(NULL, buf, len, "bench");
+    printf("bench: %d entries loaded from memory in %llu us\n", n,
+	(unsigned long long)(GetUsTicks() - tick));
+    free(buf);
+#ifdef USE_CORE_RC_PATH
+    BenchPath(config, other, n);
+#ifdef USE_CORE_RC_BIND
+    BenchBind(config, n);
+#endif
+#endif
 
-    /// peg parser generator class of external entry points
-#define YY_PARSE(T)	static T
+    tick = GetUsTicks();
+    ConfigFreeMem(config);
+    printf("bench: freed in %llu us\n",
+	(unsigned long long)(GetUsTicks() - tick));
+    ConfigFreeMem(other);
+    ConfigPrintStatistics(stdout);
 
-//#define YY_DEBUG
+    fclose(file);
+}
 
 /**
-**	Macro of parser generator, to read next bytes
+**	Write include file of the reload benchmark.
 **
-**	@param buf		buffer read position
-**	@param[out] result	number of bytes read
-**	@param max_size		how many free bytes are in buffer
-*/
-#define YY_INPUT(buf, result, max_size) \
-    do { \
-	result = fread(buf, 1, max_size, ParseFile); \
-    } while (0)
-
-/*
-**	Parser generator generated:
+**	@param dir	directory of config files
+**	@param i	number of include file
+**	@param version	version written into file
 */
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wunused-function"
-#pragma GCC diagnostic ignored "-Wunused-parameter"
-#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
-
-#include "core-rc_parser.c"
+static void BenchWriteFragment(const char *dir, int i, int version)
+{
+    char name[256];
+    FILE *out;
+    int j;
 
-#pragma GCC diagnostic pop
+    snprintf(name, sizeof(name), "%s/f%d.rc", dir, i);
+    if (!(out = fopen(name, "w"))) {
+	perror(name);
+	return;
+    }
+    fprintf(out, "fragment%d = [ version = %d\n", i, version);
+    for (j = 0; j < 20; ++j) {
+	fprintf(out, "\tkey%d = \"value-%d-%d\"\n", j, i, j);
+    }
+    fprintf(out, "]\n");
+    fclose(out);
+}
 
 /**
-**	Handle parser generator error message.
+**	Get written config as string.
 **
-**	@param message	error message
+**	The object addresses written as comments with debug are removed.
+**
+**	@param config	config dictionary
+**
+**	@returns malloced text of config.
 */
-static void yyerror(const char *message)
+static char *BenchConfigText(const Config * config)
 {
-    fprintf(stderr, "%s:%d: %s", ParseName, ParseLineNr, message);
-    if (yyctx->__text[0]) {
-	fprintf(stderr, " near token '%s'", yyctx->__text);
-    }
-    if (yyctx->__pos < yyctx->__limit || !feof(ParseFile)) {
-	yyctx->__buf[yyctx->__limit] = '\0';
-	fprintf(stderr, " before text \"");
-	while (yyctx->__pos < yyctx->__limit) {
-	    if ('\n' == yyctx->__buf[yyctx->__pos]
-		|| '\r' == yyctx->__buf[yyctx->__pos]) {
-		break;
-	    }
-	    fputc(yyctx->__buf[yyctx->__pos++], stderr);
-	}
-	if (yyctx->__pos == yyctx->__limit) {
-	    int c;
-
-	    while (EOF != (c = fgetc(ParseFile)) && '\n' != c && '\r' != c) {
-		fputc(c, stderr);
+    char *text;
+    char *s;
+    char *d;
+    size_t size;
+    FILE *out;
+
+    out = open_memstream(&text, &size);
+    ConfigWrite(config, out);
+    fclose(out);
+
+    for (s = d = text; *s; ++s) {
+	if (s[0] == ';' && s[1] == '0' && s[2] == 'x') {
+	    while (s[1] && s[1] != '\n') {
+		++s;
 	    }
+	    continue;
 	}
-	fputc('\"', stderr);
+	*d++ = *s;
     }
-    fprintf(stderr, "\n");
-    // exit(1);
-}
-
-// ----------------------------------------------------------------------------
-
-///
-///	saved peg parser state
-///
-struct _saved_state_
-{
-    /// parser generator variables
-    yycontext yyctx;
+    *d = '\0';
 
-    const char *Name;			///< previous file name
-    FILE *File;				///< previous file stream
-    int LineNr;				///< previous line number
-};
+    return text;
+}
 
 /**
-**	Push parser state for includes.
+**	Reload a config with many include files after one has changed.
 **
-**	@param filename	config include file name
+**	@param n	number of include files
 */
-static void ParseRecursive(const char *filename)
+static void BenchReload(int n)
 {
-    struct _saved_state_ s;
-    FILE *file;
-    char *buf;
-
-    //
-    // Save current state.
-    //
-    s.yyctx = *yyctx;
-    s.Name = ParseName;
-    s.File = ParseFile;
-    s.LineNr = ParseLineNr;
+    char dir[] = "/tmp/rc_testXXXXXX";
+    char name[256];
+    FILE *out;
+    Config *config;
+    Config *reloaded;
+    Config *full;
+    char *text1;
+    char *text2;
+    uint64_t tick;
+    uint64_t full_us;
+    uint64_t reload_us;
+    int i;
 
-    //
-    //	initialize
-    //
-    memset(yyctx, 0, sizeof(yycontext));
+    if (!mkdtemp(dir)) {
+	perror("mkdtemp");
+	return;
+    }
+    snprintf(name, sizeof(name), "%s/main.rc", dir);
+    if (!(out = fopen(name, "w"))) {
+	perror(name);
+	return;
+    }
+    fprintf(out, "main = 1\n");
+    for (i = 0; i < n; ++i) {
+	fprintf(out, "include \"f%d.rc\"\n", i);
+	BenchWriteFragment(dir, i, 1);
+    }
+    fclose(out);
 
-    file = fopen(filename, "rb");
-    if (!file) {
-	// absolute path
-	if (filename[0] != '/' && (filename[0] != '.' || filename[1] != '/')
-	    && (filename[0] != '.' || filename[1] != '.'
-		|| filename[2] != '/')) {
-	    char *s;
+    config = ConfigReadFile2(NULL, name);
 
-	    buf = alloca(strlen(ParseName) + strlen(filename) + 2);
-	    if ((s = strrchr(ParseName, '/'))) {
-		s = stpncpy(buf, ParseName, s - ParseName + 1);
-		strcpy(s, filename);
-	    } else {
-		strcpy(buf, filename);
-	    }
-	    filename = buf;
-	    file = fopen(filename, "rb");
-	}
-	if (!file) {
-	    fprintf(stderr, "can't open include file '%s'\n", filename);
-	}
-    }
-    if (file) {
-	ParseName = filename;
-	ParseFile = file;
-	ParseLineNr = 1;
+    // change one include file
+    BenchWriteFragment(dir, n / 2, 1000);
 
-	if (yyparse()) {
-#ifdef DEBUG_CORE_RC
-	    printf("success\n");
-#endif
-	} else {
-	    yyerror("syntax error");
-	}
-	fclose(file);
-    }
-    //
-    //	cleanup
-    //
-    yyrelease(yyctx);
+    tick = GetUsTicks();
+    reloaded = ConfigReload(config);
+    reload_us = GetUsTicks() - tick;
 
-    //
-    // Restore current state
-    //
-    *yyctx = s.yyctx;
-    ParseName = s.Name;
-    ParseFile = s.File;
-    ParseLineNr = s.LineNr;
-}
+    tick = GetUsTicks();
+    full = ConfigReadFile2(NULL, name);
+    full_us = GetUsTicks() - tick;
 
-// ----------------------------------------------------------------------------
+    text1 = BenchConfigText(reloaded);
+    text2 = BenchConfigText(full);
+    printf("reload: %d files, full parse %llu us, reload %llu us, %s\n", n,
+	(unsigned long long)full_us, (unsigned long long)reload_us,
+	strcmp(text1, text2) ? "DIFFERENT" : "equal");
+    free(text1);
+    free(text2);
 
-/// @}
+    ConfigFreeMem(config);
+    ConfigFreeMem(reloaded);
+    ConfigFreeMem(full);
+    ConfigPrintStatistics(stdout);
 
-// ----------------------------------------------------------------------------
+    for (i = 0; i < n; ++i) {
+	snprintf(name, sizeof(name), "%s/f%d.rc", dir, i);
+	unlink(name);
+    }
+    snprintf(name, sizeof(name), "%s/main.rc", dir);
+    unlink(name);
+    rmdir(dir);
+}
 
 /**
-**	Define a configuration variable.
+**	Reload stress reader thread.
 **
-**	@param config	config dictionary.
-**	@param index	key
-**	@param value	data
+**	@param arg	reader of config handle
 */
-extern void ConfigDefine(Config * config, const ConfigObject * index,
-    const ConfigObject * value)
+static void *ReloadReader(void *arg)
 {
-    ConfigObject *dict;
-    Array *array;
-    size_t *vp;
+    ConfigReader *reader;
+    unsigned long reads;
 
-    // FIXME: ConfigDictNoConst(config)
-    dict = (ConfigObject *) (config);
-    if (!ConfigIsArray(dict)) {
-	fprintf(stderr, "core-rc: config is no array\n");
-	return;
-    }
-    array = ConfigArray(dict);
-    vp = ArrayIns(&array, (size_t)index, (size_t)value);
-    if (*vp != (size_t)value) {
-	fprintf(stderr, "redefined old value\n");
-	*vp = (size_t)value;
+    reader = arg;
+    reads = 0;
+    for (;;) {
+	const Config *config;
+	const ConfigObject *value;
+	const ConfigObject *index;
+
+	config = ConfigHandleEnter(reader);
+	if (!config) {			// NULL published: stop
+	    ConfigHandleLeave(reader);
+	    break;
+	}
+	index = NULL;
+	value = ConfigArrayFirst(ConfigDict(config), &index);
+	while (value) {
+	    value = ConfigArrayNext(ConfigDict(config), &index);
+	}
+	ConfigHandleLeave(reader);
+	++reads;
     }
-    dict->Pointer = array;
+    return (void *)reads;
 }
 
 /**
-**	Read configuration from file stream.
-**
-**	@param import	import another config (freed)
-**	@param file	configuration file stream
-**
-**	@returns configuration as dictionary.
+**	Reload a config file, while reader threads use it.
 **
-**	@code
-**	    //
-**	    //	export constants
-**	    //
-**	    config = ConfigNewConfig(NULL);
-**	    for (i = 0; i < n; ++i) {
-**		ConfigDefine(config, ConfigNewString(import[i].Index),
-**		    ConfigNewString(import[i].Value));
-**	    }
-**	@endcode
+**	@param filename	config file name
+**	@param n	number of reloads
 */
-Config *ConfigRead2(Config * import, FILE * file)
+static void ReloadStress(const char *filename, int n)
 {
-    if (!ConfigStrings) {
-	ConfigStrings = StringPoolNew();
-#ifdef DEBUG_CORE_RC
-	fprintf(stderr, "new string pool\n");
-#endif
-    }
+    ConfigHandle *handle;
+    pthread_t threads[4];
+    unsigned long reads;
+    uint64_t tick;
+    int pending;
+    int i;
 
-    ParseFile = file;
-    ParseLineNr = 1;
+    if (!(handle = ConfigHandleNew(ConfigReadFile2(NULL, filename)))) {
+	return;
+    }
+    for (i = 0; i < 4; ++i) {
+	pthread_create(&threads[i], NULL, ReloadReader,
+	    ConfigHandleReaderNew(handle));
+    }
+    tick = GetUsTicks();
+    pending = 0;
+    for (i = 0; i < n; ++i) {
+	Config *config;
 
-    ParseStackSize = 16;
-    ParseStack = malloc(ParseStackSize * sizeof(ConfigObject *));
-    ParseSP = 0;
+	if ((config = ConfigReadFile2(NULL, filename))) {
+	    int retired;
 
-    if (!ConfigIsArray(ConfigDict(import))) {
-	if (import) {
-	    fprintf(stderr, "core-rc: import is no array\n");
+	    retired = ConfigHandlePublish(handle, config);
+	    if (retired > pending) {
+		pending = retired;
+	    }
 	}
-	ParseCurrentArray = ArrayNew();
-    } else {
-	ParseCurrentArray = ConfigArray(ConfigDict(import));
-	free(import);
     }
+    ConfigHandlePublish(handle, NULL);
+    reads = 0;
+    for (i = 0; i < 4; ++i) {
+	void *result;
 
-    ParseGlobalArray = ParseCurrentArray;
-    ParseCurrentIndex = 0;
-
-    if (yyparse()) {
-#ifdef DEBUG_CORE_RC
-	printf("success\n");
-#endif
-    } else {
-	yyerror("syntax error");
+	pthread_join(threads[i], &result);
+	reads += (unsigned long)result;
     }
+    printf("reload: %d reloads in %llu us, %lu reads, max %d pending\n", n,
+	(unsigned long long)(GetUsTicks() - tick), reads, pending);
+    ConfigHandleDel(handle);
+}
 
-#ifdef never_DEBUG_CORE_RC
-    if (0) {
-	printf("Strings:\n");
-	StringPoolDump(ConfigStrings, 0);
+/**
+**	Watch config file and reload it after changes.
+**
+**	@param filename	config file name
+*/
+static void WatchReload(const char *filename)
+{
+    Config *config;
+    ConfigWatch *watch;
+    struct pollfd pfd;
+
+    if (!(config = ConfigReadFile2(NULL, filename))) {
+	return;
     }
-    if (0) {
-	printf("Final %d ConfigArray:\n", ParseCurrentIndex);
-	ParseDump(ParseCurrentArray, 0);
+    if (!(watch = ConfigWatchNew(config, 100))) {
+	ConfigFreeMem(config);
+	return;
     }
-#endif
-
-    yyrelease(yyctx);
-
-    free(ParseStack);
+    pfd.fd = ConfigWatchFd(watch);
+    pfd.events = POLLIN;
+    for (;;) {
+	if (poll(&pfd, 1, -1) < 0) {
+	    perror("poll");
+	    break;
+	}
+	if (ConfigWatchCheck(watch)) {
+	    Config *new;
+	    const char *const *files;
+	    int n;
 
-    return ConfigNewConfig(ParseCurrentArray);
+	    if (!(new = ConfigReadFile2(NULL, filename))) {
+		continue;
+	    }
+	    ConfigFreeMem(config);
+	    config = new;
+	    ConfigWatchUpdate(watch, config);
+	    files = ConfigFiles(config, &n);
+	    printf("watch: reloaded '%s', %d files watched\n", files[0], n);
+	    fflush(stdout);
+	}
+    }
+    ConfigWatchDel(watch);
+    ConfigFreeMem(config);
 }
 
+#ifdef USE_CORE_RC_DESCENT
+
 /**
-**	Read configuration from file.
+**	Parse config file with the peg and the descent parser and compare
+**	the trees.
 **
-**	@param import	import another config (freed)
-**	@param filename	configuration file name, use "-" for stdin.
+**	@param name	config file name
+**
+**	@returns true if the trees are equal.
 */
-Config *ConfigReadFile2(Config * import, const char *filename)
+static int BenchParser(const char *name)
 {
-    FILE *file;
-    Config *config;
+    Config *config[2];
+    char *text[2];
+    uint64_t tick;
+    int equal;
+    int i;
 
-    // open configuration file
-    if (filename && strcmp(filename, "-")) {
-	file = fopen(filename, "rb");
-    } else {
-	file = stdin;
+    for (i = 0; i < 2; ++i) {
+	ConfigParser *parser;
+
+	parser = ConfigParserNew();
+	parser->PrivateStrings = 0;
+	parser->Descent = i;
+	tick = GetUsTicks();
+	config[i] = ConfigParserReadFile(parser, NULL, name);
+	printf("parser: %s parsed in %llu us\n", i ? "descent" : "peg",
+	    (unsigned long long)(GetUsTicks() - tick));
+	ConfigParserDel(parser);
+	if (!config[i]) {
+	    return 0;
+	}
     }
-    if (!file) {
-	fprintf(stderr, "can't open configuration file '%s'\n", filename);
-	return NULL;
+    // both configs share the global string pool, keys print alike
+    text[0] = BenchConfigText(config[0]);
+    text[1] = BenchConfigText(config[1]);
+    equal = !strcmp(text[0], text[1]);
+    printf("parser: trees %s\n", equal ? "equal" : "DIFFERENT");
+    if (!equal && Debug) {
+	printf("%s\n%s\n", text[0], text[1]);
     }
-    // read configuration file
-    ParseName = filename;
-    config = ConfigRead2(import, file);
-
-    // close config file
-    if (file != stdin) {
-	fclose(file);
+    for (i = 0; i < 2; ++i) {
+	free(text[i]);
+	ConfigFreeMem(config[i]);
     }
-    return config;
+    return equal;
 }
 
-#ifndef USE_CORE_RC_READ2
+/**
+**	Get throughput in MiB/s.
+**
+**	@param bytes	number of bytes processed
+**	@param us	time used in micro seconds
+*/
+static double BenchMiBs(size_t bytes, uint64_t us)
+{
+    return bytes / ((us + 1) * 1.048576);
+}
+
+#ifdef USE_CORE_RC_PARALLEL
 
 /**
-**	Read configuration from file stream.
+**	Parse config file in order and with threads and compare the trees.
 **
-**	@param ni	number of import contants
-**	@param import	import constants
-**	@param file	configuration file stream
+**	@param name	config file name
+**	@param threads	number of threads parsing include files
 **
-**	@todo constants and predefined values must be imported
+**	@returns true if the trees are equal.
 */
-Config *ConfigRead(int ni, const ConfigImport * import, FILE * file)
+static int BenchThreads(const char *name, int threads)
 {
+    Config *config[2];
+    char *text[2];
+    uint64_t tick;
+    int equal;
     int i;
-    Array *array;
 
-#if defined(DEBUG_CORE_RC) || defined(DEBUG)
-    if (ConfigStrings) {
-	fprintf(stderr, "new core-rc reuses string pool\n");
+    for (i = 0; i < 2; ++i) {
+	ConfigParser *parser;
+
+	parser = ConfigParserNew();
+	ConfigParserSetThreads(parser, i ? threads : 0);
+	tick = GetUsTicks();
+	config[i] = ConfigParserReadFile(parser, NULL, name);
+	printf("threads: %d threads parsed in %llu us\n", i ? threads : 0,
+	    (unsigned long long)(GetUsTicks() - tick));
+	ConfigParserDel(parser);
+	if (!config[i]) {
+	    return 0;
+	}
     }
-#endif
-    if (!ConfigStrings) {
-	ConfigStrings = StringPoolNew();
-#ifdef DEBUG_CORE_RC
-	fprintf(stderr, "new string pool\n");
-#endif
+    text[0] = BenchConfigText(config[0]);
+    text[1] = BenchConfigText(config[1]);
+    equal = !strcmp(text[0], text[1]);
+    printf("threads: trees %s\n", equal ? "equal" : "DIFFERENT");
+    if (!equal && Debug) {
+	printf("%s\n%s\n", text[0], text[1]);
+    }
+    for (i = 0; i < 2; ++i) {
+	free(text[i]);
+	ConfigFreeMem(config[i]);
     }
+    return equal;
+}
 
-    //
-    //	export constants
-    //
-    array = ArrayNew();
-    for (i = 0; i < ni; ++i) {
-	size_t *vp;
-	size_t v;
+#endif
 
-	v = (size_t)ConfigNewString(import[i].Value);
-	vp = ArrayIns(&array, (size_t)ConfigNewString(import[i].Index), v);
-	if (*vp != v) {
-	    fprintf(stderr, "overwrite old value\n");
-	    *vp = v;
+/**
+**	Microbenchmark of the scanner kernels.
+**
+**	@param kib	size of input in KiB
+**
+**	@returns true if the kernels of all levels have the same results.
+*/
+static int BenchScan(int kib)
+{
+    static const char *const names[] = { "scalar", "sse2", "avx2" };
+    static const char pattern[] = "\t  \r\n    \n\t\t\v	 \f \r";
+    char *spaces;
+    char *text;
+    size_t size;
+    size_t rounds;
+    size_t expect[3];
+    size_t i;
+    int max;
+    int level;
+    int equal;
+
+    size = (size_t)kib * 1024;
+    spaces = malloc(size + 1);
+    text = malloc(size + 1);
+    for (i = 0; i < size; ++i) {
+	spaces[i] = pattern[i % (sizeof(pattern) - 1)];
+	text[i] = i % 64 == 63 ? ' ' : 'a' + i % 26;
+    }
+    spaces[size] = 'x';
+    text[size] = '"';
+    rounds = (64 << 20) / size + 1;
+
+    ScanInit();
+    max = ScanLevel;
+    equal = 1;
+    for (level = 0; level <= max; ++level) {
+	uint64_t tick[4];
+	size_t sum[3];
+	size_t j;
+
+	ScanLevel = level;
+	memset(sum, 0, sizeof(sum));
+	tick[0] = GetUsTicks();
+	for (j = 0; j < rounds; ++j) {
+	    sum[0] += ScanSpaces(spaces, spaces + size + 1) - spaces;
+	}
+	tick[1] = GetUsTicks();
+	for (j = 0; j < rounds; ++j) {
+	    sum[1] += ScanFind(text, text + size + 1, '"', '\\') - text;
+	}
+	tick[2] = GetUsTicks();
+	for (j = 0; j < rounds; ++j) {
+	    sum[2] += ScanLines(spaces, spaces + size);
 	}
+	tick[3] = GetUsTicks();
+	if (!level) {
+	    memcpy(expect, sum, sizeof(expect));
+	} else if (memcmp(expect, sum, sizeof(expect))) {
+	    equal = 0;
+	}
+	printf("scan: %-6s spaces %6.0f find %6.0f lines %6.0f MiB/s%s\n",
+	    names[level], BenchMiBs(size * rounds, tick[1] - tick[0]),
+	    BenchMiBs(size * rounds, tick[2] - tick[1]),
+	    BenchMiBs(size * rounds, tick[3] - tick[2]),
+	    memcmp(expect, sum, sizeof(expect)) ? " DIFFERENT" : "");
     }
+    ScanLevel = max;
 
-    return ConfigRead2(ConfigNewConfig(array), file);
+    free(spaces);
+    free(text);
+    return equal;
 }
 
+#endif
+
 /**
-**	Read configuration from file.
+**	Benchmark string interning of hash table and old string trie.
 **
-**	@param ni	number of import contants
-**	@param import	import constants
-**	@param filename	configuration file name, use "-" for stdin.
+**	The keys are dotted config paths with long common prefixes, the
+**	last round interns short keys like "port" into the hash table.
+**
+**	@param n	number of keys
+**
+**	@returns true if both give one object for each key.
 */
-Config *ConfigReadFile(int ni, const ConfigImport * import,
-    const char *filename)
+static int BenchIntern(int n)
 {
+    static const char *const sections[] = {
+	"server", "client", "database", "cache", "logging", "network",
+	"storage", "security"
+    };
+    static const char *const names[] = {
+	"address", "port", "timeout", "enabled", "max-connections",
+	"buffer-size", "retry-interval", "path"
+    };
+    char **keys;
+    ConfigObject **objects;
+    StringPool *pool;
+    Array *trie;
+    uint64_t tick[3];
+    int rounds;
+    int equal;
     int i;
-    Array *array;
+    int j;
+    int k;
 
-#if defined(DEBUG_CORE_RC) || defined(DEBUG)
-    if (ConfigStrings) {
-	fprintf(stderr, "new core-rc reuses string pool\n");
-    }
-#endif
-    if (!ConfigStrings) {
-	ConfigStrings = StringPoolNew();
-#ifdef DEBUG_CORE_RC
-	fprintf(stderr, "new string pool\n");
-#endif
+    keys = malloc(n * sizeof(*keys));
+    objects = malloc(n * sizeof(*objects));
+    for (i = 0; i < n; ++i) {
+	char buf[128];
+
+	snprintf(buf, sizeof(buf), "%s.instance-%d.%s%s", sections[i % 8],
+	    i / 64, names[(i / 8) % 8], i % 3 ? "" : ".default");
+	keys[i] = strdup(buf);
     }
+    rounds = 2000000 / n + 1;
+    equal = 1;
 
-    //
-    //	export constants
-    //
-    array = ArrayNew();
-    for (i = 0; i < ni; ++i) {
-	size_t *vp;
-	size_t v;
+    for (k = 0; k < 3; ++k) {
+	pool = StringPoolNew();
+	trie = NULL;
 
-	v = (size_t)ConfigNewString(import[i].Value);
-	vp = ArrayIns(&array, (size_t)ConfigNewString(import[i].Index), v);
-	if (*vp != v) {
-	    fprintf(stderr, "overwrite old value\n");
-	    *vp = v;
+	if (k == 2) {			// reuse keys, all are longer
+	    for (i = 0; i < n; ++i) {
+		snprintf(keys[i], 7, "w%x", i & 0xFFFFF);
+	    }
 	}
+	tick[0] = GetUsTicks();
+	for (i = 0; i < n; ++i) {
+	    objects[i] = k == 1 ? StringTrieIntern(pool, &trie, keys[i])
+		: StringPoolIntern(pool, keys[i]);
+	}
+	tick[1] = GetUsTicks();
+	for (j = 0; j < rounds; ++j) {
+	    for (i = 0; i < n; ++i) {
+		if ((k == 1 ? StringTrieIntern(pool, &trie, keys[i])
+			: StringPoolIntern(pool, keys[i])) != objects[i]) {
+		    equal = 0;
+		}
+	    }
+	}
+	tick[2] = GetUsTicks();
+	for (i = 1; i < n; ++i) {
+	    if (objects[i] == objects[i - 1]) {
+		equal = 0;
+	    }
+	}
+	printf("intern: %-5s insert %6.1f lookup %6.1f ns/key",
+	    k == 1 ? "trie" : k ? "short" : "hash",
+	    (tick[1] - tick[0]) * 1000.0 / n,
+	    (tick[2] - tick[1]) * 1000.0 / ((double)n * rounds));
+	if (k == 2) {
+	    printf(", %zu of %d in pool", pool->Used, n);
+	}
+	printf("\n");
+
+	if (trie) {
+	    StringTrieDel(trie);
+	}
+	StringPoolDel(pool);
     }
 
-    return ConfigReadFile2(ConfigNewConfig(array), filename);
+    for (i = 0; i < n; ++i) {
+	free(keys[i]);
+    }
+    free(keys);
+    free(objects);
+    return equal;
 }
 
-#endif
-
 /**
-**	Free all objects in an array.
+**	Compare config with its mapped binary snapshot or persistent copy.
 **
-**	@param object	config array to free
+**	Arrays used as keys are only counted.
 **
-**	@warning loops aren't detected and not supported!
+**	@param a	object of config
+**	@param b	object of mapped snapshot or persistent copy
 **
-**	@todo FIXME: free multiple
+**	@returns true if equal, false otherwise.
 */
-static void ConfigArrayFree(ConfigObject * object)
+static int BenchBinaryEqual(const ConfigObject * a, const ConfigObject * b)
 {
-    Array *array;
-    size_t *value;
     size_t index;
+    const size_t *value;
+    size_t n;
 
-    array = ConfigArray(object);
+    if (!ConfigIsObject(a) || !ConfigIsObject(b)) {
+	return a == b;
+    }
+    if (ConfigIsWord(a) || ConfigIsWord(b)) {
+	return ConfigIsWord(a) && ConfigIsWord(b)
+	    && ConfigStringLength(a) == ConfigStringLength(b)
+	    && ConfigStringHash(a) == ConfigStringHash(b)
+	    && !ConfigWordCompare(a, b);
+    }
+    n = 0;
     index = 0;
-    value = ArrayFirst(array, &index);
+    value = ObjectArrayFirst(a, &index);
     while (value) {
-	if (ConfigIsArray((const ConfigObject *)*value)) {
-	    //printf("free: %0zx", *value);
-	    //ConfigPrint((const ConfigObject*)*value, 1, stdout);
-	    //printf("\n");
-	    ConfigArrayFree((ConfigObject *) * value);
-	}
-	if (ConfigIsArray((const ConfigObject *)index)) {
-	    //printf("free: %0zx", index);
-	    //ConfigPrint((const ConfigObject*)index, 1, stdout);
-	    //printf("\n");
-	    ConfigArrayFree((ConfigObject *) index);
+	if (!ConfigIsArray((const ConfigObject *)index)) {	// numbers, words
+	    if (!BenchBinaryEqual((const ConfigObject *)*value,
+		    (const ConfigObject *)ObjectArrayGet(b, index))) {
+		return 0;
+	    }
 	}
-	value = ArrayNext(array, &index);
+	++n;
+	value = ObjectArrayNext(a, &index);
     }
-
-    ArrayFree(array);
-    ConfigObjectDel(object);
+    index = 0;
+    value = ObjectArrayFirst(b, &index);
+    while (value) {
+	--n;
+	value = ObjectArrayNext(b, &index);
+    }
+    return !n;
 }
 
-#ifdef USE_CORE_RC_WRITE
-
 /**
-**	Write configuration to file stream.
-**
-**	@param config	config dictionary
-**	@param out	output stream
+**	Write config as binary snapshot, map it and compare.
 **
-**	@returns false if no failures, true otherwise.
-**
-**	@todo not correct, must handle top level special.
+**	@param name	config file name
+**	@param binary	binary snapshot file name
 */
-int ConfigWrite(const Config * config, FILE * stream)
+static void BenchBinary(const char *name, const char *binary)
 {
-    ConfigPrint(ConfigDict(config), 0, stream);
-    fprintf(stream, "\n");
+    Config *config;
+    Config *mapped;
+    uint64_t tick;
 
-    return 0;
+    tick = GetUsTicks();
+    if (!(config = ConfigReadFile2(NULL, name))) {
+	return;
+    }
+    printf("binary: parsed in %llu us\n",
+	(unsigned long long)(GetUsTicks() - tick));
+
+    tick = GetUsTicks();
+    if (ConfigWriteBinary(config, binary)) {
+	ConfigFreeMem(config);
+	return;
+    }
+    printf("binary: written in %llu us\n",
+	(unsigned long long)(GetUsTicks() - tick));
+
+    tick = GetUsTicks();
+    if ((mapped = ConfigMapBinary(binary))) {
+	printf("binary: mapped in %llu us at %p (%s)\n",
+	    (unsigned long long)(GetUsTicks() - tick), mapped->Arena->Map,
+	    (size_t)mapped->Arena->Map ==
+	    CONFIG_BINARY_BASE ? "shared" : "relocated");
+	printf("binary: %s\n", BenchBinaryEqual(ConfigDict(config),
+		ConfigDict(mapped)) ? "equal" : "DIFFERENT");
+	if (Debug) {
+	    ConfigWrite(mapped, stdout);
+	}
+	ConfigFreeMem(mapped);
+    }
+    ConfigFreeMem(config);
 }
 
+#ifdef USE_CORE_RC_PERSISTENT
+
 /**
-**	Write configuration to file name.
+**	Check port of service in version of synthetic config.
 **
-**	@param config	config dictionary
-**	@param filename	output filename
+**	@param config	version of synthetic config
+**	@param i	number of service
+**	@param port	expected port, 0 service is removed
 **
-**	@returns false if no failures, true otherwise.
+**	@returns true if port is as expected, false otherwise.
 */
-int ConfigWriteFile(const Config * config, const char *filename)
+static int BenchPersistentPort(const Config * config, int i, ssize_t port)
 {
-    FILE *file;
-    int err;
-
-    // open configuration file
-    if (filename && strcmp(filename, "-")) {
-	file = fopen(filename, "wb");
-    } else {
-	file = stdout;
-    }
-    if (!file) {
-	fprintf(stderr, "can't open configuration file '%s'\n", filename);
-	return -1;
-    }
-    // write configuration file
-    fprintf(file, "; %s\n", filename);
-    err = ConfigWrite(config, file);
-
-    // close configuration file
-    if (file != stdout) {
-	fclose(file);
-    }
-    return err;
+    char text[64];
+    ConfigPath *path;
+    ssize_t value;
+    int found;
+
+    snprintf(text, sizeof(text), "service.s%d.port", i);
+    path = ConfigPathCompile(text);
+    value = 0;
+    found = ConfigPathGetInteger(ConfigDict(config), &value, path);
+    ConfigPathDel(path);
+
+    return port ? found && value == port : !found;
 }
-#endif
 
 /**
-**	Release all memory used by config module.
+**	Benchmark snapshots and updates of persistent config.
 **
-**	@param config	config dictionary
+**	Each update gets a new version, all old versions must keep their
+**	values.
+**
+**	@param n	number of entries of synthetic config
 **
-**	@todo only one config currently supported.
+**	@returns true if all versions are correct, false otherwise.
 */
-void ConfigFreeMem(Config * config)
+static int BenchPersistent(int n)
 {
-    ConfigObject *dict;
+    FILE *file;
+    Config *config;
+    Config **versions;
+    ConfigPath *services;
+    const ConfigObject *array;
+    uint64_t tick;
+    size_t nodes;
+    char path[64];
+    int ok;
+    int i;
 
-    // FIXME: ConfigDictNoConst(config)
-    dict = (ConfigObject *) (config);
-    if (!dict || !ConfigIsArray(dict)) {
-	fprintf(stderr, "no config array\n");
-	return;
+    if (!(file = tmpfile())) {
+	perror("tmpfile");
+	return 0;
+    }
+    BenchWriteSynthetic(file, n);
+    rewind(file);
+    config = ConfigRead2(NULL, file);
+    fclose(file);
+    if (!config) {
+	return 0;
+    }
+    versions = malloc((n + 2) * sizeof(*versions));
+
+    tick = GetUsTicks();
+    versions[0] = ConfigSnapshot(config);
+    printf("persistent: %d entries converted in %llu us\n", n,
+	(unsigned long long)(GetUsTicks() - tick));
+    ok = BenchBinaryEqual(ConfigDict(config), ConfigDict(versions[0]));
+    printf("persistent: %s\n", ok ? "equal" : "DIFFERENT");
+    ConfigFreeMem(config);
+
+    tick = GetUsTicks();
+    for (i = 1; i <= n; ++i) {
+	versions[i] = ConfigSnapshot(versions[0]);
+    }
+    printf("persistent: %d snapshots in %llu us\n", n,
+	(unsigned long long)(GetUsTicks() - tick));
+    for (i = 1; i <= n; ++i) {
+	ConfigFreeMem(versions[i]);
     }
-#ifdef DEBUG_CORE_RC
-    ConfigPrint(dict, 0, stdout);
-#endif
-    ConfigArrayFree(dict);
-
-    StringPoolDel(ConfigStrings);
-    ConfigStrings = NULL;
-}
 
-#ifdef CORE_RC_TEST			// {
+    nodes = ObjectPoolStat.Nodes;
+    tick = GetUsTicks();
+    for (i = 0; i < n; ++i) {
+	snprintf(path, sizeof(path), "service.s%d.port", i);
+	versions[i + 1] = ConfigUpdate(versions[i], path,
+	    ConfigNewInteger(i + 1));
+    }
+    tick = GetUsTicks() - tick;
+    printf("persistent: %d updates in %llu us, %.1f nodes each\n", n,
+	(unsigned long long)tick, (double)(ObjectPoolStat.Nodes - nodes) / n);
+    versions[n + 1] = ConfigUpdate(versions[n], "service.s0", NULL);
+
+    // version i has the new ports of the services before i
+    for (i = 0; i <= n; ++i) {
+	ok &= !i || BenchPersistentPort(versions[i], i - 1, i);
+	ok &= i == n || BenchPersistentPort(versions[i], i, 1024 + i % 60000);
+    }
+    services = ConfigPathCompile("service");
+    ok &= BenchPersistentPort(versions[n + 1], 0, 0)
+	&& BenchPersistentPort(versions[n], 0, 1)
+	&& ConfigPathGetArray(ConfigDict(versions[n + 1]), &array, services)
+	&& ConfigArrayLength(array) == (size_t)n - 1;
+    ConfigPathDel(services);
+    printf("persistent: old versions %s\n", ok ? "unchanged" : "CHANGED");
+
+    tick = GetUsTicks();
+    for (i = 0; i <= n + 1; ++i) {
+	ConfigFreeMem(versions[i]);
+    }
+    printf("persistent: freed in %llu us\n",
+	(unsigned long long)(GetUsTicks() - tick));
+    free(versions);
+    ConfigPrintStatistics(stdout);
 
-#include <getopt.h>
+    return ok;
+}
 
-static int Debug;			/// show additional debug informations
+#endif
 
 /**
 **	Print version.
@@ -2383,9 +11840,25 @@ static void PrintVersion(void)
 */
 static void PrintUsage(void)
 {
-    printf("Usage: rc_test [-?dhv] [-c file]\n"
+    printf("Usage: rc_test [-?dhpsvw] [-b n] [-c file] [-f n] [-i n] [-j n]\n"
+	"\t[-k n] [-l n] [-m file] [-n n] [-r n] [-u n] [-x n]\n"
 	"\t-d\tenable debug, more -d increase the verbosity\n"
-	"\t-c file\tconfig file\n" "\t-? -h\tdisplay this message\n"
+	"\t-b n\tbenchmark synthetic config with n entries\n"
+	"\t-c file\tconfig file\n"
+	"\t-f n\tbenchmark reload of config with n include files\n"
+	"\t-i n\tbenchmark string interning with n keys\n"
+	"\t-j n\tcompare config parsed in order and with n threads\n"
+	"\t-k n\tbenchmark scanner kernels with n KiB input\n"
+	"\t-l n\tbenchmark iterating a list with n items\n"
+	"\t-m file\twrite config as binary snapshot file and map it\n"
+	"\t-n n\tbenchmark reading n numbers of the value encoding\n"
+	"\t-p\tcompare trees of the peg and the descent parser\n"
+	"\t-s\tprint memory statistics\n"
+	"\t-r n\treload config file n times, while 4 threads read it\n"
+	"\t-u n\tbenchmark n updates of a persistent config\n"
+	"\t-w\twatch config file and reload it after changes\n"
+	"\t-x n\tbenchmark path index of config with n deep entries\n"
+	"\t-? -h\tdisplay this message\n"
 	"\t-v\tdisplay version information\n"
 	"Only idiots print usage on stderr!\n");
 }
@@ -2402,18 +11875,88 @@ int main(int argc, char *const argv[])
 {
     char *file;
     Config *config;
+    int bench;
+    int stats;
+    int reload;
+    int watch;
+    int fragments;
+    const char *binary;
+    int parser;
+    int scan;
+    int threads;
+    int intern;
+    int deep;
+    int list;
+    int values;
+    int updates;
 
     Debug = 0;
     file = NULL;
+    bench = 0;
+    stats = 0;
+    reload = 0;
+    watch = 0;
+    fragments = 0;
+    binary = NULL;
+    parser = 0;
+    scan = 0;
+    threads = 0;
+    intern = 0;
+    deep = 0;
+    list = 0;
+    values = 0;
+    updates = 0;
 
     //
     //	Parse command line arguments
     //
     for (;;) {
-	switch (getopt(argc, argv, "hv?-c:d")) {
+	switch (getopt(argc, argv, "hv?-b:c:df:i:j:k:l:m:n:pr:su:wx:")) {
+	    case 'b':			// benchmark
+		bench = atoi(optarg);
+		continue;
 	    case 'c':			// config file
 		file = optarg;
 		continue;
+	    case 'f':			// reload benchmark
+		fragments = atoi(optarg);
+		continue;
+	    case 'i':			// interning benchmark
+		intern = atoi(optarg);
+		continue;
+	    case 'j':			// parse with threads
+		threads = atoi(optarg);
+		continue;
+	    case 'k':			// scanner benchmark
+		scan = atoi(optarg);
+		continue;
+	    case 'l':			// list benchmark
+		list = atoi(optarg);
+		continue;
+	    case 'm':			// binary snapshot
+		binary = optarg;
+		continue;
+	    case 'n':			// value encoding benchmark
+		values = atoi(optarg);
+		continue;
+	    case 'p':			// compare parsers
+		++parser;
+		continue;
+	    case 'r':			// reload stress
+		reload = atoi(optarg);
+		continue;
+	    case 's':			// statistics
+		++stats;
+		continue;
+	    case 'u':			// persistent config benchmark
+		updates = atoi(optarg);
+		continue;
+	    case 'w':			// watch
+		++watch;
+		continue;
+	    case 'x':			// path index benchmark
+		deep = atoi(optarg);
+		continue;
 	    case 'd':			// enabled debug
 		++Debug;
 		continue;
@@ -2476,12 +12019,62 @@ int main(int argc, char *const argv[])
 	//
 	ConfigWriteFile(config, "-");
 	// StringPoolDump(ConfigStrings, 0);
+	if (stats) {
+	    ConfigPrintStatistics(stdout);
+	}
 
 	//
 	//	free memory used by configuration
 	//
 	ConfigFreeMem(config);
     }
+    if (bench) {
+	BenchSynthetic(bench);
+    }
+    if (fragments) {
+	BenchReload(fragments);
+    }
+    if (binary && file) {
+	BenchBinary(file, binary);
+    }
+    if (intern > 0 && !BenchIntern(intern)) {
+	return -1;
+    }
+    if (list > 0 && !BenchList(list)) {
+	return -1;
+    }
+    if (values > 0 && !BenchValues(values)) {
+	return -1;
+    }
+#ifdef USE_CORE_RC_PERSISTENT
+    if (updates > 0 && !BenchPersistent(updates)) {
+	return -1;
+    }
+#endif
+#ifdef USE_CORE_RC_INDEX
+    if (deep > 0 && !BenchIndex(deep)) {
+	return -1;
+    }
+#endif
+#ifdef USE_CORE_RC_DESCENT
+    if (parser && file && !BenchParser(file)) {
+	return -1;
+    }
+    if (scan > 0 && !BenchScan(scan)) {
+	return -1;
+    }
+#endif
+#ifdef USE_CORE_RC_PARALLEL
+    if (threads > 0 && file && !BenchThreads(file, threads)) {
+	return -1;
+    }
+#endif
+    if (reload && file) {
+	ReloadStress(file, reload);
+    }
+    if (watch && file) {
+	WatchReload(file);
+    }
 
     return 0;
 }
@@ -27,19 +27,58 @@
 //	Declares
 //////////////////////////////////////////////////////////////////////////////
 
+#ifdef USE_CORE_RC_NAN_BOX
+
+    /// NaN-boxed integers are above, 49 bit signed
+#define CONFIG_NAN_BOX_INTEGER	0xFFFE000000000000UL
+    /// NaN-boxed doubles are offset by, pointers are below
+#define CONFIG_NAN_BOX_DOUBLE	0x0002000000000000UL
+
+#endif
+
+    /// size of buffer for ConfigStringBuffer()
+#define CONFIG_STRING_BUFFER	8
+
 /**
 **	Configuration main dictionary typedef.
 */
-typedef union _config_ Config;
+typedef struct _config_ Config;
 
 /**
 **	Configuration main dictionary structure.
 */
-union _config_
+struct _config_
 {
     void *Pointer;			///< pointer to array
+    struct _config_arena_ *Arena;	///< private memory arena of config
+    size_t Generation;			///< unique generation of config
 };
 
+/**
+**	Config parser typedef.
+*/
+typedef struct _config_parser_ ConfigParser;
+
+/**
+**	Config handle typedef.
+*/
+typedef struct _config_handle_ ConfigHandle;
+
+/**
+**	Config handle reader typedef.
+*/
+typedef struct _config_reader_ ConfigReader;
+
+/**
+**	Config watch typedef.
+*/
+typedef struct _config_watch_ ConfigWatch;
+
+/**
+**	Compiled config path typedef.
+*/
+typedef struct _config_path_ ConfigPath;
+
 /**
 **	Config object.
 */
@@ -48,6 +87,40 @@ typedef union _config_object_
     void *Pointer;			///< pointer to data
 } ConfigObject;
 
+/**
+**	Lookup cache of a call site.
+*/
+typedef struct _config_cache_
+{
+    size_t Generation;			///< config generation of value
+    const ConfigObject *Value;		///< value found at path
+} ConfigCache;
+
+/**
+**	Type of a bound field.
+*/
+typedef enum _config_bind_type_
+{
+    ConfigBindInteger,			///< ssize_t field
+    ConfigBindUnsigned,			///< size_t field
+    ConfigBindDouble,			///< double field
+    ConfigBindBoolean,			///< int field
+    ConfigBindString,			///< const char * field
+    ConfigBindArray,			///< const ConfigObject * field
+} ConfigBindType;
+
+/**
+**	Config binding of a struct field.
+**
+**	A table of path/type/offset triples to fill a C struct.
+*/
+typedef struct _config_binding_
+{
+    const char *Path;			///< config path of value
+    ConfigBindType Type;		///< type of field
+    size_t Offset;			///< offsetof field in struct
+} ConfigBinding;
+
 /**
 **	Config constant import.
 **
@@ -88,16 +161,36 @@ static inline const ConfigObject *ConfigDict(const Config * config)
     return (const ConfigObject *)config;
 }
 
+/**
+**	Get generation of configuration.
+**
+**	Each config gets an unique generation, which changes with each
+**	ConfigDefine().
+**
+**	@param config	configuration loaded
+**
+**	@returns generation of config, never 0.
+*/
+static inline size_t ConfigGeneration(const Config * config)
+{
+    return config->Generation;
+}
+
 /**
 **	Create a new fixed integer object.
 **
-**	@param integer	31/63 bit used signed integer
+**	@param integer	31/63 bit used signed integer, 49 bit NaN-boxed
 **
 **	@returns config object containing the integer value.
 */
 static inline ConfigObject *ConfigNewInteger(ssize_t integer)
 {
+#ifdef USE_CORE_RC_NAN_BOX
+    return (ConfigObject *) (((size_t)integer & (CONFIG_NAN_BOX_DOUBLE - 1))
+	| CONFIG_NAN_BOX_INTEGER);
+#else
     return (ConfigObject *) ((integer << 1) + 1);
+#endif
 }
 
 /**
@@ -118,6 +211,9 @@ extern ConfigObject *ConfigNewArray(const Array *);
     /// Create a new string object.
 extern ConfigObject *ConfigNewString(const char *);
 
+    /// Find string objects of a string table.
+extern int ConfigFindStrings(ConfigInternObject *);
+
     /// Create a new config object.
 extern Config *ConfigNewConfig(const Array * array);
 
@@ -136,9 +232,18 @@ extern int ConfigCheckDouble(const ConfigObject *, double *);
     /// Check string value.
 extern int ConfigCheckString(const ConfigObject *, const char **);
 
+    /// Get string value into buffer.
+extern const char *ConfigStringBuffer(const ConfigObject *, char *);
+
     /// Check array value.
 extern int ConfigCheckArray(const ConfigObject *, const ConfigObject **);
 
+    /// Get length of string value.
+extern size_t ConfigStringLength(const ConfigObject *);
+
+    /// Get hash of string value.
+extern size_t ConfigStringHash(const ConfigObject *);
+
 #ifdef USE_CORE_RC_GET_STRINGS
 
     /// Get object value from config.
@@ -166,6 +271,60 @@ extern int ConfigStringsGetArray(const ConfigObject *, const ConfigObject **,
 
 #endif // USE_CORE_RC_GET_STRINGS
 
+#ifdef USE_CORE_RC_PATH
+
+    /// Compile config path.
+extern ConfigPath *ConfigPathCompile(const char *);
+
+    /// Delete compiled config path.
+extern void ConfigPathDel(ConfigPath *);
+
+    /// Get object value from config with compiled path.
+extern int ConfigPathGetObject(const ConfigObject *, const ConfigObject **,
+    const ConfigPath *);
+
+    /// Get integer value from config with compiled path.
+extern int ConfigPathGetInteger(const ConfigObject *, ssize_t *,
+    const ConfigPath *);
+
+    /// Get unsigned value from config with compiled path.
+extern int ConfigPathGetUnsigned(const ConfigObject *, size_t *,
+    const ConfigPath *);
+
+    /// Get boolean value from config with compiled path.
+extern int ConfigPathGetBoolean(const ConfigObject *, const ConfigPath *);
+
+    /// Get double value from config with compiled path.
+extern int ConfigPathGetDouble(const ConfigObject *, double *,
+    const ConfigPath *);
+
+    /// Get string value from config with compiled path.
+extern int ConfigPathGetString(const ConfigObject *, const char **,
+    const ConfigPath *);
+
+    /// Get array value from config with compiled path.
+extern int ConfigPathGetArray(const ConfigObject *, const ConfigObject **,
+    const ConfigPath *);
+
+#ifdef USE_CORE_RC_INDEX
+
+    /// Build index of all full paths of config.
+extern int ConfigBuildPathIndex(Config *);
+
+    /// Get value from config by full path.
+extern const ConfigObject *ConfigGetByPath(const Config *, const char *);
+
+#endif // USE_CORE_RC_INDEX
+
+#ifdef USE_CORE_RC_BIND
+
+    /// Bind config values to the fields of a C struct.
+extern int ConfigBind(const ConfigObject *, const ConfigBinding *, void *);
+
+#endif // USE_CORE_RC_BIND
+
+#endif // USE_CORE_RC_PATH
+
     /// Get object value from config.
 extern int ConfigGetObject(const ConfigObject *, const ConfigObject **, ...);
 
@@ -187,6 +346,16 @@ extern int ConfigGetString(const ConfigObject *, const char **, ...);
     /// Get array value from config.
 extern int ConfigGetArray(const ConfigObject *, const ConfigObject **, ...);
 
+    /// Get value from config array.
+extern const ConfigObject *ConfigArrayGet(const ConfigObject *,
+    const ConfigObject *);
+
+    /// Get value from config array by position.
+extern const ConfigObject *ConfigArrayAt(const ConfigObject *, size_t);
+
+    /// Get number of items of config array.
+extern size_t ConfigArrayLength(const ConfigObject *);
+
     /// Get first value from config array.
 extern const ConfigObject *ConfigArrayFirst(const ConfigObject *,
     const ConfigObject **);
@@ -201,6 +370,13 @@ extern const ConfigObject *ConfigArrayFirstFixedKey(const ConfigObject *,
 extern const ConfigObject *ConfigArrayNextFixedKey(const ConfigObject *,
     const ConfigObject **);
 
+    /// Get first value with string key from config array.
+extern const ConfigObject *ConfigArrayFirstStringKey(const ConfigObject *,
+    const ConfigObject **);
+    /// Get next value with string key from config array.
+extern const ConfigObject *ConfigArrayNextStringKey(const ConfigObject *,
+    const ConfigObject **);
+
     /// Print config object.
 extern void ConfigPrint(const ConfigObject *, int, FILE *);
 
@@ -215,19 +391,171 @@ extern Config *ConfigRead(int, const ConfigImport *, FILE *)
 extern Config *ConfigReadFile(int, const ConfigImport *, const char *)
     __attribute__((deprecated));
 
+    /// Create a new config parser.
+extern ConfigParser *ConfigParserNew(void);
+
+    /// Delete a config parser.
+extern void ConfigParserDel(ConfigParser *);
+
+    /// Read configuration from file stream with parser.
+extern Config *ConfigParserRead(ConfigParser *, Config *, FILE *);
+
+    /// Read configuration from file name with parser.
+extern Config *ConfigParserReadFile(ConfigParser *, Config *, const char *);
+
+    /// Read configuration from memory with parser.
+extern Config *ConfigParserReadMemory(ConfigParser *, Config *, const char *,
+    size_t, const char *);
+
+#ifdef USE_CORE_RC_PARALLEL
+
+    /// Set number of threads parsing include files.
+extern void ConfigParserSetThreads(ConfigParser *, int);
+
+#endif
+
     /// Read configuration from file stream.
 extern Config *ConfigRead2(Config *, FILE *);
 
+    /// Read configuration from memory.
+extern Config *ConfigReadMemory(Config *, const char *, size_t, const char *);
+
     /// Read configuration from file name.
 extern Config *ConfigReadFile2(Config *, const char *);
 
+#ifdef USE_CORE_RC_RELOAD
+
+    /// Reload a config, reparse only the changed include files.
+extern Config *ConfigReload(const Config *);
+
+#endif
+
+    /// Get the files read into config.
+extern const char *const *ConfigFiles(const Config *, int *);
+
     /// Write configuration to file stream.
 extern int ConfigWrite(const Config *, FILE *);
 
     /// Write configuration to file name.
 extern int ConfigWriteFile(const Config *, const char *);
 
+#ifdef USE_CORE_RC_BINARY
+
+    /// Write configuration as binary snapshot.
+extern int ConfigWriteBinary(const Config *, const char *);
+
+    /// Map binary snapshot of configuration.
+extern Config *ConfigMapBinary(const char *);
+
+#endif
+
+#ifdef USE_CORE_RC_PERSISTENT
+
+    /// Get persistent snapshot of configuration.
+extern Config *ConfigSnapshot(const Config *);
+
+    /// Get new version of configuration with one path changed.
+extern Config *ConfigUpdate(const Config *, const char *,
+    const ConfigObject *);
+
+#endif
+
     /// Release memory used by config.
 extern void ConfigFreeMem(Config *);
 
+#ifdef USE_CORE_RC_HANDLE
+
+    /// Create a new config handle.
+extern ConfigHandle *ConfigHandleNew(Config *);
+
+    /// Delete a config handle.
+extern void ConfigHandleDel(ConfigHandle *);
+
+    /// Register a reader of config handle.
+extern ConfigReader *ConfigHandleReaderNew(ConfigHandle *);
+
+    /// Unregister a reader of config handle.
+extern void ConfigHandleReaderDel(ConfigReader *);
+
+    /// Enter config handle and get the published config.
+extern const Config *ConfigHandleEnter(ConfigReader *);
+
+    /// Leave config handle.
+extern void ConfigHandleLeave(ConfigReader *);
+
+    /// Publish a new config.
+extern int ConfigHandlePublish(ConfigHandle *, Config *);
+
+    /// Free retired configs, which no reader can see.
+extern int ConfigHandleReclaim(ConfigHandle *);
+
+#endif // USE_CORE_RC_HANDLE
+
+#ifdef USE_CORE_RC_WATCH
+
+    /// Create a watch of all files of a config.
+extern ConfigWatch *ConfigWatchNew(const Config *, int);
+
+    /// Delete a config watch.
+extern void ConfigWatchDel(ConfigWatch *);
+
+    /// Update the watched files after a reload.
+extern void ConfigWatchUpdate(ConfigWatch *, const Config *);
+
+    /// Get pollable file descriptor of config watch.
+extern int ConfigWatchFd(const ConfigWatch *);
+
+    /// Check config watch, returns true if config must be reloaded.
+extern int ConfigWatchCheck(ConfigWatch *);
+
+#endif // USE_CORE_RC_WATCH
+
+#ifdef USE_CORE_RC_CACHE
+
+    /// Resolve path of lookup cache.
+extern const ConfigObject *ConfigCacheResolve(ConfigCache *, const Config *,
+    const char *);
+
+/**
+**	Lookup config object with cache.
+**
+**	A hit is only one compare of the generations.
+**
+**	@param cache	lookup cache
+**	@param config	configuration loaded
+**	@param path	config path, see ConfigPathCompile()
+**
+**	@returns object stored in dictionary at path, NULL if not found.
+*/
+static inline const ConfigObject *ConfigCacheLookup(ConfigCache * cache,
+    const Config * config, const char *path)
+{
+    if (cache->Generation == config->Generation) {
+	return cache->Value;
+    }
+    return ConfigCacheResolve(cache, config, path);
+}
+
+/**
+**	Lookup config object with a cache of the call site.
+**
+**	Each call site and thread has its own cache, which is resolved
+**	again for another config or after ConfigDefine().
+**
+**	@param config	configuration loaded
+**	@param path	config path, see ConfigPathCompile()
+*/
+#define ConfigCached(config, path) \
+    ({ static __thread ConfigCache _cache_; \
+	ConfigCacheLookup(&_cache_, (config), (path)); })
+
+#endif // USE_CORE_RC_CACHE
+
+#ifdef USE_CORE_RC_STATISTICS
+
+    /// Print memory usage counters.
+extern void ConfigPrintStatistics(FILE *);
+
+#endif // USE_CORE_RC_STATISTICS
+
 /// @}
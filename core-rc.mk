@@ -25,7 +25,8 @@
 OBJS+=	core-rc/core-rc.o
 HDRS+=	core-rc/core-rc.h
 FILES+=	core-rc/core-rc_parser.peg core-rc/core-rc_parser.c.in \
-	core-rc/core-rc.mk
+	core-rc/core-rc.mk core-rc/rc_schema.c
+LIBS+=	-lpthread
 
 core-rc/core-rc.o: core-rc/core-rc.c core-rc/core-rc_parser.c
 
@@ -35,18 +36,30 @@ core-rc/core-rc_parser.c: core-rc/core-rc_parser.peg core-rc/core-rc_parser.c.in
 
 $(OBJS):core-rc/core-rc.mk
 
+#	schema compiler, generates a typed settings loader from a schema:
+#	name.schema.core-rc -> name_schema.h name_schema.c
+
+core-rc/rc_schema: core-rc/rc_schema.o core-rc/core-rc.o \
+		core-array/core-array.o
+	$(CC) $(CFLAGS) $(LDFLAGS) -o $@ $^ -lpthread
+
+core-rc/rc_schema.o: core-rc/rc_schema.c core-rc/core-rc.h core-rc/core-rc.mk
+
+%_schema.c %_schema.h: %.schema.core-rc core-rc/rc_schema
+	core-rc/rc_schema -o $*_schema $<
+
 #----------------------------------------------------------------------------
 #	Developer tools
 
 .PHONY: core-rc-clean core-rc-clobber
 
 core-rc-clean:
-	-rm core-rc/core-rc.o
+	-rm core-rc/core-rc.o core-rc/rc_schema.o
 
 clean:	core-rc-clean
 
 core-rc-clobber:
-	-rm core-rc/core-rc_parser.c
+	-rm core-rc/core-rc_parser.c core-rc/rc_schema
 
 clobber:	core-rc-clobber
 
@@ -0,0 +1,957 @@
+///
+///	@file rc_schema.c	@brief core runtime configuration schema compiler
+///
+///	Copyright (c) 2026 by Lutz Sammer.  All Rights Reserved.
+///
+///	Contributor(s):
+///
+///	License: AGPLv3
+///
+///	This program is free software: you can redistribute it and/or modify
+///	it under the terms of the GNU Affero General Public License as
+///	published by the Free Software Foundation, either version 3 of the
+///	License.
+///
+///	This program is distributed in the hope that it will be useful,
+///	but WITHOUT ANY WARRANTY; without even the implied warranty of
+///	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+///	GNU Affero General Public License for more details.
+///
+///	$Id$
+//////////////////////////////////////////////////////////////////////////////
+
+///
+///	@defgroup RcSchema	The core-rc schema compiler.
+///
+///	rc_schema reads a schema written in core-rc syntax and generates a
+///	C header and source with a typed settings struct, a function
+///	filling the defaults and a loader filling the struct from the
+///	config tree.
+///
+///	Each value of the schema is the default of a field, its type is the
+///	type of the field.  A sub array is a nested struct.  A sub array
+///	with a "type" key is a field with an explicit type and an optional
+///	default, without default the field is required:
+///	@code
+///	server = [
+///		name = "localhost"	; const char *, default "localhost"
+///		port = 8080		; ssize_t, default 8080
+///		timeout = 2.5		; double, default 2.5
+///		hosts = []		; const ConfigObject *, default NULL
+///		verbose = [ type = "boolean" default = false ]
+///		workers = [ type = "unsigned" ] ; size_t, required
+///	]
+///	@endcode
+///	The types are "integer", "unsigned", "double", "boolean", "string"
+///	and "array".  The keys are converted to CamelCase member names,
+///	"max-clients" becomes "MaxClients".
+///
+///	The loader resolves all keys once with ConfigFindStrings() and
+///	searches each array of the config once with ConfigArrayGet(), no
+///	string is interned and no varargs are used.
+///
+/// @{
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <unistd.h>
+
+#include "core-array/core-array.h"
+#include "core-rc.h"
+
+#ifndef VERSION
+#define VERSION "unknown"		///< version, if not set by Makefile
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+
+#define SCHEMA_STRUCT	0		///< field is nested struct
+#define SCHEMA_INTEGER	1		///< field is signed integer
+#define SCHEMA_UNSIGNED	2		///< field is unsigned integer
+#define SCHEMA_DOUBLE	3		///< field is floating point
+#define SCHEMA_BOOLEAN	4		///< field is boolean
+#define SCHEMA_STRING	5		///< field is string
+#define SCHEMA_ARRAY	6		///< field is array
+
+/**
+**	Schema field type.
+*/
+typedef struct _schema_type_
+{
+    const char *Name;			///< name of type in schema
+    const char *CType;			///< C type of field
+    const char *Check;			///< config check function
+    const char *What;			///< type for messages
+} SchemaType;
+
+    /// schema field types, indexed by SCHEMA_*
+static const SchemaType SchemaTypes[] = {
+    {"struct", NULL, NULL, NULL},
+    {"integer", "ssize_t", "ConfigCheckInteger", "a fixed integer"},
+    {"unsigned", "size_t", "ConfigCheckUnsigned", "a fixed integer"},
+    {"double", "double", "ConfigCheckDouble", "a floating point"},
+    {"boolean", "int", "ConfigCheckInteger", "a fixed integer"},
+    {"string", "const char *", "ConfigCheckString", "a string"},
+    {"array", "const ConfigObject *", "ConfigCheckArray", "an array"},
+};
+
+/**
+**	Schema field.
+*/
+typedef struct _schema_field_ SchemaField;
+
+/**
+**	Schema field structure.
+*/
+struct _schema_field_
+{
+    const char *Key;			///< config key of field
+    char *Name;				///< C member name of field
+    char *Path;				///< config path of field
+    int Type;				///< SCHEMA_* type of field
+    int Required;			///< flag field has no default
+    const ConfigObject *Default;	///< default value, NULL none
+    int N;				///< number of fields of struct
+    SchemaField *Fields;		///< fields of struct
+};
+
+static const char *SchemaFile;		///< name of schema file
+static int SchemaErrors;		///< number of schema errors
+
+static const char **SchemaKeys;		///< unique keys of schema
+static int SchemaKeyN;			///< number of unique keys
+
+//////////////////////////////////////////////////////////////////////////////
+//	Schema
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+**	Report error in schema.
+**
+**	@param path	path of the field with the error
+**	@param message	error message
+*/
+static void SchemaError(const char *path, const char *message)
+{
+    fprintf(stderr, "rc_schema: %s: '%s' %s\n", SchemaFile, path, message);
+    ++SchemaErrors;
+}
+
+/**
+**	Convert config key to C member name.
+**
+**	Characters not allowed in C names separate words, each word starts
+**	with an upper case letter: "max-clients" becomes "MaxClients".
+**
+**	@param key	config key
+**
+**	@returns malloced member name.
+*/
+static char *SchemaName(const char *key)
+{
+    char *name;
+    char *s;
+    int upper;
+
+    name = malloc(strlen(key) + 2);
+    s = name;
+    if (isdigit((unsigned char)*key)) {
+	*s++ = '_';
+    }
+    for (upper = 1; *key; ++key) {
+	if (!isalnum((unsigned char)*key) && *key != '_') {
+	    upper = 1;
+	    continue;
+	}
+	*s++ = upper ? toupper((unsigned char)*key) : *key;
+	upper = 0;
+    }
+    *s = '\0';
+    return name;
+}
+
+/**
+**	Add key to the unique keys of the schema.
+**
+**	@param key	config key
+*/
+static void SchemaAddKey(const char *key)
+{
+    int i;
+
+    for (i = 0; i < SchemaKeyN; ++i) {
+	if (!strcmp(SchemaKeys[i], key)) {
+	    return;
+	}
+    }
+    SchemaKeys = realloc(SchemaKeys, (SchemaKeyN + 1) * sizeof(*SchemaKeys));
+    SchemaKeys[SchemaKeyN++] = key;
+}
+
+/**
+**	Get index of key in the unique keys of the schema.
+**
+**	@param key	config key
+*/
+static int SchemaKeyIndex(const char *key)
+{
+    int i;
+
+    for (i = 0; strcmp(SchemaKeys[i], key); ++i) {
+    }
+    return i;
+}
+
+/**
+**	Compare two strings for qsort.
+**
+**	@param a	pointer to first string
+**	@param b	pointer to second string
+*/
+static int SchemaCompareKeys(const void *a, const void *b)
+{
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+/**
+**	Compare two fields by key for qsort.
+**
+**	@param a	first field
+**	@param b	second field
+*/
+static int SchemaCompareFields(const void *a, const void *b)
+{
+    return strcmp(((const SchemaField *)a)->Key,
+	((const SchemaField *)b)->Key);
+}
+
+/**
+**	Parse explicit type of field.
+**
+**	@param field	field to fill
+**	@param spec	schema array with "type" and "default" keys
+*/
+static void SchemaParseSpec(SchemaField * field, const ConfigObject * spec)
+{
+    const ConfigObject *index;
+    const ConfigObject *value;
+    const char *key;
+    const char *type;
+    ssize_t integer;
+    double number;
+    int i;
+
+    type = NULL;
+    field->Default = NULL;
+    index = NULL;
+    for (value = ConfigArrayFirst(spec, &index); value;
+	value = ConfigArrayNext(spec, &index)) {
+	if (!ConfigCheckString(index, &key)) {
+	    SchemaError(field->Path, "has a type with a non word key");
+	} else if (!strcmp(key, "type")) {
+	    if (!ConfigCheckString(value, &type)) {
+		SchemaError(field->Path, "type isn't a string");
+	    }
+	} else if (!strcmp(key, "default")) {
+	    field->Default = value;
+	} else {
+	    SchemaError(field->Path, "has a type with an unknown key");
+	}
+    }
+    if (!type) {
+	return;
+    }
+
+    for (i = SCHEMA_INTEGER; i <= SCHEMA_ARRAY; ++i) {
+	if (!strcmp(type, SchemaTypes[i].Name)) {
+	    break;
+	}
+    }
+    if (i > SCHEMA_ARRAY) {
+	SchemaError(field->Path, "has an unknown type");
+	return;
+    }
+    field->Type = i;
+    field->Required = !field->Default;
+    if (!field->Default) {
+	return;
+    }
+    // check default matches the type
+    switch (i) {
+	case SCHEMA_INTEGER:
+	case SCHEMA_UNSIGNED:
+	case SCHEMA_BOOLEAN:
+	    if (ConfigCheckInteger(field->Default, &integer)) {
+		return;
+	    }
+	    break;
+	case SCHEMA_DOUBLE:
+	    if (ConfigCheckDouble(field->Default, &number)) {
+		return;
+	    }
+	    break;
+	case SCHEMA_STRING:
+	    if (ConfigCheckString(field->Default, &key)) {
+		return;
+	    }
+	    break;
+	case SCHEMA_ARRAY:
+	    SchemaError(field->Path, "array can't have a default");
+	    return;
+    }
+    SchemaError(field->Path, "default doesn't match the type");
+}
+
+/**
+**	Check if schema array is a field with explicit type.
+**
+**	@param array	schema array
+**
+**	@returns true if array has a "type" key.
+*/
+static int SchemaIsSpec(const ConfigObject * array)
+{
+    const ConfigObject *index;
+    const ConfigObject *value;
+    const char *key;
+
+    index = NULL;
+    for (value = ConfigArrayFirst(array, &index); value;
+	value = ConfigArrayNext(array, &index)) {
+	if (ConfigCheckString(index, &key) && !strcmp(key, "type")) {
+	    return 1;
+	}
+    }
+    return 0;
+}
+
+/**
+**	Parse schema array into fields of struct.
+**
+**	The fields are sorted by key, to generate the same code for the
+**	same schema.
+**
+**	@param parent	struct field to fill
+**	@param array	schema array of struct
+*/
+static void SchemaParse(SchemaField * parent, const ConfigObject * array)
+{
+    const ConfigObject *index;
+    const ConfigObject *value;
+    const ConfigObject *sub;
+    const ConfigObject *first;
+    SchemaField *field;
+    const char *key;
+    const char *string;
+    ssize_t integer;
+    double number;
+    int i;
+
+    parent->N = 0;
+    parent->Fields = NULL;
+    index = NULL;
+    for (value = ConfigArrayFirst(array, &index); value;
+	value = ConfigArrayNext(array, &index)) {
+	if (!ConfigCheckString(index, &key)) {
+	    SchemaError(parent->Path, "has a non word key");
+	    continue;
+	}
+	parent->Fields = realloc(parent->Fields,
+	    (parent->N + 1) * sizeof(*parent->Fields));
+	field = parent->Fields + parent->N++;
+	memset(field, 0, sizeof(*field));
+	field->Key = key;
+	field->Name = SchemaName(key);
+	field->Path = malloc(strlen(parent->Path) + strlen(key) + 2);
+	sprintf(field->Path, "%s%s%s", parent->Path,
+	    *parent->Path ? "." : "", key);
+	field->Default = value;
+	SchemaAddKey(key);
+
+	if (ConfigCheckInteger(value, &integer)) {
+	    field->Type = SCHEMA_INTEGER;
+	} else if (ConfigCheckDouble(value, &number)) {
+	    field->Type = SCHEMA_DOUBLE;
+	} else if (ConfigCheckString(value, &string)) {
+	    field->Type = SCHEMA_STRING;
+	} else if (!ConfigCheckArray(value, &sub)) {
+	    SchemaError(field->Path, "has an unsupported value");
+	} else if (first = NULL, !ConfigArrayFirst(sub, &first)) {
+	    field->Type = SCHEMA_ARRAY;	// empty array
+	    field->Default = NULL;
+	} else if (SchemaIsSpec(sub)) {
+	    SchemaParseSpec(field, sub);
+	} else {
+	    field->Type = SCHEMA_STRUCT;
+	    field->Default = NULL;
+	    SchemaParse(field, sub);
+	}
+    }
+
+    qsort(parent->Fields, parent->N, sizeof(*parent->Fields),
+	SchemaCompareFields);
+    for (i = 1; i < parent->N; ++i) {
+	if (!strcmp(parent->Fields[i - 1].Name, parent->Fields[i].Name)) {
+	    SchemaError(parent->Fields[i].Path, "has the same C name");
+	}
+    }
+    if (parent->N) {
+	return;
+    }
+    SchemaError(parent->Path, "has no fields");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//	Code generator
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+**	Write tabs to align a comment.
+**
+**	@param out	output stream
+**	@param column	current column
+*/
+static void SchemaTab(FILE * out, int column)
+{
+    if (column >= 40) {
+	fputc(' ', out);
+	return;
+    }
+    while (column < 40) {
+	fputc('\t', out);
+	column = (column / 8 + 1) * 8;
+    }
+}
+
+/**
+**	Write indent of tabs and spaces.
+**
+**	@param out	output stream
+**	@param column	column to indent to
+**
+**	@returns column after indent.
+*/
+static int SchemaIndent(FILE * out, int column)
+{
+    int i;
+
+    for (i = 0; i < column / 8; ++i) {
+	fputc('\t', out);
+    }
+    fprintf(out, "%*s", column % 8, "");
+    return column;
+}
+
+/**
+**	Write C string literal.
+**
+**	@param out	output stream
+**	@param string	string to write
+*/
+static void SchemaString(FILE * out, const char *string)
+{
+    fputc('"', out);
+    for (; *string; ++string) {
+	if (*string == '"' || *string == '\\') {
+	    fprintf(out, "\\%c", *string);
+	} else if (*string == '\n') {
+	    fputs("\\n", out);
+	} else if (isprint((unsigned char)*string)) {
+	    fputc(*string, out);
+	} else {
+	    fprintf(out, "\\%03o", (unsigned char)*string);
+	}
+    }
+    fputc('"', out);
+}
+
+/**
+**	Write C double literal, shortest form which reads back the same.
+**
+**	Infinite defaults, like an overflowing 1e999, are written as
+**	HUGE_VAL, not a number as NAN, both of <math.h>.
+**
+**	@param out	output stream
+**	@param number	floating point number
+*/
+static void SchemaDouble(FILE * out, double number)
+{
+    char buf[64];
+    int i;
+
+    if (isinf(number)) {
+	fputs(number < 0 ? "-HUGE_VAL" : "HUGE_VAL", out);
+	return;
+    }
+    if (isnan(number)) {
+	fputs("NAN", out);
+	return;
+    }
+    for (i = 1; i < 17; ++i) {
+	snprintf(buf, sizeof(buf), "%.*g", i, number);
+	if (strtod(buf, NULL) == number) {
+	    break;
+	}
+    }
+    snprintf(buf, sizeof(buf), "%.*g", i, number);
+    if (!strpbrk(buf, ".eE")) {		// keep it a double constant
+	strcat(buf, ".");
+    }
+    fputs(buf, out);
+}
+
+/**
+**	Write members of struct.
+**
+**	@param out	output stream
+**	@param parent	struct field
+**	@param depth	nesting depth of struct
+*/
+static void SchemaWriteStruct(FILE * out, const SchemaField * parent,
+    int depth)
+{
+    const SchemaField *field;
+    const char *type;
+    int column;
+    int i;
+
+    for (i = 0; i < parent->N; ++i) {
+	field = parent->Fields + i;
+	column = SchemaIndent(out, depth * 4);
+	if (field->Type == SCHEMA_STRUCT) {
+	    fprintf(out, "struct\n");
+	    SchemaIndent(out, depth * 4);
+	    fprintf(out, "{\n");
+	    SchemaWriteStruct(out, field, depth + 1);
+	    column = SchemaIndent(out, depth * 4);
+	    column += fprintf(out, "} %s;", field->Name);
+	} else {
+	    type = SchemaTypes[field->Type].CType;
+	    column += fprintf(out, "%s%s%s;", type,
+		type[strlen(type) - 1] == '*' ? "" : " ", field->Name);
+	}
+	SchemaTab(out, column);
+	fprintf(out, "///< %s\n", field->Path);
+    }
+}
+
+/**
+**	Write default assignments of struct.
+**
+**	@param out	output stream
+**	@param parent	struct field
+**	@param member	C member path of struct
+*/
+static void SchemaWriteDefaults(FILE * out, const SchemaField * parent,
+    const char *member)
+{
+    const SchemaField *field;
+    const char *string;
+    ssize_t integer;
+    double number;
+    char *buf;
+    int i;
+
+    for (i = 0; i < parent->N; ++i) {
+	field = parent->Fields + i;
+	if (field->Type == SCHEMA_STRUCT) {
+	    buf = malloc(strlen(member) + strlen(field->Name) + 2);
+	    sprintf(buf, "%s%s.", member, field->Name);
+	    SchemaWriteDefaults(out, field, buf);
+	    free(buf);
+	    continue;
+	}
+	if (!field->Default) {
+	    continue;
+	}
+	fprintf(out, "    settings->%s%s = ", member, field->Name);
+	switch (field->Type) {
+	    case SCHEMA_INTEGER:
+		ConfigCheckInteger(field->Default, &integer);
+		fprintf(out, "%zd", integer);
+		break;
+	    case SCHEMA_UNSIGNED:
+		ConfigCheckInteger(field->Default, &integer);
+		fprintf(out, "%zuU", (size_t)integer);
+		break;
+	    case SCHEMA_BOOLEAN:
+		ConfigCheckInteger(field->Default, &integer);
+		fprintf(out, "%d", integer != 0);
+		break;
+	    case SCHEMA_DOUBLE:
+		ConfigCheckDouble(field->Default, &number);
+		SchemaDouble(out, number);
+		break;
+	    case SCHEMA_STRING:
+		ConfigCheckString(field->Default, &string);
+		SchemaString(out, string);
+		break;
+	}
+	fprintf(out, ";\n");
+    }
+}
+
+/**
+**	Write loader code of struct.
+**
+**	@param out	output stream
+**	@param parent	struct field
+**	@param member	C member path of struct
+**	@param depth	nesting depth of struct, array[depth] is the struct
+*/
+static void SchemaWriteLoad(FILE * out, const SchemaField * parent,
+    const char *member, int depth)
+{
+    const SchemaField *field;
+    const SchemaType *type;
+    char *buf;
+    int i;
+
+    for (i = 0; i < parent->N; ++i) {
+	field = parent->Fields + i;
+	fprintf(out, "\n    // %s\n", field->Path);
+	if (field->Type == SCHEMA_STRUCT) {
+	    // a present key of another type is reported, not skipped
+	    fprintf(out, "    value = ConfigArrayGet(array[%d], "
+		"keys[%d].Object);\n    array[%d] = NULL;\n"
+		"    if (value && !ConfigCheckArray(value, &array[%d])) {\n"
+		"\tfprintf(stderr,\n"
+		"\t    \"core-rc: config '%s' isn't %s\\n\");\n"
+		"\t++errors;\n    }\n", depth, SchemaKeyIndex(field->Key),
+		depth + 1, depth + 1, field->Path,
+		SchemaTypes[SCHEMA_ARRAY].What);
+	    buf = malloc(strlen(member) + strlen(field->Name) + 2);
+	    sprintf(buf, "%s%s.", member, field->Name);
+	    SchemaWriteLoad(out, field, buf, depth + 1);
+	    free(buf);
+	    continue;
+	}
+	type = SchemaTypes + field->Type;
+	fprintf(out, "    value = ConfigArrayGet(array[%d], keys[%d].Object);\n",
+	    depth, SchemaKeyIndex(field->Key));
+	if (field->Required) {
+	    fprintf(out, "    if (!value) {\n\tfprintf(stderr,\n"
+		"\t    \"core-rc: config '%s' missing\\n\");\n"
+		"\t++errors;\n    } else if (", field->Path);
+	} else {
+	    fprintf(out, "    if (value && ");
+	}
+	if (field->Type == SCHEMA_BOOLEAN) {
+	    fprintf(out, "!%s(value, &integer)) {\n", type->Check);
+	} else {
+	    fprintf(out, "!%s(value,\n\t    &settings->%s%s)) {\n",
+		type->Check, member, field->Name);
+	}
+	fprintf(out, "\tfprintf(stderr,\n"
+	    "\t    \"core-rc: config '%s' isn't %s\\n\");\n"
+	    "\t++errors;\n    }", field->Path, type->What);
+	if (field->Type == SCHEMA_BOOLEAN) {
+	    fprintf(out, " else%s {\n\tsettings->%s%s = integer != 0;\n    }",
+		field->Required ? "" : " if (value)", member, field->Name);
+	}
+	fputc('\n', out);
+    }
+}
+
+/**
+**	Get nesting depth of struct.
+**
+**	@param parent	struct field
+*/
+static int SchemaDepth(const SchemaField * parent)
+{
+    int depth;
+    int d;
+    int i;
+
+    depth = 0;
+    for (i = 0; i < parent->N; ++i) {
+	if (parent->Fields[i].Type == SCHEMA_STRUCT) {
+	    d = SchemaDepth(parent->Fields + i) + 1;
+	    if (d > depth) {
+		depth = d;
+	    }
+	}
+    }
+    return depth;
+}
+
+/**
+**	Check if struct has a boolean field.
+**
+**	@param parent	struct field
+*/
+static int SchemaHasBoolean(const SchemaField * parent)
+{
+    int i;
+
+    for (i = 0; i < parent->N; ++i) {
+	if (parent->Fields[i].Type == SCHEMA_BOOLEAN
+	    || (parent->Fields[i].Type == SCHEMA_STRUCT
+		&& SchemaHasBoolean(parent->Fields + i))) {
+	    return 1;
+	}
+    }
+    return 0;
+}
+
+/**
+**	Write generated header.
+**
+**	@param out	output stream
+**	@param name	base name of generated files
+**	@param prefix	prefix of generated C names
+**	@param root	schema root struct
+*/
+static void SchemaWriteHeader(FILE * out, const char *name,
+    const char *prefix, const SchemaField * root)
+{
+    const char *base;
+    const char *s;
+
+    base = (s = strrchr(name, '/')) ? s + 1 : name;
+    fprintf(out, "///\n///\t@file %s.h\t@brief settings of %s\n///\n"
+	"///\tGenerated by rc_schema from %s, don't edit.\n"
+	"//////////////////////////////////////////////////////////////////"
+	"////////////\n\n", base, SchemaFile, SchemaFile);
+
+    fprintf(out, "/**\n**\tSettings of %s.\n*/\ntypedef struct _", SchemaFile);
+    for (s = prefix; *s; ++s) {
+	if (s != prefix && isupper((unsigned char)*s)) {
+	    fputc('_', out);
+	}
+	fputc(tolower((unsigned char)*s), out);
+    }
+    fprintf(out, "_settings_\n{\n");
+    SchemaWriteStruct(out, root, 1);
+    fprintf(out, "} %sSettings;\n\n", prefix);
+
+    fprintf(out, "    /// Fill settings with their defaults.\n"
+	"extern void %sSettingsDefaults(%sSettings *);\n\n"
+	"    /// Load settings from config.\n"
+	"extern int %sSettingsLoad(const ConfigObject *, %sSettings *);\n",
+	prefix, prefix, prefix, prefix);
+}
+
+/**
+**	Write generated source.
+**
+**	@param out	output stream
+**	@param name	base name of generated files
+**	@param prefix	prefix of generated C names
+**	@param dir	directory of core-rc.h
+**	@param root	schema root struct
+*/
+static void SchemaWriteSource(FILE * out, const char *name,
+    const char *prefix, const char *dir, const SchemaField * root)
+{
+    const char *base;
+    const char *s;
+    int i;
+
+    base = (s = strrchr(name, '/')) ? s + 1 : name;
+    fprintf(out, "///\n///\t@file %s.c\t@brief settings of %s\n///\n"
+	"///\tGenerated by rc_schema from %s, don't edit.\n"
+	"//////////////////////////////////////////////////////////////////"
+	"////////////\n\n", base, SchemaFile, SchemaFile);
+    fprintf(out, "#include <stdio.h>\n#include <string.h>\n"
+	"#include <math.h>\n#include <sys/types.h>\n\n"
+	"#include \"core-array/core-array.h\"\n"
+	"#include \"%s%score-rc.h\"\n#include \"%s.h\"\n\n", dir,
+	*dir ? "/" : "", base);
+
+    fprintf(out, "/**\n**\tFill settings with their defaults.\n**\n"
+	"**\t@param[out] settings\tsettings to fill\n*/\n"
+	"void %sSettingsDefaults(%sSettings * settings)\n{\n"
+	"    memset(settings, 0, sizeof(*settings));\n", prefix, prefix);
+    SchemaWriteDefaults(out, root, "");
+    fprintf(out, "}\n\n");
+
+    fprintf(out, "/**\n**\tLoad settings from config.\n**\n"
+	"**\tThe keys are found once, each array of the config is searched\n"
+	"**\tonce for all its fields.  Missing values keep their defaults.\n"
+	"**\n**\t@param config\t\tconfig dictionary\n"
+	"**\t@param[out] settings\tsettings to fill\n**\n"
+	"**\t@returns number of missing required and mistyped values.\n*/\n"
+	"int %sSettingsLoad(const ConfigObject * config,\n"
+	"    %sSettings * settings)\n{\n    ConfigInternObject keys[] = {\n", prefix, prefix);
+    for (i = 0; i < SchemaKeyN; ++i) {
+	fprintf(out, "\t{");
+	SchemaString(out, SchemaKeys[i]);
+	fprintf(out, ", NULL},\n");
+    }
+    fprintf(out, "\t{NULL, NULL}\n    };\n"
+	"    const ConfigObject *array[%d];\n"
+	"    const ConfigObject *value;\n", SchemaDepth(root) + 1);
+    if (SchemaHasBoolean(root)) {
+	fprintf(out, "    ssize_t integer;\n");
+    }
+    fprintf(out, "    int errors;\n\n"
+	"    %sSettingsDefaults(settings);\n"
+	"    ConfigFindStrings(keys);\n"
+	"    errors = 0;\n    array[0] = config;\n", prefix);
+    SchemaWriteLoad(out, root, "", 0);
+    fprintf(out, "\n    return errors;\n}\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//	Main
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+**	Print version.
+*/
+static void PrintVersion(void)
+{
+    printf("rc_schema: core-rc schema compiler Version " VERSION
+#ifdef GIT_REV
+	"(GIT-" GIT_REV ")"
+#endif
+	",\n\t(c) 2026 by Lutz Sammer\n"
+	"\tLicense AGPLv3: GNU Affero General Public License version 3\n");
+}
+
+/**
+**	Print usage.
+*/
+static void PrintUsage(void)
+{
+    printf("Usage: rc_schema [-?hv] [-o name] [-p prefix] [-r dir] schema\n"
+	"\t-o name\twrite name.h and name.c, default schema name + _schema\n"
+	"\t-p prefix\tprefix of C names, default schema name\n"
+	"\t-r dir\tdirectory of core-rc.h, default core-rc\n"
+	"\t-? -h\tdisplay this message\n"
+	"\t-v\tdisplay version information\n"
+	"Only idiots print usage on stderr!\n");
+}
+
+/**
+**	Main entry point.
+**
+**	@param argc	number of arguments
+**	@param argv	arguments vector
+**
+**	@returns -1 on failures, 0 clean exit.
+*/
+int main(int argc, char *const argv[])
+{
+    const char *name;
+    const char *prefix;
+    const char *dir;
+    const char *s;
+    char *buf;
+    char *path;
+    Config *config;
+    SchemaField root;
+    FILE *out;
+    size_t n;
+
+    name = NULL;
+    prefix = NULL;
+    dir = "core-rc";
+
+    //
+    //	Parse command line arguments
+    //
+    for (;;) {
+	switch (getopt(argc, argv, "hv?-o:p:r:")) {
+	    case 'o':			// output name
+		name = optarg;
+		continue;
+	    case 'p':			// C prefix
+		prefix = optarg;
+		continue;
+	    case 'r':			// directory of core-rc.h
+		dir = optarg;
+		continue;
+
+	    case EOF:
+		break;
+	    case 'v':			// print version
+		PrintVersion();
+		return 0;
+	    case '?':
+	    case 'h':			// help usage
+		PrintVersion();
+		PrintUsage();
+		return 0;
+	    case '-':
+		PrintVersion();
+		PrintUsage();
+		fprintf(stderr, "\nWe need no long options\n");
+		return -1;
+	    case ':':
+		PrintVersion();
+		fprintf(stderr, "Missing argument for option '%c'\n", optopt);
+		return -1;
+	    default:
+		PrintVersion();
+		fprintf(stderr, "Unkown option '%c'\n", optopt);
+		return -1;
+	}
+	break;
+    }
+    if (optind + 1 != argc) {
+	PrintVersion();
+	PrintUsage();
+	fprintf(stderr, "\nOne schema file needed\n");
+	return -1;
+    }
+    SchemaFile = argv[optind];
+
+    // name.schema.core-rc -> name
+    s = (s = strrchr(SchemaFile, '/')) ? s + 1 : SchemaFile;
+    n = strcspn(s, ".");
+    if (!name) {
+	buf = malloc((s - SchemaFile) + n + sizeof("_schema"));
+	sprintf(buf, "%.*s_schema", (int)((s - SchemaFile) + n), SchemaFile);
+	name = buf;
+    }
+    if (!prefix) {
+	buf = malloc(n + 1);
+	sprintf(buf, "%.*s", (int)n, s);
+	path = SchemaName(buf);
+	free(buf);
+	prefix = path;
+    }
+
+    if (!(config = ConfigReadFile2(NULL, SchemaFile))) {
+	fprintf(stderr, "rc_schema: can't read schema '%s'\n", SchemaFile);
+	return -1;
+    }
+    memset(&root, 0, sizeof(root));
+    root.Path = "";
+    SchemaParse(&root, ConfigDict(config));
+    if (SchemaErrors) {
+	ConfigFreeMem(config);
+	return -1;
+    }
+    qsort(SchemaKeys, SchemaKeyN, sizeof(*SchemaKeys), SchemaCompareKeys);
+
+    path = malloc(strlen(name) + 3);
+    sprintf(path, "%s.h", name);
+    if (!(out = fopen(path, "w"))) {
+	fprintf(stderr, "rc_schema: can't create '%s'\n", path);
+	ConfigFreeMem(config);
+	return -1;
+    }
+    SchemaWriteHeader(out, name, prefix, &root);
+    fclose(out);
+
+    sprintf(path, "%s.c", name);
+    if (!(out = fopen(path, "w"))) {
+	fprintf(stderr, "rc_schema: can't create '%s'\n", path);
+	ConfigFreeMem(config);
+	return -1;
+    }
+    SchemaWriteSource(out, name, prefix, dir, &root);
+    fclose(out);
+
+    ConfigFreeMem(config);
+    return 0;
+}
+
+/// @}